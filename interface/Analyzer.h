@@ -9,10 +9,12 @@
 #ifndef BSM_ANALYZER
 #define BSM_ANALYZER
 
+#include <iosfwd>
 #include <string>
 
 #include "bsm_core/interface/Object.h"
 #include "bsm_input/interface/bsm_input_fwd.h"
+#include "interface/EventFields.h"
 
 namespace bsm
 {
@@ -21,6 +23,24 @@ namespace bsm
         public:
             virtual void onFileOpen(const std::string &, const Input *) = 0;
             virtual void process(const Event *) = 0;
+
+            // Reset results, keep configuration: thread pool reuses clones
+            // between jobs instead of cloning master again. False is
+            // returned if analyzer does not support reset (default)
+            //
+            virtual bool reset();
+
+            // Write results to the checkpoint and read them back to
+            // resume interrupted job. False is returned if analyzer does
+            // not support checkpoints (default)
+            //
+            virtual bool save(std::ostream &) const;
+            virtual bool load(std::istream &);
+
+            // Event fields analyzer uses. Other fields are skipped when
+            // records are parsed. All fields are used by default
+            //
+            virtual EventFields fields() const;
     };
 }
 
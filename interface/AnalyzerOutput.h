@@ -0,0 +1,63 @@
+// Analyzer Output
+//
+// Canvases and files of the analyzers results. Analysis programs and
+// bsm_analyze produce the same output for the same analyzer. Canvases are
+// kept by the output: it should live until ROOT application is run
+//
+//  shared_ptr<TRint> app(new TRint("app", &empty_argc, empty_argv));
+//
+//  AnalyzerOutput output;
+//  output.draw(*analyzer);
+//
+//  app->Run();
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_ANALYZER_OUTPUT
+#define BSM_ANALYZER_OUTPUT
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "interface/bsm_fwd.h"
+
+namespace bsm
+{
+    class MonitorAnalyzer;
+    class MttbarAnalyzer;
+    class WtagMassAnalyzer;
+
+    class AnalyzerOutput
+    {
+        public:
+            AnalyzerOutput();
+            ~AnalyzerOutput();
+
+            void draw(const MonitorAnalyzer &);
+
+            // mttbar histogram is saved into mttbar.root
+            //
+            void draw(const MttbarAnalyzer &);
+
+            void draw(const WtagMassAnalyzer &);
+
+        private:
+            // Prevent copying
+            //
+            AnalyzerOutput(const AnalyzerOutput &);
+            AnalyzerOutput &operator =(const AnalyzerOutput &);
+
+            // Canvases and histograms of any type are held until the
+            // output is destroyed
+            //
+            typedef std::vector<boost::shared_ptr<void> > Objects;
+
+            template<class T>
+                T *keep(T *);
+
+            Objects _objects;
+    };
+}
+
+#endif
@@ -0,0 +1,73 @@
+// Checkpoint
+//
+// List of processed inputs and merged analyzer results of the
+// interrupted job. Job is resumed by skipping processed inputs and adding
+// new results on top of the saved ones. Checkpoint is written with
+// PersistentFile: previous checkpoint is kept intact if job crashes while
+// checkpoint is being written.
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_CHECKPOINT
+#define BSM_CHECKPOINT
+
+#include <set>
+#include <string>
+
+#include "interface/PersistentFile.h"
+#include "interface/Thread.h"
+
+namespace bsm
+{
+    class Checkpoint
+    {
+        public:
+            Checkpoint(const std::string &filename);
+
+            std::string filename() const;
+
+            // Inputs chunks should match the checkpoint ones
+            //
+            uint32_t eventsPerChunk() const;
+            void setEventsPerChunk(const uint32_t &events);
+
+            void addInput(const InputChunk &);
+            bool isProcessed(const InputChunk &) const;
+
+            // Number of processed inputs
+            //
+            uint32_t size() const;
+
+            // Read processed inputs and analyzer results. False is
+            // returned if checkpoint is missing, broken or analyzer can
+            // not read results
+            //
+            bool load(Analyzer &);
+
+            // Write processed inputs and analyzer results. False is
+            // returned if analyzer does not support checkpoints
+            //
+            bool save(const Analyzer &) const;
+
+        private:
+            typedef std::pair<std::string, std::pair<uint64_t, uint64_t> >
+                Input;
+
+            typedef std::set<Input> Inputs;
+
+            typedef PersistentFile::CodedInputStream CodedInputStream;
+            typedef PersistentFile::CodedOutputStream CodedOutputStream;
+
+            Input key(const InputChunk &) const;
+
+            bool readBody(CodedInputStream &, Analyzer &);
+            void writeBody(CodedOutputStream &, const std::string &) const;
+
+            PersistentFile _file;
+
+            uint32_t _events_per_chunk;
+            Inputs _inputs;
+    };
+}
+
+#endif
@@ -0,0 +1,125 @@
+// Columnar File
+//
+// Cache of the Event fields in the columnar format (see EventColumns).
+// Events are stored in blocks; each block keeps every column as a raw
+// array that is read straight into memory without parsing messages.
+// Cache is built once from the bsm_input files and read many times by
+// the cut-based selections.
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_COLUMNAR_FILE
+#define BSM_COLUMNAR_FILE
+
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+
+#include "bsm_input/interface/bsm_input_fwd.h"
+#include "interface/EventColumns.h"
+
+namespace google
+{
+    namespace protobuf
+    {
+        namespace io
+        {
+            class FileInputStream;
+            class FileOutputStream;
+        }
+    }
+}
+
+namespace bsm
+{
+    class ColumnarWriter
+    {
+        public:
+            // Events are written in blocks of given size. Block is written
+            // early if its columns grow over 32 MB
+            //
+            ColumnarWriter(const std::string &filename,
+                    const uint32_t &block_size = 4096);
+            ~ColumnarWriter();
+
+            void open();
+
+            // Write the last block and close file. False is returned if
+            // any block failed to be written
+            //
+            bool close();
+
+            bool isOpen() const;
+
+            std::string filename() const;
+
+            // Add event to the current block. Block is written once it is
+            // full
+            //
+            bool write(const Event &);
+
+            // Write current block
+            //
+            bool flush();
+
+            uint64_t events() const;
+            uint32_t blocks() const;
+
+        private:
+            typedef google::protobuf::io::FileOutputStream FileOutputStream;
+            typedef boost::shared_ptr<FileOutputStream> FileOutputStreamPtr;
+
+            // Prevent copying
+            //
+            ColumnarWriter(const ColumnarWriter &);
+            ColumnarWriter &operator =(const ColumnarWriter &);
+
+            std::string _filename;
+            uint32_t _block_size;
+
+            int _fd;
+            FileOutputStreamPtr _raw_out;
+            bool _is_good;
+
+            EventColumns _columns;
+
+            uint64_t _events;
+            uint32_t _blocks;
+    };
+
+    class ColumnarReader
+    {
+        public:
+            ColumnarReader(const std::string &filename);
+            ~ColumnarReader();
+
+            void open();
+            void close();
+
+            bool isOpen() const;
+
+            std::string filename() const;
+
+            // Read next block of events. False is returned at the end of
+            // file or if block is corrupted: every column should have one
+            // value per event or object of its collection
+            //
+            bool read(EventColumns &);
+
+        private:
+            typedef google::protobuf::io::FileInputStream FileInputStream;
+            typedef boost::shared_ptr<FileInputStream> FileInputStreamPtr;
+
+            // Prevent copying
+            //
+            ColumnarReader(const ColumnarReader &);
+            ColumnarReader &operator =(const ColumnarReader &);
+
+            std::string _filename;
+
+            int _fd;
+            FileInputStreamPtr _raw_in;
+    };
+}
+
+#endif
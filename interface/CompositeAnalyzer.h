@@ -0,0 +1,72 @@
+// Composite Analyzer
+//
+// Group of analyzers run in one pass over the input: each event is read
+// and parsed once and passed to all analyzers in the group
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_COMPOSITE_ANALYZER
+#define BSM_COMPOSITE_ANALYZER
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "interface/Analyzer.h"
+
+namespace bsm
+{
+    class CompositeAnalyzer : public Analyzer
+    {
+        public:
+            typedef boost::shared_ptr<Analyzer> AnalyzerPtr;
+            typedef std::vector<AnalyzerPtr> Analyzers;
+
+            CompositeAnalyzer();
+            CompositeAnalyzer(const CompositeAnalyzer &);
+
+            // Add analyzer to the group. Analyzers are called in the order
+            // they are added
+            //
+            void add(const AnalyzerPtr &);
+
+            const Analyzers &analyzers() const;
+
+            // Analyzer interface
+            //
+            virtual void onFileOpen(const std::string &filename, const Input *);
+            virtual void process(const Event *);
+
+            // Group is reset only if all analyzers support reset
+            //
+            virtual bool reset();
+
+            // Checkpoints are supported only if all analyzers support them.
+            // Analyzers results are written one after another
+            //
+            virtual bool save(std::ostream &) const;
+            virtual bool load(std::istream &);
+
+            // Fields used by any analyzer in the group
+            //
+            virtual EventFields fields() const;
+
+            // Object interface
+            //
+            virtual uint32_t id() const;
+
+            virtual ObjectPtr clone() const;
+            using Object::merge;
+
+            virtual void print(std::ostream &) const;
+
+        private:
+            // Prevent copying
+            //
+            CompositeAnalyzer &operator =(const CompositeAnalyzer &);
+
+            Analyzers _analyzers;
+    };
+}
+
+#endif
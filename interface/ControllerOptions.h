@@ -0,0 +1,38 @@
+// Controller Options
+//
+// Command line options of the ThreadController shared by all drivers:
+// threads, processes, chunks, pipeline, scheduling, readahead,
+// checkpoints, stats, etc.
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_CONTROLLER_OPTIONS
+#define BSM_CONTROLLER_OPTIONS
+
+#include <boost/program_options.hpp>
+
+namespace bsm
+{
+    class ThreadController;
+
+    class ControllerOptions
+    {
+        public:
+            ControllerOptions();
+
+            // Options to be added to the driver ones
+            //
+            const boost::program_options::options_description &
+                description() const;
+
+            // Configure controller with the parsed options
+            //
+            void apply(const boost::program_options::variables_map &,
+                    ThreadController &) const;
+
+        private:
+            boost::program_options::options_description _description;
+    };
+}
+
+#endif
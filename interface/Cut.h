@@ -7,6 +7,7 @@
 #define BSM_CUT
 
 #include <iomanip>
+#include <iosfwd>
 #include <string>
 
 #include <boost/shared_ptr.hpp>
@@ -47,6 +48,12 @@ namespace bsm
             //
             void add();
 
+            // Checkpoint: count is written and read back. Lock state is
+            // not saved
+            //
+            bool save(std::ostream &) const;
+            bool load(std::istream &);
+
             // Object interface
             //
             virtual uint32_t id() const;
@@ -99,6 +106,12 @@ namespace bsm
             void disable();
             void enable();
 
+            // Checkpoint: counters are read back only if the cut has the
+            // same value
+            //
+            bool save(std::ostream &) const;
+            bool load(std::istream &);
+
             // Object interface
             //
             virtual uint32_t id() const;
@@ -0,0 +1,517 @@
+// Cut Chain
+//
+// Cuts of the selector fixed at compile time. Chain is given by the list
+// of comparators, the same functors Comparator uses:
+//
+//  typedef CutList<std::greater<float>,
+//          CutList<std::less<float> > > Cuts;
+//
+//  CutChain<Cuts> chain;
+//  chain.cut<0>().setValue(30);
+//  chain.cut<1>().setValue(2.1);
+//
+//  if (chain.apply<0>(pt)
+//          && chain.apply<1>(fabs(eta)))
+//  {
+//      // pT > 30 and |eta| < 2.1
+//  }
+//
+// Cuts are applied by their index: comparison is inlined and there is
+// neither virtual call nor shared pointer on the way. Counters of all
+// cuts are kept in one block. Chain counts, prints and merges the same
+// way the Comparator cuts do.
+//
+// Whole collection is selected with SelectionBatch: cut is applied to the
+// column of values and compared with SIMD instructions for the common
+// comparators (see BatchCompare).
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_CUT_CHAIN
+#define BSM_CUT_CHAIN
+
+#include <iomanip>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "interface/SelectionBatch.h"
+#include "interface/Utility.h"
+
+namespace bsm
+{
+    // Objects and events passed the cut. Event is counted once while
+    // counters are locked on update (see LockCounterOnUpdate)
+    //
+    struct CutCount
+    {
+        CutCount();
+
+        uint32_t objects;
+        uint32_t events;
+
+        bool is_event_locked;
+    };
+
+    // Reject objects in the mask that fail the comparison. Mask is all bits
+    // set for the passed object. Values and mask are aligned and padded to
+    // the SelectionBatch::WIDTH. SSE versions are used for the float
+    // comparators and logical and
+    //
+    template<class Compare>
+        struct BatchCompare
+        {
+            static void apply(const float *values,
+                    const float &value,
+                    uint32_t *mask,
+                    const uint32_t &size);
+        };
+
+    template<>
+        void BatchCompare<std::greater<float> >::apply(const float *,
+                const float &, uint32_t *, const uint32_t &);
+
+    template<>
+        void BatchCompare<std::greater_equal<float> >::apply(const float *,
+                const float &, uint32_t *, const uint32_t &);
+
+    template<>
+        void BatchCompare<std::less<float> >::apply(const float *,
+                const float &, uint32_t *, const uint32_t &);
+
+    template<>
+        void BatchCompare<std::less_equal<float> >::apply(const float *,
+                const float &, uint32_t *, const uint32_t &);
+
+    template<>
+        void BatchCompare<std::logical_and<bool> >::apply(const float *,
+                const float &, uint32_t *, const uint32_t &);
+
+    // Cut settings: value, name and state
+    //
+    class ChainCut
+    {
+        public:
+            ChainCut(const float &value = 0, const std::string &name = "");
+
+            float value() const;
+            void setValue(const float &);
+
+            std::string name() const;
+            void setName(const std::string &);
+
+            bool isDisabled() const;
+
+            void disable();
+            void enable();
+
+            // Cuts are merged only if they have the same value and name
+            //
+            bool isMergeable(const ChainCut &) const;
+
+            // Value and counters are printed the same way as for Cut
+            //
+            void print(std::ostream &, const CutCount &) const;
+
+        private:
+            float _value;
+            std::string _name;
+            bool _is_disabled;
+    };
+
+    template<class Compare>
+        class ChainComparator : public ChainCut
+        {
+            public:
+                ChainComparator(const float &value = 0,
+                        const std::string &name = "");
+
+                bool isPass(const float &number) const;
+
+                // Reject objects in the mask that fail the cut
+                //
+                void apply(const float *values,
+                        uint32_t *mask,
+                        const uint32_t &size) const;
+
+                void print(std::ostream &, const CutCount &) const;
+
+            private:
+                Compare _functor;
+        };
+
+    // Compile time list of cuts
+    //
+    class CutListEnd
+    {
+        public:
+            enum { size = 0 };
+
+            void enable();
+            void disable();
+
+            void merge(const CutListEnd &, CutCount *, const CutCount *);
+            void print(std::ostream &, const CutCount *) const;
+    };
+
+    template<class Compare, class Next = CutListEnd>
+        class CutList
+        {
+            public:
+                typedef ChainComparator<Compare> Head;
+                typedef Next Tail;
+
+                enum { size = Tail::size + 1 };
+
+                Head &head();
+                const Head &head() const;
+
+                Tail &tail();
+                const Tail &tail() const;
+
+                void enable();
+                void disable();
+
+                // Counters are given in the list order
+                //
+                void merge(const CutList &, CutCount *, const CutCount *);
+                void print(std::ostream &, const CutCount *) const;
+
+            private:
+                Head _head;
+                Tail _tail;
+        };
+
+    // Cut of the list by index
+    //
+    template<uint32_t I, class List>
+        struct CutListAt
+        {
+            typedef typename CutListAt<I - 1, typename List::Tail>::Cut Cut;
+
+            static Cut &get(List &list)
+            {
+                return CutListAt<I - 1, typename List::Tail>::get(list.tail());
+            }
+
+            static const Cut &get(const List &list)
+            {
+                return CutListAt<I - 1, typename List::Tail>::get(list.tail());
+            }
+        };
+
+    template<class List>
+        struct CutListAt<0, List>
+        {
+            typedef typename List::Head Cut;
+
+            static Cut &get(List &list)
+            {
+                return list.head();
+            }
+
+            static const Cut &get(const List &list)
+            {
+                return list.head();
+            }
+        };
+
+    // Counters of the chain cuts in one block
+    //
+    class CutChainCounters
+    {
+        public:
+            CutChainCounters(const uint32_t &cuts);
+
+            uint32_t objects(const uint32_t &cut) const;
+            uint32_t events(const uint32_t &cut) const;
+
+            // Count every event once until counters are unlocked
+            //
+            void lockEventsOnUpdate();
+            void unlockEvents();
+
+            // Checkpoint: counters are read back only if chain has the
+            // same number of cuts
+            //
+            bool save(std::ostream &) const;
+            bool load(std::istream &);
+
+        protected:
+            void count(const uint32_t &cut);
+
+            // Several objects of the same event passed the cut
+            //
+            void count(const uint32_t &cut, const uint32_t &objects);
+
+            std::vector<CutCount> _counts;
+
+        private:
+            bool _is_lock_on_update;
+    };
+
+    template<class List>
+        class CutChain : public CutChainCounters
+        {
+            public:
+                CutChain();
+
+                template<uint32_t I>
+                    typename CutListAt<I, List>::Cut &cut();
+
+                template<uint32_t I>
+                    const typename CutListAt<I, List>::Cut &cut() const;
+
+                // Apply cut: implicitly count number of success
+                //
+                template<uint32_t I>
+                    bool apply(const float &);
+
+                // Apply cut to the column of the batch: objects passed
+                // are counted the same way as with one object at a time
+                //
+                template<uint32_t I>
+                    void apply(SelectionBatch &, const uint32_t &column);
+
+                void enable();
+                void disable();
+
+                void merge(const CutChain &);
+
+                void print(std::ostream &) const;
+
+            private:
+                List _list;
+        };
+}
+
+// Template(s) implementation
+//
+inline void bsm::CutChainCounters::count(const uint32_t &cut)
+{
+    CutCount &count = _counts[cut];
+
+    ++count.objects;
+
+    if (count.is_event_locked)
+        return;
+
+    ++count.events;
+    count.is_event_locked = _is_lock_on_update;
+}
+
+inline void bsm::CutChainCounters::count(const uint32_t &cut,
+        const uint32_t &objects)
+{
+    if (!objects)
+        return;
+
+    CutCount &count = _counts[cut];
+
+    count.objects += objects;
+
+    if (count.is_event_locked)
+        return;
+
+    // Every object is an event unless counters are locked
+    //
+    count.events += _is_lock_on_update ? 1 : objects;
+    count.is_event_locked = _is_lock_on_update;
+}
+
+template<class Compare>
+    void bsm::BatchCompare<Compare>::apply(const float *values,
+            const float &value,
+            uint32_t *mask,
+            const uint32_t &size)
+{
+    Compare functor;
+    for(uint32_t object = 0; size > object; ++object)
+    {
+        if (!functor(values[object], value))
+            mask[object] = 0;
+    }
+}
+
+template<class Compare>
+    bsm::ChainComparator<Compare>::ChainComparator(const float &value,
+            const std::string &name):
+        ChainCut(value, name)
+{
+}
+
+template<class Compare>
+    inline bool bsm::ChainComparator<Compare>::isPass(const float &number) const
+{
+    return _functor(number, value());
+}
+
+template<class Compare>
+    inline void bsm::ChainComparator<Compare>::apply(const float *values,
+            uint32_t *mask,
+            const uint32_t &size) const
+{
+    BatchCompare<Compare>::apply(values, value(), mask, size);
+}
+
+template<class Compare>
+    void bsm::ChainComparator<Compare>::print(std::ostream &out,
+            const CutCount &count) const
+{
+    out << " [+] " << std::setw(20) << std::right << name() << " " << _functor << " ";
+
+    ChainCut::print(out, count);
+}
+
+template<class Compare, class Next>
+    typename bsm::CutList<Compare, Next>::Head &bsm::CutList<Compare, Next>::head()
+{
+    return _head;
+}
+
+template<class Compare, class Next>
+    const typename bsm::CutList<Compare, Next>::Head &
+        bsm::CutList<Compare, Next>::head() const
+{
+    return _head;
+}
+
+template<class Compare, class Next>
+    typename bsm::CutList<Compare, Next>::Tail &bsm::CutList<Compare, Next>::tail()
+{
+    return _tail;
+}
+
+template<class Compare, class Next>
+    const typename bsm::CutList<Compare, Next>::Tail &
+        bsm::CutList<Compare, Next>::tail() const
+{
+    return _tail;
+}
+
+template<class Compare, class Next>
+    void bsm::CutList<Compare, Next>::enable()
+{
+    _head.enable();
+    _tail.enable();
+}
+
+template<class Compare, class Next>
+    void bsm::CutList<Compare, Next>::disable()
+{
+    _head.disable();
+    _tail.disable();
+}
+
+template<class Compare, class Next>
+    void bsm::CutList<Compare, Next>::merge(const CutList &list,
+            CutCount *counts,
+            const CutCount *list_counts)
+{
+    if (_head.isMergeable(list._head))
+    {
+        if (list._head.isDisabled())
+            _head.disable();
+        else
+            _head.enable();
+
+        counts->objects += list_counts->objects;
+        counts->events += list_counts->events;
+    }
+
+    _tail.merge(list._tail, counts + 1, list_counts + 1);
+}
+
+template<class Compare, class Next>
+    void bsm::CutList<Compare, Next>::print(std::ostream &out,
+            const CutCount *counts) const
+{
+    _head.print(out, *counts);
+
+    if (0 == Tail::size)
+        return;
+
+    out << std::endl;
+
+    _tail.print(out, counts + 1);
+}
+
+template<class List>
+    bsm::CutChain<List>::CutChain():
+        CutChainCounters(List::size)
+{
+}
+
+template<class List>
+    template<uint32_t I>
+        typename bsm::CutListAt<I, List>::Cut &bsm::CutChain<List>::cut()
+{
+    return CutListAt<I, List>::get(_list);
+}
+
+template<class List>
+    template<uint32_t I>
+        const typename bsm::CutListAt<I, List>::Cut &
+            bsm::CutChain<List>::cut() const
+{
+    return CutListAt<I, List>::get(_list);
+}
+
+template<class List>
+    template<uint32_t I>
+        inline bool bsm::CutChain<List>::apply(const float &number)
+{
+    const typename CutListAt<I, List>::Cut &cut = CutListAt<I, List>::get(_list);
+
+    if (cut.isDisabled())
+        return true;
+
+    if (!cut.isPass(number))
+        return false;
+
+    count(I);
+
+    return true;
+}
+
+template<class List>
+    template<uint32_t I>
+        void bsm::CutChain<List>::apply(SelectionBatch &batch,
+                const uint32_t &column)
+{
+    const typename CutListAt<I, List>::Cut &cut = CutListAt<I, List>::get(_list);
+
+    if (cut.isDisabled())
+        return;
+
+    cut.apply(batch.column(column), batch.mask(), batch.paddedSize());
+
+    count(I, batch.passed());
+}
+
+template<class List>
+    void bsm::CutChain<List>::enable()
+{
+    _list.enable();
+}
+
+template<class List>
+    void bsm::CutChain<List>::disable()
+{
+    _list.disable();
+}
+
+template<class List>
+    void bsm::CutChain<List>::merge(const CutChain &chain)
+{
+    _list.merge(chain._list, &_counts[0], &chain._counts[0]);
+}
+
+template<class List>
+    void bsm::CutChain<List>::print(std::ostream &out) const
+{
+    _list.print(out, &_counts[0]);
+}
+
+#endif
@@ -0,0 +1,101 @@
+// Dataset Manifest
+//
+// Size, number of events and run range of every input file of the
+// dataset. Manifest is built from the file list with a parallel scan of
+// the files: only Event extra is decoded. Update is incremental: entries
+// of the files with the same size and modification time are kept, new and
+// changed files are scanned, files that left the list are dropped.
+//
+// ThreadController uses manifest to report job progress and ETA in events
+// and to estimate cost of the inputs that were never processed.
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_DATASET_MANIFEST
+#define BSM_DATASET_MANIFEST
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "interface/PersistentFile.h"
+
+namespace bsm
+{
+    class DatasetManifest
+    {
+        public:
+            typedef std::vector<std::string> Files;
+
+            struct Entry
+            {
+                Entry();
+
+                uint64_t size;
+                int64_t mtime;
+
+                uint32_t events;
+
+                // Run range: zero if file has no events
+                //
+                uint32_t first_run;
+                uint32_t last_run;
+            };
+
+            DatasetManifest(const std::string &filename);
+
+            std::string filename() const;
+
+            bool load();
+            bool save() const;
+
+            // Scan new and changed files of the list in N threads and drop
+            // files that are not in the list. Number of scanned files is
+            // returned. Files that can not be read are left out
+            //
+            uint32_t update(const Files &, const uint32_t &threads);
+
+            // Find entry of the file. False is returned if file is not in
+            // the manifest or it has changed since it was scanned
+            //
+            bool find(const std::string &file_name, Entry &) const;
+
+            // Number of files, total events and bytes
+            //
+            uint32_t size() const;
+            uint64_t events() const;
+            uint64_t bytes() const;
+
+            // Run range of the whole dataset
+            //
+            uint32_t firstRun() const;
+            uint32_t lastRun() const;
+
+            // Read file list: one input per line. Empty lines and lines
+            // starting with # are skipped
+            //
+            static bool readList(const std::string &list, Files &);
+
+            // Count events and find run range of the file. False is
+            // returned if file can not be read to the end
+            //
+            static bool scan(const std::string &file_name, Entry &);
+
+        private:
+            typedef std::map<std::string, Entry> Entries;
+
+            typedef PersistentFile::CodedInputStream CodedInputStream;
+            typedef PersistentFile::CodedOutputStream CodedOutputStream;
+
+            static bool stat(const std::string &file_name, Entry &);
+
+            bool readBody(CodedInputStream &);
+            void writeBody(CodedOutputStream &) const;
+
+            PersistentFile _file;
+
+            Entries _entries;
+    };
+}
+
+#endif
@@ -31,6 +31,10 @@ namespace bsm
             virtual void onFileOpen(const std::string &filename, const Input *);
             virtual void process(const Event *);
 
+            // Only generator particles are used
+            //
+            virtual EventFields fields() const;
+
             const H2Ptr decay_level_1() const;
             const H2Ptr decay_level_2() const;
 
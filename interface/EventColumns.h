@@ -0,0 +1,288 @@
+// Event Columns
+//
+// Structure-of-arrays copy of the commonly used Event fields for a block
+// of events: run/lumi/event, primary vertices, jets, electrons, muons and
+// triggers. Each collection keeps flat arrays of the object properties
+// and offsets: objects of the Nth event in the block are
+//
+//      [offsets[N], offsets[N + 1])
+//
+// Views give selectors access to the objects of one event without
+// parsing the Event message.
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_EVENT_COLUMNS
+#define BSM_EVENT_COLUMNS
+
+#include <vector>
+
+#include "bsm_input/interface/bsm_input_fwd.h"
+
+namespace bsm
+{
+    struct EventColumns
+    {
+        typedef std::vector<uint32_t> Offsets;
+        typedef std::vector<uint32_t> Integers;
+        typedef std::vector<uint64_t> Hashes;
+        typedef std::vector<uint8_t> Flags;
+        typedef std::vector<float> Floats;
+
+        struct P4s
+        {
+            void add(const LorentzVector &);
+            void clear();
+
+            Floats e;
+            Floats px;
+            Floats py;
+            Floats pz;
+        };
+
+        struct PrimaryVertices
+        {
+            Offsets offsets;
+
+            Floats z;
+            Flags has_extra;
+            Floats ndof;
+            Floats rho;
+        };
+
+        struct Jets
+        {
+            Offsets offsets;
+
+            P4s p4;
+        };
+
+        struct Electrons
+        {
+            Offsets offsets;
+
+            P4s p4;
+            Floats vertex_z;
+        };
+
+        struct Muons
+        {
+            Offsets offsets;
+
+            P4s p4;
+            Floats vertex_z;
+
+            Flags has_extra;
+            Flags is_global;
+            Flags is_tracker;
+            Integers number_of_matches;
+            Integers pixel_hits;
+            Floats d0_bsp;
+
+            Integers global_track_hits;
+            Floats global_track_normalized_chi2;
+            Integers inner_track_hits;
+        };
+
+        struct Triggers
+        {
+            Offsets offsets;
+
+            Hashes hash;
+            Flags pass;
+        };
+
+        EventColumns();
+
+        // Append event to the block
+        //
+        void add(const Event &);
+
+        // Remove all events
+        //
+        void clear();
+
+        // Number of events in the block
+        //
+        uint32_t size() const;
+
+        // Visit every column in the fixed order: used to read and write
+        // columns. Visitor is called with each std::vector
+        //
+        template<class Visitor>
+            void visit(Visitor &);
+
+        Integers run;
+        Integers lumi;
+        Integers event;
+
+        PrimaryVertices primary_vertices;
+        Jets jets;
+        Electrons pf_electrons;
+        Muons pf_muons;
+        Triggers hlts;
+    };
+
+    // Lorentz vector of the object in the columns
+    //
+    class P4View
+    {
+        public:
+            P4View(const EventColumns::P4s &, const uint32_t &object);
+
+            // Kinematics are calculated with bsm_input algebra: results
+            // are the same as for the Event objects
+            //
+            LorentzVector p4() const;
+
+            float pt() const;
+            float et() const;
+            float eta() const;
+            float mass() const;
+
+        protected:
+            const EventColumns::P4s *_p4s;
+            uint32_t _object;
+    };
+
+    class PrimaryVertexView
+    {
+        public:
+            PrimaryVertexView(const EventColumns &, const uint32_t &object);
+
+            float z() const;
+
+            bool hasExtra() const;
+            float ndof() const;
+            float rho() const;
+
+        private:
+            const EventColumns::PrimaryVertices *_vertices;
+            uint32_t _object;
+    };
+
+    class JetView : public P4View
+    {
+        public:
+            JetView(const EventColumns &, const uint32_t &object);
+    };
+
+    class ElectronView : public P4View
+    {
+        public:
+            ElectronView(const EventColumns &, const uint32_t &object);
+
+            float vertexZ() const;
+
+        private:
+            const EventColumns::Electrons *_electrons;
+    };
+
+    class MuonView : public P4View
+    {
+        public:
+            MuonView(const EventColumns &, const uint32_t &object);
+
+            float vertexZ() const;
+
+            bool hasExtra() const;
+            bool isGlobal() const;
+            bool isTracker() const;
+            uint32_t numberOfMatches() const;
+            uint32_t pixelHits() const;
+            float d0Bsp() const;
+
+            uint32_t globalTrackHits() const;
+            float globalTrackNormalizedChi2() const;
+            uint32_t innerTrackHits() const;
+
+        private:
+            const EventColumns::Muons *_muons;
+    };
+
+    // Event in the block of columns
+    //
+    class EventView
+    {
+        public:
+            EventView(const EventColumns &, const uint32_t &event);
+
+            uint32_t run() const;
+            uint32_t lumi() const;
+            uint32_t event() const;
+
+            uint32_t primaryVertices() const;
+            PrimaryVertexView primaryVertex(const uint32_t &) const;
+
+            uint32_t jets() const;
+            JetView jet(const uint32_t &) const;
+
+            uint32_t electrons() const;
+            ElectronView electron(const uint32_t &) const;
+
+            uint32_t muons() const;
+            MuonView muon(const uint32_t &) const;
+
+            uint32_t hlts() const;
+            uint64_t hltHash(const uint32_t &) const;
+            bool hltPass(const uint32_t &) const;
+
+        private:
+            uint32_t count(const EventColumns::Offsets &) const;
+            uint32_t first(const EventColumns::Offsets &) const;
+
+            const EventColumns *_columns;
+            uint32_t _event;
+    };
+}
+
+// Template(s) implementation
+//
+template<class Visitor>
+    void bsm::EventColumns::visit(Visitor &visitor)
+{
+    visitor(run);
+    visitor(lumi);
+    visitor(event);
+
+    visitor(primary_vertices.offsets);
+    visitor(primary_vertices.z);
+    visitor(primary_vertices.has_extra);
+    visitor(primary_vertices.ndof);
+    visitor(primary_vertices.rho);
+
+    visitor(jets.offsets);
+    visitor(jets.p4.e);
+    visitor(jets.p4.px);
+    visitor(jets.p4.py);
+    visitor(jets.p4.pz);
+
+    visitor(pf_electrons.offsets);
+    visitor(pf_electrons.p4.e);
+    visitor(pf_electrons.p4.px);
+    visitor(pf_electrons.p4.py);
+    visitor(pf_electrons.p4.pz);
+    visitor(pf_electrons.vertex_z);
+
+    visitor(pf_muons.offsets);
+    visitor(pf_muons.p4.e);
+    visitor(pf_muons.p4.px);
+    visitor(pf_muons.p4.py);
+    visitor(pf_muons.p4.pz);
+    visitor(pf_muons.vertex_z);
+    visitor(pf_muons.has_extra);
+    visitor(pf_muons.is_global);
+    visitor(pf_muons.is_tracker);
+    visitor(pf_muons.number_of_matches);
+    visitor(pf_muons.pixel_hits);
+    visitor(pf_muons.d0_bsp);
+    visitor(pf_muons.global_track_hits);
+    visitor(pf_muons.global_track_normalized_chi2);
+    visitor(pf_muons.inner_track_hits);
+
+    visitor(hlts.offsets);
+    visitor(hlts.hash);
+    visitor(hlts.pass);
+}
+
+#endif
@@ -0,0 +1,84 @@
+// Event Fields
+//
+// Set of the Event fields used by analyzer, given by their field numbers
+// (e.g. Event::kHltsFieldNumber). Records are parsed with the set: fields
+// that are not used are skipped at the wire level and their sub-messages
+// are never built. Parsing cost follows the fields analysis uses instead
+// of the event size.
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_EVENT_FIELDS
+#define BSM_EVENT_FIELDS
+
+#include <string>
+
+#include "bsm_input/interface/bsm_input_fwd.h"
+
+namespace google
+{
+    namespace protobuf
+    {
+        namespace io
+        {
+            class CodedInputStream;
+        }
+    }
+}
+
+namespace bsm
+{
+    class EventFields
+    {
+        public:
+            // All fields are used by default
+            //
+            EventFields();
+
+            // Use only given fields from now on. Fields are added one by
+            // one
+            //
+            static EventFields none();
+
+            // Add field number to the set
+            //
+            void add(const uint32_t &field);
+
+            // Union of two sets: used to combine analyzers
+            //
+            void add(const EventFields &);
+
+            bool isAll() const;
+            bool has(const uint32_t &field) const;
+
+            bool operator ==(const EventFields &) const;
+            bool operator !=(const EventFields &) const;
+
+            // Parse record keeping only fields in the set. Buffer holds
+            // the fields to be parsed and is reused between records
+            //
+            bool parse(const uint8_t *record,
+                    const uint32_t &size,
+                    Event &,
+                    std::string &buffer) const;
+
+            // Parse record of given size straight from the stream: used
+            // fields are copied into the buffer once and the rest are
+            // skipped in the stream
+            //
+            bool parse(google::protobuf::io::CodedInputStream &,
+                    const uint32_t &size,
+                    Event &,
+                    std::string &buffer) const;
+
+        private:
+            // Fields with numbers above the mask size are always parsed
+            //
+            static const uint32_t MAX_FIELD = 63;
+
+            bool _is_all;
+            uint64_t _mask;
+    };
+}
+
+#endif
@@ -0,0 +1,77 @@
+// Event Index
+//
+// Map of the run, lumi and event numbers to byte offsets of the Event
+// records in the bsm_input file. Index is built with a single pass over
+// the file: only Event extra is decoded, the rest of the record is
+// skipped. Built index is cached in the sidecar file next to the input
+// (see Sidecar):
+//
+//      input.pb -> input.pb.evt
+//
+// Index gives random access to the events: selecting N events costs N
+// decodes instead of a pass over the file.
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_EVENT_INDEX
+#define BSM_EVENT_INDEX
+
+#include <string>
+#include <vector>
+
+#include "interface/Sidecar.h"
+
+namespace bsm
+{
+    class EventIndex : public Sidecar
+    {
+        public:
+            typedef std::vector<uint64_t> Offsets;
+
+            EventIndex(const std::string &filename);
+
+            // Scan input file for events
+            //
+            virtual bool scan();
+
+            // Number of indexed events
+            //
+            uint32_t size() const;
+
+            // Find offsets of the event records. Zero lumi or run matches
+            // any value. Offsets are appended in the file order
+            //
+            void find(const uint32_t &id,
+                    const uint32_t &lumi,
+                    const uint32_t &run,
+                    Offsets &) const;
+
+        protected:
+            virtual void clearBody();
+            virtual bool readBody(CodedInputStream &);
+            virtual void writeBody(CodedOutputStream &) const;
+
+        private:
+            struct Entry
+            {
+                uint32_t run;
+                uint32_t lumi;
+                uint32_t id;
+                uint64_t offset;
+
+                // Entries are ordered by event number for the look up
+                //
+                bool operator <(const Entry &) const;
+            };
+
+            typedef std::vector<Entry> Entries;
+
+            // Decode Event extra from the record. Other fields are skipped
+            //
+            bool decode(const std::string &record, Entry &) const;
+
+            Entries _entries;
+    };
+}
+
+#endif
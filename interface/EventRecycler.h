@@ -0,0 +1,75 @@
+// Event Recycler
+//
+// Event reused by the thread to decode input records. Parser keeps
+// sub-messages and strings of the cleared Event and fills them with the
+// next record: steady state decoding does not allocate. Memory held by
+// the Event only grows with the largest event seen: it may be released
+// every N events at the cost of new allocations.
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_EVENT_RECYCLER
+#define BSM_EVENT_RECYCLER
+
+#include <boost/shared_ptr.hpp>
+
+#include "bsm_input/interface/bsm_input_fwd.h"
+
+namespace bsm
+{
+    class EventRecycler
+    {
+        public:
+            typedef boost::shared_ptr<Event> EventPtr;
+
+            // Event memory is released every N decoded events. It is
+            // never released with zero (default)
+            //
+            EventRecycler(const uint32_t &reset_events = 0);
+
+            void setResetEvents(const uint32_t &events);
+
+            // Event to decode the next record into. Event is allocated if
+            // there is none
+            //
+            EventPtr &event();
+
+            // Event was processed: clear it for the next record and
+            // release its memory if N events were decoded since the last
+            // reset
+            //
+            void recycle();
+
+            // Release the Event and memory held by it
+            //
+            void reset();
+
+            // Counters are only touched by the owner thread
+            //
+            void resetCounters();
+
+            // Number of times memory was released after N events
+            //
+            uint32_t resets() const;
+
+            // Largest memory held by the Event at reset
+            //
+            uint64_t peakBytes() const;
+
+        private:
+            // Prevent copying
+            //
+            EventRecycler(const EventRecycler &);
+            EventRecycler &operator =(const EventRecycler &);
+
+            EventPtr _event;
+
+            uint32_t _reset_events;
+            uint32_t _events; // decoded since the last reset
+
+            uint32_t _resets;
+            uint64_t _peak_bytes;
+    };
+}
+
+#endif
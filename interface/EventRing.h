@@ -0,0 +1,98 @@
+// Event Ring
+//
+// Bounded ring buffer of decoded Event batches. Reader threads open input
+// files, parse Events and push them in batches; Analyzer threads pop
+// batches and run the analysis. Readers block when the ring is full,
+// Analyzers block when it is empty and there are Readers left.
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_EVENT_RING
+#define BSM_EVENT_RING
+
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "bsm_input/interface/bsm_input_fwd.h"
+
+namespace bsm
+{
+    // Events read from the same input in a row. Input is shared by all
+    // batches of the file: Analyzer is notified about the new file when
+    // Input changes
+    //
+    struct EventBatch
+    {
+        typedef boost::shared_ptr<Event> EventPtr;
+        typedef boost::shared_ptr<Input> InputPtr;
+        typedef std::vector<EventPtr> Events;
+
+        std::string file_name;
+        InputPtr input;
+
+        Events events;
+    };
+
+    typedef boost::shared_ptr<EventBatch> EventBatchPtr;
+
+    class EventRing
+    {
+        public:
+            // Ring can hold up to capacity batches. Ring is drained once
+            // all producers are removed
+            //
+            EventRing(const uint32_t &capacity, const uint32_t &producers);
+
+            // Add batch; wait while ring is full. False is returned if
+            // ring is closed
+            //
+            bool push(const EventBatchPtr &);
+
+            // Take the oldest batch; wait while ring is empty. False is
+            // returned if ring is closed or drained
+            //
+            bool pop(EventBatchPtr &);
+
+            // Producer has no more batches
+            //
+            void removeProducer();
+
+            // Cancel: wake up all waiting threads and refuse new batches
+            //
+            void close();
+
+            uint32_t capacity() const;
+
+            // Number of batches in the ring
+            //
+            uint32_t size() const;
+
+        private:
+            // Prevent copying
+            //
+            EventRing(const EventRing &);
+            EventRing &operator =(const EventRing &);
+
+            typedef std::vector<EventBatchPtr> Batches;
+
+            mutable boost::mutex _mutex;
+            boost::condition_variable _not_full;
+            boost::condition_variable _not_empty;
+
+            Batches _batches;
+
+            uint32_t _head; // next batch to be popped
+            uint32_t _size;
+
+            uint32_t _producers;
+            bool _closed;
+    };
+
+    typedef boost::shared_ptr<EventRing> EventRingPtr;
+}
+
+#endif
@@ -1,6 +1,7 @@
 // Filter Events
 //
-// Apply selectors and filter event objects
+// Apply selectors and filter event objects. Filtered events are written
+// by the SkimWriter thread shared by all analyzer clones
 //
 // Created by Samvel Khalatyan, May 20, 2011
 // Copyright 2011, All rights reserved
@@ -12,6 +13,7 @@
 
 #include "bsm_input/interface/bsm_input_fwd.h"
 #include "interface/Analyzer.h"
+#include "interface/EventRing.h"
 #include "interface/bsm_fwd.h"
 
 namespace bsm
@@ -19,9 +21,20 @@ namespace bsm
     class FilterAnalyzer : public Analyzer
     {
         public:
-            FilterAnalyzer();
+            // Output files are named prefix_N.pb and rolled by size
+            //
+            FilterAnalyzer(const std::string &prefix = "skim",
+                    const uint64_t &file_size = 1024 * 1024 * 1024);
+
+            // Clones share the writer
+            //
             FilterAnalyzer(const FilterAnalyzer &);
 
+            // Write events queued by all clones and close output. Called
+            // once job is done
+            //
+            void close();
+
             // Analyzer interface
             //
             virtual void onFileOpen(const std::string &filename, const Input *);
@@ -32,19 +45,28 @@ namespace bsm
             virtual uint32_t id() const;
 
             virtual ObjectPtr clone() const;
-            using Object::merge;
+
+            // Events left in the partner batch are passed to the writer
+            //
+            virtual void merge(const ObjectPtr &);
 
             virtual void print(std::ostream &) const;
 
         private:
+            // Pass batch to the writer and start a new one of the same
+            // input
+            //
+            void flush();
+
             void primaryVertices(const Event *);
             void electrons(const Event *);
             void muons(const Event *);
             void missing_energy(const Event *);
             void jets(const Event *);
 
-            boost::shared_ptr<Writer> _writer;
+            boost::shared_ptr<SkimWriter> _writer;
 
+            EventBatchPtr _batch;
             boost::shared_ptr<Event> _event;
 
             boost::shared_ptr<ElectronSelector> _pf_el_selector;
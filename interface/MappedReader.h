@@ -0,0 +1,116 @@
+// Mapped Reader
+//
+// Read Event records straight from the memory mapped bsm_input file.
+// Records are parsed from the mapped pages without copying them into
+// intermediate buffers. Kernel is told the file is read sequentially:
+// pages are read ahead aggressively and dropped soon after they are used.
+// Reader has the same interface as RecordReader and reads whole files or
+// their chunks (see RecordReader for the file layout).
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_MAPPED_READER
+#define BSM_MAPPED_READER
+
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+
+#include "bsm_input/interface/bsm_input_fwd.h"
+#include "interface/EventFields.h"
+
+namespace bsm
+{
+    class MappedReader
+    {
+        public:
+            typedef boost::shared_ptr<Event> EventPtr;
+            typedef boost::shared_ptr<Input> InputPtr;
+
+            MappedReader(const std::string &filename);
+            ~MappedReader();
+
+            // Map file, read header and Input. Reader is positioned at the
+            // first Event record
+            //
+            void open();
+            void close();
+
+            bool isOpen() const;
+
+            std::string filename() const;
+            InputPtr input() const;
+
+            // Offset of the first Event record and offset right after the
+            // last one
+            //
+            uint64_t begin() const;
+            uint64_t end() const;
+
+            // Position reader at the record offset. Records are read up to
+            // the limit offset; zero limit is the end of Events
+            //
+            bool seek(const uint64_t &offset, const uint64_t &limit = 0);
+
+            // Offset of the next record to be read
+            //
+            uint64_t tell() const;
+
+            // Parse only given Event fields from now on: other fields are
+            // skipped (see EventFields)
+            //
+            void use(const EventFields &);
+
+            // Parse next record into event. Returns false if limit is
+            // reached or record is corrupted
+            //
+            bool read(EventPtr &);
+
+            // Skip next record without parsing it
+            //
+            bool skip();
+
+            // Reading stopped before the limit: record is truncated or
+            // corrupted
+            //
+            bool hadError() const;
+
+        private:
+            // Prevent copying
+            //
+            MappedReader(const MappedReader &);
+            MappedReader &operator =(const MappedReader &);
+
+            bool readHeader();
+            bool readInput();
+
+            // Read size of the next record. Position is moved to the record
+            // body
+            //
+            bool readSize(uint32_t &);
+
+            // Stop reading at the current position
+            //
+            bool fail();
+
+            std::string _filename;
+
+            const uint8_t *_data;
+            uint64_t _size;
+
+            uint64_t _begin;
+            uint64_t _end;
+
+            uint64_t _position;
+            uint64_t _limit;
+
+            InputPtr _input;
+
+            bool _had_error;
+
+            EventFields _fields;
+            std::string _buffer;
+    };
+}
+
+#endif
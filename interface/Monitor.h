@@ -46,6 +46,12 @@ namespace bsm
             const H1Ptr ptrel() const;
             const H2Ptr ptrel_vs_r() const;
 
+            // Checkpoint: histograms are written and read back in the
+            // order they are declared
+            //
+            bool save(std::ostream &) const;
+            bool load(std::istream &);
+
             // Object interface
             //
             virtual uint32_t id() const;
@@ -87,6 +93,9 @@ namespace bsm
             const H1Ptr pt() const;
             const H1Ptr leading_pt() const;
 
+            bool save(std::ostream &) const;
+            bool load(std::istream &);
+
             // Object interface
             //
             virtual uint32_t id() const;
@@ -120,6 +129,9 @@ namespace bsm
             const H1Ptr status() const;
             const H1Ptr pt() const;
 
+            bool save(std::ostream &) const;
+            bool load(std::istream &);
+
             // Object interface
             //
             virtual uint32_t id() const;
@@ -156,6 +168,9 @@ namespace bsm
             const H1Ptr leading_uncorrected_pt() const;
             const H1Ptr children() const;
 
+            bool save(std::ostream &) const;
+            bool load(std::istream &);
+
             // Object interface
             //
             virtual uint32_t id() const;
@@ -196,6 +211,9 @@ namespace bsm
             const H1Ptr phi() const;
             const H1Ptr mass() const;
 
+            bool save(std::ostream &) const;
+            bool load(std::istream &);
+
             // Object interface
             //
             virtual uint32_t id() const;
@@ -239,6 +257,9 @@ namespace bsm
             const H1Ptr y() const;
             const H1Ptr z() const;
 
+            bool save(std::ostream &) const;
+            bool load(std::istream &);
+
             // Object interface
             //
             virtual uint32_t id() const;
@@ -275,6 +296,9 @@ namespace bsm
             const H1Ptr pt() const;
             const H1Ptr leading_pt() const;
 
+            bool save(std::ostream &) const;
+            bool load(std::istream &);
+
             // Object interface
             //
             virtual uint32_t id() const;
@@ -310,6 +334,9 @@ namespace bsm
             const H1Ptr y() const;
             const H1Ptr z() const;
 
+            bool save(std::ostream &) const;
+            bool load(std::istream &);
+
             // Object interface
             //
             virtual uint32_t id() const;
@@ -45,6 +45,9 @@ namespace bsm
             virtual void onFileOpen(const std::string &filename, const Input *);
             virtual void process(const Event *);
 
+            virtual bool save(std::ostream &) const;
+            virtual bool load(std::istream &);
+
             // Object interface
             //
             virtual uint32_t id() const;
@@ -69,8 +72,9 @@ namespace bsm
             boost::shared_ptr<MultiplicityCutflow> _el_multiplicity;
             P4MonitorPtr _el_monitor;
 
-            boost::shared_ptr<MuonSelector> _mu_selector;
+            boost::shared_ptr<StaticMuonSelector> _mu_selector;
             boost::shared_ptr<MultiplicityCutflow> _mu_multiplicity;
+            boost::shared_ptr<SelectionBatch> _mu_batch;
 
             boost::shared_ptr<WJetSelector> _wjet_selector;
             P4MonitorPtr _wjet_monitor;
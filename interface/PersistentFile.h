@@ -0,0 +1,97 @@
+// Persistent File
+//
+// File with magic and version header that is shared by the jobs, e.g.
+// checkpoint, runtime history or dataset manifest:
+//
+//  [fixed32]   magic
+//  [fixed32]   version
+//  [bytes]     body
+//
+// Body is read and written by the owner of the file. File is written to
+// the unique temporary file first and renamed: readers never see partially
+// written file and concurrent writers do not overwrite each other's
+// temporary files
+//
+//  PersistentFile file("job.history", MAGIC, VERSION);
+//  file.load(boost::bind(&History::readBody, this, _1));
+//  file.save(boost::bind(&History::writeBody, this, _1));
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_PERSISTENT_FILE
+#define BSM_PERSISTENT_FILE
+
+#include <string>
+
+#include <boost/function.hpp>
+
+namespace google
+{
+    namespace protobuf
+    {
+        namespace io
+        {
+            class CodedInputStream;
+            class CodedOutputStream;
+        }
+    }
+}
+
+namespace bsm
+{
+    class PersistentFile
+    {
+        public:
+            typedef google::protobuf::io::CodedInputStream CodedInputStream;
+            typedef google::protobuf::io::CodedOutputStream
+                CodedOutputStream;
+
+            typedef boost::function<bool (CodedInputStream &)> BodyReader;
+            typedef boost::function<void (CodedOutputStream &)> BodyWriter;
+
+            // Exclusive lock of the file is held until the lock is
+            // destroyed. Lock is taken on the separate file next to the
+            // persistent one: the latter is replaced by every save
+            //
+            class Lock
+            {
+                public:
+                    Lock(const PersistentFile &);
+                    ~Lock();
+
+                    bool isLocked() const;
+
+                private:
+                    // Prevent copying
+                    //
+                    Lock(const Lock &);
+                    Lock &operator =(const Lock &);
+
+                    int _fd;
+            };
+
+            PersistentFile(const std::string &filename,
+                    const uint32_t &magic,
+                    const uint32_t &version);
+
+            std::string filename() const;
+
+            // Check header and read the body. False if file is missing,
+            // header does not match or body can not be read
+            //
+            bool load(const BodyReader &) const;
+
+            // Write header and body, and replace the file with the
+            // complete one
+            //
+            bool save(const BodyWriter &) const;
+
+        private:
+            std::string _filename;
+
+            uint32_t _magic;
+            uint32_t _version;
+    };
+}
+
+#endif
@@ -0,0 +1,54 @@
+// Record Index
+//
+// Byte offsets of the Event records in the bsm_input file. Index is built
+// with a single pass over the file: records are skipped without parsing.
+// Built index is cached in the sidecar file next to the input (see
+// Sidecar):
+//
+//      input.pb -> input.pb.idx
+//
+// Created by Samvel Khalatyan, Jul 28, 2011
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_RECORD_INDEX
+#define BSM_RECORD_INDEX
+
+#include <string>
+#include <vector>
+
+#include "interface/Sidecar.h"
+
+namespace bsm
+{
+    class RecordIndex : public Sidecar
+    {
+        public:
+            typedef std::vector<uint64_t> Offsets;
+
+            RecordIndex(const std::string &filename);
+
+            // Scan input file for records
+            //
+            virtual bool scan();
+
+            // Number of Event records in the file
+            //
+            uint32_t size() const;
+
+            // Offset of the Nth record. Offset of the record right after
+            // the last one is returned for N >= size()
+            //
+            uint64_t offset(const uint32_t &record) const;
+
+        protected:
+            virtual void clearBody();
+            virtual bool readBody(CodedInputStream &);
+            virtual void writeBody(CodedOutputStream &) const;
+
+        private:
+            Offsets _offsets;
+            uint64_t _end;
+    };
+}
+
+#endif
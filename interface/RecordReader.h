@@ -0,0 +1,152 @@
+// Record Reader
+//
+// Read Event records from an arbitrary part of the bsm_input file. Reader
+// gives random access to the records given their byte offsets and is used
+// whenever a file is processed in pieces (chunks).
+//
+// bsm_input file layout:
+//
+//  [fixed32]   file format version
+//  [fixed64]   position of the Input message (0 if Input was not written)
+//  [varint32]  Event size
+//  [Event]
+//  ...
+//  [varint32]  Input size
+//  [Input]
+//
+// Created by Samvel Khalatyan, Jul 28, 2011
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_RECORD_READER
+#define BSM_RECORD_READER
+
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+
+#include "bsm_input/interface/bsm_input_fwd.h"
+#include "interface/EventFields.h"
+
+namespace google
+{
+    namespace protobuf
+    {
+        namespace io
+        {
+            class ZeroCopyInputStream;
+        }
+    }
+}
+
+namespace bsm
+{
+    class RecordReader
+    {
+        public:
+            typedef boost::shared_ptr<Event> EventPtr;
+            typedef boost::shared_ptr<Input> InputPtr;
+
+            // Size of the file header: version + Input position
+            //
+            static const uint64_t HEADER_SIZE = 12;
+
+            RecordReader(const std::string &filename);
+            ~RecordReader();
+
+            // Open file, read header and Input. Reader is positioned at
+            // the first Event record
+            //
+            void open();
+            void close();
+
+            bool isOpen() const;
+
+            std::string filename() const;
+            InputPtr input() const;
+
+            // Offset of the first Event record and offset right after the
+            // last one
+            //
+            uint64_t begin() const;
+            uint64_t end() const;
+
+            // Position reader at the record offset. Records are read up to
+            // the limit offset; zero limit is the end of Events
+            //
+            bool seek(const uint64_t &offset, const uint64_t &limit = 0);
+
+            // Offset of the next record to be read
+            //
+            uint64_t tell() const;
+
+            // Parse only given Event fields from now on: other fields are
+            // skipped (see EventFields)
+            //
+            void use(const EventFields &);
+
+            // Read records with asynchronous io_uring reads from the next
+            // seek (see UringInputStream). Reader falls back to the regular
+            // reads if io_uring is not available
+            //
+            void useUring(const bool &use);
+
+            // Read next record into event. Returns false if limit is reached
+            // or record is corrupted
+            //
+            bool read(EventPtr &);
+
+            // Copy next record bytes without parsing them
+            //
+            bool read(std::string &record);
+
+            // Skip next record without parsing it
+            //
+            bool skip();
+
+            // Reading stopped before the limit: read failed or record is
+            // corrupted
+            //
+            bool hadError() const;
+
+        private:
+            // Prevent copying
+            //
+            RecordReader(const RecordReader &);
+            RecordReader &operator =(const RecordReader &);
+
+            typedef ::google::protobuf::io::ZeroCopyInputStream RawInput;
+
+            bool readHeader();
+            bool readInput();
+
+            // Read size of the next record. Position is moved to the record
+            // body
+            //
+            bool readSize(uint32_t &);
+
+            // Stop reading at the current position
+            //
+            bool fail();
+
+            std::string _filename;
+
+            int _fd;
+            boost::shared_ptr<RawInput> _raw_in;
+
+            uint64_t _begin;
+            uint64_t _end;
+
+            uint64_t _position;
+            uint64_t _limit;
+
+            InputPtr _input;
+
+            bool _use_uring;
+            bool _had_error;
+
+            EventFields _fields;
+            std::string _buffer;
+    };
+}
+
+#endif
@@ -0,0 +1,87 @@
+// Runtime History
+//
+// Processing time of the inputs measured by earlier jobs. History is used
+// to estimate the cost of the inputs and schedule the most expensive ones
+// first. Entry is ignored if input size has changed since it was measured.
+// History file may be shared by concurrent jobs: save merges inputs
+// measured by the job into the file under the lock
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_RUNTIME_HISTORY
+#define BSM_RUNTIME_HISTORY
+
+#include <map>
+#include <set>
+#include <string>
+
+#include "interface/PersistentFile.h"
+#include "interface/Thread.h"
+
+namespace bsm
+{
+    class RuntimeHistory
+    {
+        public:
+            RuntimeHistory(const std::string &filename);
+
+            std::string filename() const;
+
+            bool load();
+
+            // Reload the file and replace the inputs measured by the job.
+            // Entries saved by other jobs since load are kept
+            //
+            bool save() const;
+
+            // Record processing time of the input. Previous measurement is
+            // replaced
+            //
+            void add(const InputChunk &,
+                    const uint64_t &bytes,
+                    const double &seconds);
+
+            // Get processing time of the input. False is returned if input
+            // was not measured or it has changed since then
+            //
+            bool runtime(const InputChunk &,
+                    const uint64_t &bytes,
+                    double &seconds) const;
+
+            // Average processing time per byte of all measured inputs
+            //
+            double rate() const;
+
+            // Number of measured inputs
+            //
+            uint32_t size() const;
+
+        private:
+            typedef std::pair<std::string, std::pair<uint64_t, uint64_t> >
+                Input;
+
+            struct Runtime
+            {
+                uint64_t bytes;
+                uint64_t microseconds;
+            };
+
+            typedef std::map<Input, Runtime> Runtimes;
+            typedef std::set<Input> Inputs;
+
+            typedef PersistentFile::CodedInputStream CodedInputStream;
+            typedef PersistentFile::CodedOutputStream CodedOutputStream;
+
+            Input key(const InputChunk &) const;
+
+            static bool readBody(CodedInputStream &, Runtimes &);
+            static void writeBody(CodedOutputStream &, const Runtimes &);
+
+            PersistentFile _file;
+
+            Runtimes _runtimes;
+            Inputs _measured;
+    };
+}
+
+#endif
@@ -0,0 +1,92 @@
+// Selection Batch
+//
+// Objects of one collection selected at once. Every cut gets a column of
+// values: one float per object. Mask keeps the selection result: all bits
+// are set for the object that passed cuts applied so far, zero otherwise.
+//
+// Columns and mask are aligned and padded to the SIMD width: cuts are
+// evaluated for several objects per instruction. Padding never passes.
+//
+//  SelectionBatch batch;
+//  selector.apply(event->jets(), batch);
+//
+//  for(uint32_t jet = 0; batch.size() > jet; ++jet)
+//  {
+//      if (batch.isPass(jet))
+//          ...
+//  }
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_SELECTION_BATCH
+#define BSM_SELECTION_BATCH
+
+#include <stdint.h>
+
+#include <vector>
+
+namespace bsm
+{
+    class SelectionBatch
+    {
+        public:
+            typedef std::vector<uint32_t> Indices;
+
+            // Number of objects handled by one SIMD instruction
+            //
+            enum { WIDTH = 4 };
+
+            SelectionBatch();
+            ~SelectionBatch();
+
+            // Prepare batch for the objects: all objects pass, columns
+            // values are undefined. Memory is reused between calls
+            //
+            void reset(const uint32_t &size, const uint32_t &columns);
+
+            uint32_t size() const;
+
+            // Size rounded up to the SIMD width
+            //
+            uint32_t paddedSize() const;
+
+            uint32_t columns() const;
+
+            float *column(const uint32_t &);
+            const float *column(const uint32_t &) const;
+
+            uint32_t *mask();
+            const uint32_t *mask() const;
+
+            bool isPass(const uint32_t &object) const;
+
+            // Object is rejected without any cut, e.g. data is missing.
+            // Its values are set to zero in all columns
+            //
+            void reject(const uint32_t &object);
+
+            // Number of objects passed
+            //
+            uint32_t passed() const;
+
+            // Indices of objects passed
+            //
+            void indices(Indices &) const;
+
+        private:
+            // Prevent copying
+            //
+            SelectionBatch(const SelectionBatch &);
+            SelectionBatch &operator =(const SelectionBatch &);
+
+            uint32_t _size;
+            uint32_t _padded_size;
+            uint32_t _columns;
+
+            uint32_t _capacity; // in floats
+
+            float *_data;       // columns one after another and mask
+    };
+}
+
+#endif
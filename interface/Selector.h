@@ -16,6 +16,7 @@
 
 #include "bsm_core/interface/Object.h"
 #include "bsm_input/interface/bsm_input_fwd.h"
+#include "interface/bsm_fwd.h"
 #include "interface/Cut.h"
 
 namespace bsm
@@ -27,8 +28,10 @@ namespace bsm
     //  1. print
     //  2. clone
     //  3. merge
+    //  4. save and load
     //
-    // the last two are required for the proper use in threads
+    // clone and merge are required for the proper use in threads, save and
+    // load for the checkpoints
     //
     class Selector : public core::Object
     {
@@ -37,6 +40,12 @@ namespace bsm
             //
             virtual void enable() = 0;
             virtual void disable() = 0;
+
+            // Write cut counters and read them back. Selector should have
+            // the same cuts
+            //
+            virtual bool save(std::ostream &) const = 0;
+            virtual bool load(std::istream &) = 0;
     };
 
     class ElectronSelector : public Selector
@@ -49,6 +58,10 @@ namespace bsm
             //
             virtual bool apply(const Electron &, const PrimaryVertex &);
 
+            // Same test for the electron in the columnar cache
+            //
+            virtual bool apply(const ElectronView &, const PrimaryVertexView &);
+
             // Cuts accessors
             //
             CutPtr et() const;
@@ -60,6 +73,9 @@ namespace bsm
             virtual void enable();
             virtual void disable();
 
+            virtual bool save(std::ostream &) const;
+            virtual bool load(std::istream &);
+
             // Object interface
             //
             virtual uint32_t id() const;
@@ -89,6 +105,10 @@ namespace bsm
             //
             virtual bool apply(const Jet &);
 
+            // Same test for the jet in the columnar cache
+            //
+            virtual bool apply(const JetView &);
+
             // Cuts accessors
             //
             CutPtr pt() const;
@@ -99,6 +119,9 @@ namespace bsm
             virtual void enable();
             virtual void disable();
 
+            virtual bool save(std::ostream &) const;
+            virtual bool load(std::istream &);
+
             // Object interface
             //
             virtual uint32_t id() const;
@@ -130,6 +153,9 @@ namespace bsm
             virtual void enable();
             virtual void disable();
 
+            virtual bool save(std::ostream &) const;
+            virtual bool load(std::istream &);
+
             // Object interface
             //
             virtual uint32_t id() const;
@@ -159,6 +185,10 @@ namespace bsm
             //
             virtual bool apply(const Muon &, const PrimaryVertex &);
 
+            // Same test for the muon in the columnar cache
+            //
+            virtual bool apply(const MuonView &, const PrimaryVertexView &);
+
             // Cuts accessors
             //
             CutPtr pt() const;
@@ -178,6 +208,9 @@ namespace bsm
             virtual void enable();
             virtual void disable();
 
+            virtual bool save(std::ostream &) const;
+            virtual bool load(std::istream &);
+
             // Object interface
             //
             virtual uint32_t id() const;
@@ -215,6 +248,10 @@ namespace bsm
             //
             virtual bool apply(const PrimaryVertex &);
 
+            // Same test for the vertex in the columnar cache
+            //
+            virtual bool apply(const PrimaryVertexView &);
+
             // Cuts accessors
             //
             CutPtr ndof() const;
@@ -226,6 +263,9 @@ namespace bsm
             virtual void enable();
             virtual void disable();
 
+            virtual bool save(std::ostream &) const;
+            virtual bool load(std::istream &);
+
             // Object interface
             //
             virtual uint32_t id() const;
@@ -268,6 +308,9 @@ namespace bsm
             virtual void enable();
             virtual void disable();
 
+            virtual bool save(std::ostream &) const;
+            virtual bool load(std::istream &);
+
             // Object interface
             //
             virtual uint32_t id() const;
@@ -296,11 +339,20 @@ namespace bsm
             LockSelectorEventCounterOnUpdate(JetSelector &);
             LockSelectorEventCounterOnUpdate(MuonSelector &);
             LockSelectorEventCounterOnUpdate(WJetSelector &);
+            LockSelectorEventCounterOnUpdate(StaticElectronSelector &);
+            LockSelectorEventCounterOnUpdate(StaticJetSelector &);
+            LockSelectorEventCounterOnUpdate(StaticMuonSelector &);
+
+            ~LockSelectorEventCounterOnUpdate();
 
         private:
             typedef boost::shared_ptr<LockCounterOnUpdate> Locker;
 
             std::vector<Locker> _lockers;
+
+            // Chain counters are locked as a whole
+            //
+            CutChainCounters *_chain;
     };
 }
 
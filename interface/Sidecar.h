@@ -0,0 +1,93 @@
+// Sidecar
+//
+// Cache file of the input kept next to it, e.g.:
+//
+//      input.pb -> input.pb.idx
+//
+// Header of the sidecar keeps magic, version, input file size and
+// modification time: sidecar is valid as long as input does not change.
+// Body is read and written by the concrete sidecar. Sidecar is written
+// with PersistentFile: readers never see partially written file
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_SIDECAR
+#define BSM_SIDECAR
+
+#include <string>
+
+namespace google
+{
+    namespace protobuf
+    {
+        namespace io
+        {
+            class CodedInputStream;
+            class CodedOutputStream;
+        }
+    }
+}
+
+namespace bsm
+{
+    class Sidecar
+    {
+        public:
+            typedef google::protobuf::io::CodedInputStream CodedInputStream;
+            typedef google::protobuf::io::CodedOutputStream
+                CodedOutputStream;
+
+            Sidecar(const std::string &filename,
+                    const std::string &extension,
+                    const uint32_t &magic,
+                    const uint32_t &version);
+            virtual ~Sidecar();
+
+            // Load sidecar. Input file is scanned if sidecar is missing or
+            // outdated, and new sidecar is saved
+            //
+            bool build();
+
+            // Scan input file and fill the body
+            //
+            virtual bool scan() = 0;
+
+            bool load();
+            bool save() const;
+
+            std::string filename() const;
+            std::string sidecar() const;
+
+        protected:
+            // Take size and modification time of the input: scan should
+            // call it before the input is read
+            //
+            bool stat();
+
+            virtual void clearBody() = 0;
+            virtual bool readBody(CodedInputStream &) = 0;
+            virtual void writeBody(CodedOutputStream &) const = 0;
+
+        private:
+            // Prevent copying
+            //
+            Sidecar(const Sidecar &);
+            Sidecar &operator =(const Sidecar &);
+
+            // Check input size and modification time, and read the body
+            //
+            bool readFile(CodedInputStream &);
+            void writeFile(CodedOutputStream &) const;
+
+            std::string _filename;
+            std::string _extension;
+
+            uint32_t _magic;
+            uint32_t _version;
+
+            uint64_t _file_size;
+            int64_t _file_mtime;
+    };
+}
+
+#endif
@@ -0,0 +1,85 @@
+// Skim Writer
+//
+// Write filtered events on a dedicated thread. Analyzer threads collect
+// events in own batches and pass full batches to the writer through the
+// bounded ring: events are serialized and written by the writer thread
+// only. Analyzer threads wait only if the writer falls behind by the
+// whole ring.
+//
+// Output files are rolled by size instead of the input files: skim comes
+// out as few large files. Events refer to the triggers of the file Input:
+// one file is kept open per trigger menu.
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_SKIM_WRITER
+#define BSM_SKIM_WRITER
+
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "bsm_core/interface/bsm_core_fwd.h"
+#include "interface/EventRing.h"
+
+namespace bsm
+{
+    class SkimWriter
+    {
+        public:
+            // Output files are named prefix_N.pb. New file is started once
+            // the current one of the trigger menu reaches the size
+            //
+            SkimWriter(const std::string &prefix, const uint64_t &file_size);
+            ~SkimWriter();
+
+            // Queue batch of events: writer thread is started with the
+            // first batch. Input of the batch should not be modified
+            // afterwards. False is returned if writer is closed
+            //
+            bool push(const EventBatchPtr &);
+
+            // Write queued batches, close the last file and stop thread
+            //
+            void close();
+
+            // Counters are valid once writer is closed
+            //
+            uint32_t files() const;
+            uint64_t events() const;
+            uint64_t bytes() const;
+
+            // Events of the files that failed to open
+            //
+            uint64_t droppedEvents() const;
+
+        private:
+            class WriterOperation;
+
+            // Prevent copying
+            //
+            SkimWriter(const SkimWriter &);
+            SkimWriter &operator =(const SkimWriter &);
+
+            void start();
+
+            boost::mutex _mutex;
+
+            bool _is_closed;
+
+            // Batches being pushed outside of the lock: writer is closed
+            // once all of them are in the ring
+            //
+            uint32_t _pushes;
+            boost::condition_variable _pushed;
+
+            EventRingPtr _batches;
+
+            boost::shared_ptr<WriterOperation> _operation;
+            boost::shared_ptr<core::Thread> _thread;
+    };
+}
+
+#endif
@@ -0,0 +1,103 @@
+// Staging Cache
+//
+// Local copies of the remote inputs shared by all jobs on the node.
+// Input is copied into the cache directory the first time it is
+// processed and later jobs read the local copy. Copies are keyed by the
+// input path, size and modification time: changed input is staged again.
+//
+// Cache is limited in size: the least recently used copies are removed
+// to make room for the new ones. Copies are written under temporary name
+// and renamed once complete: jobs running at the same time never read
+// partial copies.
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_STAGING_CACHE
+#define BSM_STAGING_CACHE
+
+#include <set>
+#include <string>
+
+#include <boost/atomic.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+
+namespace bsm
+{
+    class StagingCache
+    {
+        public:
+            StagingCache(const std::string &directory,
+                    const uint64_t &max_bytes);
+
+            std::string directory() const;
+
+            // Local copy of the input: input is copied on cache miss.
+            // Original file name is returned if input can not be staged,
+            // e.g. it does not fit the cache
+            //
+            std::string stage(const std::string &file_name);
+
+            // Counters are atomic and can be read at any time. Each input
+            // is counted once however many chunks of it are staged
+            //
+            uint32_t hits() const;
+            uint32_t copies() const;
+            uint32_t bypasses() const;
+
+            uint64_t bytesCopied() const;
+
+        private:
+            // Prevent copying
+            //
+            StagingCache(const StagingCache &);
+            StagingCache &operator =(const StagingCache &);
+
+            // Cache file name: path hash, size, modification time and
+            // the input base name
+            //
+            std::string cacheName(const std::string &file_name,
+                    const uint64_t &size,
+                    const int64_t &mtime) const;
+
+            // Remove the least recently used copies until new file fits
+            // the cache. Copies being written by other jobs count with
+            // their full size. False is returned if it does not fit at all
+            //
+            bool evict(const uint64_t &bytes);
+
+            // Bytes taken by the temporary copy of another job: stale
+            // copies of the finished jobs are removed
+            //
+            uint64_t temporarySize(const std::string &name,
+                    const std::string::size_type &suffix,
+                    const uint64_t &size) const;
+
+            // Count the first stage of the input. Lock should be held
+            //
+            void count(boost::atomic<uint32_t> &counter,
+                    const std::string &file_name);
+
+            bool copy(const std::string &from, const std::string &to);
+
+            std::string _directory;
+            uint64_t _max_bytes;
+
+            // Inputs being copied by this job: other threads wait for the
+            // copy instead of making their own one
+            //
+            boost::mutex _mutex;
+            boost::condition_variable _condition;
+            std::set<std::string> _copying;
+            uint64_t _bytes_reserved; // by the copies in progress
+            std::set<std::string> _staged; // inputs counted
+
+            boost::atomic<uint32_t> _hits;
+            boost::atomic<uint32_t> _copies;
+            boost::atomic<uint32_t> _bypasses;
+
+            boost::atomic<uint64_t> _bytes_copied;
+    };
+}
+
+#endif
@@ -6,6 +6,8 @@
 #ifndef BSM_STAT_PROXY
 #define BSM_STAT_PROXY
 
+#include <iosfwd>
+
 #include <boost/shared_ptr.hpp>
 
 #include "bsm_core/interface/Object.h"
@@ -23,6 +25,13 @@ namespace bsm
 
             const H1Ptr histogram() const;
 
+            // Checkpoint: bin contents are written and read back into the
+            // histogram with the same binning. Each bin is restored with
+            // one fill at its center weighted by the content
+            //
+            bool save(std::ostream &) const;
+            bool load(std::istream &);
+
             // Object interface
             //
             virtual uint32_t id() const;
@@ -57,6 +66,11 @@ namespace bsm
 
             const H2Ptr histogram() const;
 
+            // Checkpoint: see H1Proxy
+            //
+            bool save(std::ostream &) const;
+            bool load(std::istream &);
+
             // Object interface
             //
             virtual uint32_t id() const;
@@ -0,0 +1,289 @@
+// Static Selectors
+//
+// Electron, jet and muon selectors with the cuts chain fixed at compile
+// time. Cuts, cutflow and printout are the same as the ones of the
+// corresponding Selector (see Selector.h) but cuts are inlined and all
+// objects of the event could be selected at once into SelectionBatch
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_STATIC_SELECTOR
+#define BSM_STATIC_SELECTOR
+
+#include <functional>
+#include <iosfwd>
+
+#include "bsm_input/interface/Electron.pb.h"
+#include "bsm_input/interface/Jet.pb.h"
+#include "bsm_input/interface/Muon.pb.h"
+#include "interface/bsm_fwd.h"
+#include "interface/CutChain.h"
+#include "interface/SelectionBatch.h"
+#include "interface/Selector.h"
+
+namespace bsm
+{
+    // Same cuts as ElectronSelector with the chain fixed at compile time.
+    // All electrons of the event could be selected at once
+    //
+    class StaticElectronSelector : public Selector
+    {
+        public:
+            typedef ::google::protobuf::RepeatedPtrField<Electron> Electrons;
+
+            typedef CutList<std::greater<float>,
+                    CutList<std::less<float>,
+                    CutList<std::less<float> > > > Cuts;
+
+            typedef CutChain<Cuts> Chain;
+
+            StaticElectronSelector();
+            StaticElectronSelector(const StaticElectronSelector &);
+
+            // Test if electron passes the selector
+            //
+            bool apply(const Electron &, const PrimaryVertex &);
+
+            // Same test for the electron in the columnar cache
+            //
+            bool apply(const ElectronView &, const PrimaryVertexView &);
+
+            // Test all electrons: batch mask holds the result
+            //
+            void apply(const Electrons &, const PrimaryVertex &,
+                    SelectionBatch &);
+
+            // Test all electrons of the event in the columnar cache
+            //
+            void apply(const EventView &, const PrimaryVertexView &,
+                    SelectionBatch &);
+
+            Chain &cuts();
+
+            // Cuts accessors
+            //
+            ChainCut &et();
+            ChainCut &eta();
+            ChainCut &primary_vertex();
+
+            // Selector interface
+            //
+            virtual void enable();
+            virtual void disable();
+
+            virtual bool save(std::ostream &) const;
+            virtual bool load(std::istream &);
+
+            // Object interface
+            //
+            virtual uint32_t id() const;
+
+            virtual ObjectPtr clone() const;
+            virtual void merge(const ObjectPtr &);
+
+            virtual void print(std::ostream &) const;
+
+        private:
+            // Prevent copying
+            //
+            StaticElectronSelector &operator =(const StaticElectronSelector &);
+
+            // Cut index is also the batch column
+            //
+            enum
+            {
+                ET = 0,
+                ETA,
+                PRIMARY_VERTEX
+            };
+
+            // Apply all cuts to the filled batch
+            //
+            void select(SelectionBatch &);
+
+            Chain _cuts;
+    };
+
+    // Same cuts as JetSelector with the chain fixed at compile time. All
+    // jets of the event could be selected at once
+    //
+    class StaticJetSelector : public Selector
+    {
+        public:
+            typedef ::google::protobuf::RepeatedPtrField<Jet> Jets;
+
+            typedef CutList<std::greater<float>,
+                    CutList<std::less<float> > > Cuts;
+
+            typedef CutChain<Cuts> Chain;
+
+            StaticJetSelector();
+            StaticJetSelector(const StaticJetSelector &);
+
+            // Test if object passes the selector
+            //
+            bool apply(const Jet &);
+
+            // Same test for the jet in the columnar cache
+            //
+            bool apply(const JetView &);
+
+            // Test all jets: batch mask holds the result
+            //
+            void apply(const Jets &, SelectionBatch &);
+
+            // Test all jets of the event in the columnar cache
+            //
+            void apply(const EventView &, SelectionBatch &);
+
+            Chain &cuts();
+
+            // Cuts accessors
+            //
+            ChainCut &pt();
+            ChainCut &eta();
+
+            // Selector interface
+            //
+            virtual void enable();
+            virtual void disable();
+
+            virtual bool save(std::ostream &) const;
+            virtual bool load(std::istream &);
+
+            // Object interface
+            //
+            virtual uint32_t id() const;
+
+            virtual ObjectPtr clone() const;
+            virtual void merge(const ObjectPtr &);
+
+            virtual void print(std::ostream &) const;
+
+        private:
+            // Prevent copying
+            //
+            StaticJetSelector &operator =(const StaticJetSelector &);
+
+            // Cut index is also the batch column
+            //
+            enum
+            {
+                PT = 0,
+                ETA
+            };
+
+            // Apply all cuts to the filled batch
+            //
+            void select(SelectionBatch &);
+
+            Chain _cuts;
+    };
+
+    // Same cuts as MuonSelector with the chain fixed at compile time: cuts
+    // are inlined and counted in one block. Cutflow and printout are the
+    // same as the ones of MuonSelector
+    //
+    class StaticMuonSelector : public Selector
+    {
+        public:
+            typedef ::google::protobuf::RepeatedPtrField<Muon> Muons;
+
+            typedef CutList<std::greater<float>,
+                    CutList<std::less<float>,
+                    CutList<std::logical_and<bool>,
+                    CutList<std::logical_and<bool>,
+                    CutList<std::greater<float>,
+                    CutList<std::greater<float>,
+                    CutList<std::less<float>,
+                    CutList<std::greater<float>,
+                    CutList<std::greater<float>,
+                    CutList<std::less<float>,
+                    CutList<std::less<float> > > > > > > > > > > > Cuts;
+
+            typedef CutChain<Cuts> Chain;
+
+            StaticMuonSelector();
+            StaticMuonSelector(const StaticMuonSelector &);
+
+            // Test if muon passes the selector
+            //
+            bool apply(const Muon &, const PrimaryVertex &);
+
+            // Same test for the muon in the columnar cache
+            //
+            bool apply(const MuonView &, const PrimaryVertexView &);
+
+            // Test all muons: batch mask holds the result
+            //
+            void apply(const Muons &, const PrimaryVertex &, SelectionBatch &);
+
+            // Test all muons of the event in the columnar cache
+            //
+            void apply(const EventView &, const PrimaryVertexView &,
+                    SelectionBatch &);
+
+            Chain &cuts();
+
+            // Cuts accessors
+            //
+            ChainCut &pt();
+            ChainCut &eta();
+            ChainCut &is_global();
+            ChainCut &is_tracker();
+            ChainCut &muon_segments();
+            ChainCut &muon_hits();
+            ChainCut &muon_normalized_chi2();
+            ChainCut &tracker_hits();
+            ChainCut &pixel_hits();
+            ChainCut &d0_bsp();
+            ChainCut &primary_vertex();
+
+            // Selector interface
+            //
+            virtual void enable();
+            virtual void disable();
+
+            virtual bool save(std::ostream &) const;
+            virtual bool load(std::istream &);
+
+            // Object interface
+            //
+            virtual uint32_t id() const;
+
+            virtual ObjectPtr clone() const;
+            virtual void merge(const ObjectPtr &);
+
+            virtual void print(std::ostream &) const;
+
+        private:
+            // Prevent copying
+            //
+            StaticMuonSelector &operator =(const StaticMuonSelector &);
+
+            // Cut index is also the batch column
+            //
+            enum
+            {
+                PT = 0,
+                ETA,
+                IS_GLOBAL,
+                IS_TRACKER,
+                MUON_SEGMENTS,
+                MUON_HITS,
+                MUON_NORMALIZED_CHI2,
+                TRACKER_HITS,
+                PIXEL_HITS,
+                D0_BSP,
+                PRIMARY_VERTEX
+            };
+
+            // Apply all cuts to the filled batch
+            //
+            void select(SelectionBatch &);
+
+            Chain _cuts;
+    };
+}
+
+#endif
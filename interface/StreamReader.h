@@ -0,0 +1,121 @@
+// Stream Reader
+//
+// Read Event records from the standard input ("-") or a named pipe. An
+// upstream producer (skimmer, decompressor, network fetcher) writes
+// Events without intermediate files:
+//
+//  [varint32]  Input size
+//  [Input]
+//  [varint32]  Event size
+//  [Event]
+//  ...
+//
+// Stream has no header and can only be read once, in order. Input is sent
+// first: events refer to its trigger menu. Reader has the read interface
+// of RecordReader.
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_STREAM_READER
+#define BSM_STREAM_READER
+
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+
+#include "bsm_input/interface/bsm_input_fwd.h"
+#include "interface/EventFields.h"
+
+namespace google
+{
+    namespace protobuf
+    {
+        namespace io
+        {
+            class FileInputStream;
+        }
+    }
+}
+
+namespace bsm
+{
+    class StreamReader
+    {
+        public:
+            typedef boost::shared_ptr<Event> EventPtr;
+            typedef boost::shared_ptr<Input> InputPtr;
+
+            // Standard input or named pipe: such inputs can not be
+            // split, copied or read ahead
+            //
+            static bool isStream(const std::string &filename);
+
+            StreamReader(const std::string &filename);
+            ~StreamReader();
+
+            // Named pipe is opened once the writer shows up. Input is
+            // read right away: stream without Input is not opened
+            //
+            void open();
+            void close();
+
+            bool isOpen() const;
+
+            std::string filename() const;
+
+            InputPtr input() const;
+
+            // Number of bytes read so far
+            //
+            uint64_t tell() const;
+
+            // Parse only given Event fields from now on: other fields are
+            // skipped (see EventFields)
+            //
+            void use(const EventFields &);
+
+            // Read next record into event. Returns false at the end of
+            // stream or if record is corrupted
+            //
+            bool read(EventPtr &);
+
+            // Copy next record bytes without parsing them
+            //
+            bool read(std::string &record);
+
+            // Reading stopped in the middle of the record: record is
+            // truncated or corrupted
+            //
+            bool hadError() const;
+
+        private:
+            // Prevent copying
+            //
+            StreamReader(const StreamReader &);
+            StreamReader &operator =(const StreamReader &);
+
+            typedef ::google::protobuf::io::FileInputStream RawInput;
+
+            // Move position past the record or stop reading the stream
+            //
+            bool advance(const bool &has_size,
+                    const bool &is_read,
+                    const uint32_t &size);
+
+            std::string _filename;
+
+            int _fd;
+            boost::shared_ptr<RawInput> _raw_in;
+
+            uint64_t _position;
+
+            InputPtr _input;
+
+            bool _had_error;
+
+            EventFields _fields;
+            std::string _buffer;
+    };
+}
+
+#endif
@@ -52,6 +52,9 @@ namespace bsm
             virtual void onFileOpen(const std::string &filename, const Input *);
             virtual void process(const Event *);
 
+            virtual bool save(std::ostream &) const;
+            virtual bool load(std::istream &);
+
             // Object interface
             //
             virtual uint32_t id() const;
@@ -145,6 +148,9 @@ namespace bsm
             virtual void onFileOpen(const std::string &filename, const Input *);
             virtual void process(const Event *);
 
+            virtual bool save(std::ostream &) const;
+            virtual bool load(std::istream &);
+
             // Object interface
             //
             virtual uint32_t id() const;
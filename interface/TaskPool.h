@@ -0,0 +1,219 @@
+// Task Pool
+//
+// Work-stealing pool of input tasks. Each worker owns a deque of tasks:
+// worker takes tasks from the back of own deque and, once it is empty,
+// steals from the front of other workers' deques. Workers never wait for
+// the controller to hand out the next task.
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_TASK_POOL
+#define BSM_TASK_POOL
+
+#include <deque>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+namespace bsm
+{
+    template<class Task>
+        class TaskPool
+        {
+            public:
+                TaskPool(const uint32_t &workers);
+
+                uint32_t workers() const;
+
+                // Schedule task for worker
+                //
+                void push(const uint32_t &worker, const Task &);
+
+                // Get next task for worker: own tasks first, steal
+                // otherwise. False is returned if pool is empty
+                //
+                bool pop(const uint32_t &worker, Task &);
+
+                // Copy up to N tasks worker is going to take next from own
+                // deque, the nearest first. Used to prepare tasks ahead
+                //
+                void peek(const uint32_t &worker,
+                        const uint32_t &tasks,
+                        std::vector<Task> &) const;
+
+                // Remove all scheduled tasks: used on cancellation
+                //
+                void clear();
+
+                // Number of scheduled tasks
+                //
+                uint32_t size() const;
+
+                // Number of tasks stolen from other workers
+                //
+                uint32_t steals() const;
+
+            private:
+                // Prevent copying
+                //
+                TaskPool(const TaskPool &);
+                TaskPool &operator =(const TaskPool &);
+
+                class Queue
+                {
+                    public:
+                        Queue();
+
+                        mutable boost::mutex mutex;
+                        std::deque<Task> tasks;
+                        uint32_t steals;
+                };
+
+                typedef boost::shared_ptr<Queue> QueuePtr;
+                typedef std::vector<QueuePtr> Queues;
+
+                Queues _queues;
+        };
+}
+
+// Template(s) implementation
+//
+template<class Task>
+    bsm::TaskPool<Task>::Queue::Queue():
+        steals(0)
+{
+}
+
+template<class Task>
+    bsm::TaskPool<Task>::TaskPool(const uint32_t &workers)
+{
+    for(uint32_t worker = 0; (workers ? workers : 1) > worker; ++worker)
+        _queues.push_back(QueuePtr(new Queue()));
+}
+
+template<class Task>
+    uint32_t bsm::TaskPool<Task>::workers() const
+{
+    return _queues.size();
+}
+
+template<class Task>
+    void bsm::TaskPool<Task>::push(const uint32_t &worker, const Task &task)
+{
+    Queue &queue = *_queues[worker % _queues.size()];
+
+    boost::mutex::scoped_lock lock(queue.mutex);
+
+    queue.tasks.push_back(task);
+}
+
+template<class Task>
+    bool bsm::TaskPool<Task>::pop(const uint32_t &worker, Task &task)
+{
+    const uint32_t queues = _queues.size();
+    const uint32_t owner = worker % queues;
+
+    {
+        Queue &queue = *_queues[owner];
+
+        boost::mutex::scoped_lock lock(queue.mutex);
+        if (!queue.tasks.empty())
+        {
+            task = queue.tasks.back();
+            queue.tasks.pop_back();
+
+            return true;
+        }
+    }
+
+    // Own queue is empty: steal the oldest task from the next non-empty
+    // victim. Victims are visited in order starting from the neighbour
+    // to spread the steals
+    //
+    for(uint32_t offset = 1; queues > offset; ++offset)
+    {
+        Queue &victim = *_queues[(owner + offset) % queues];
+
+        boost::mutex::scoped_lock lock(victim.mutex);
+        if (victim.tasks.empty())
+            continue;
+
+        task = victim.tasks.front();
+        victim.tasks.pop_front();
+
+        ++victim.steals;
+
+        return true;
+    }
+
+    return false;
+}
+
+template<class Task>
+    void bsm::TaskPool<Task>::peek(const uint32_t &worker,
+            const uint32_t &tasks,
+            std::vector<Task> &next) const
+{
+    next.clear();
+
+    const Queue &queue = *_queues[worker % _queues.size()];
+
+    boost::mutex::scoped_lock lock(queue.mutex);
+
+    for(typename std::deque<Task>::const_reverse_iterator task =
+                queue.tasks.rbegin();
+            queue.tasks.rend() != task
+                && tasks > next.size();
+            ++task)
+    {
+        next.push_back(*task);
+    }
+}
+
+template<class Task>
+    void bsm::TaskPool<Task>::clear()
+{
+    for(typename Queues::iterator queue = _queues.begin();
+            _queues.end() != queue;
+            ++queue)
+    {
+        boost::mutex::scoped_lock lock((*queue)->mutex);
+
+        (*queue)->tasks.clear();
+    }
+}
+
+template<class Task>
+    uint32_t bsm::TaskPool<Task>::size() const
+{
+    uint32_t tasks = 0;
+    for(typename Queues::const_iterator queue = _queues.begin();
+            _queues.end() != queue;
+            ++queue)
+    {
+        boost::mutex::scoped_lock lock((*queue)->mutex);
+
+        tasks += (*queue)->tasks.size();
+    }
+
+    return tasks;
+}
+
+template<class Task>
+    uint32_t bsm::TaskPool<Task>::steals() const
+{
+    uint32_t steals = 0;
+    for(typename Queues::const_iterator queue = _queues.begin();
+            _queues.end() != queue;
+            ++queue)
+    {
+        boost::mutex::scoped_lock lock((*queue)->mutex);
+
+        steals += (*queue)->steals;
+    }
+
+    return steals;
+}
+
+#endif
@@ -8,22 +8,110 @@
 #ifndef BSM_THREAD
 #define BSM_THREAD
 
+#include <sys/types.h>
+
+#include <map>
 #include <queue>
 #include <stack>
 #include <string>
+#include <vector>
 
+#include <boost/atomic.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/weak_ptr.hpp>
 
 #include "interface/bsm_fwd.h"
+#include "interface/EventRecycler.h"
+#include "interface/EventFields.h"
+#include "interface/EventRing.h"
+#include "interface/TaskPool.h"
 #include "bsm_core/interface/bsm_core_fwd.h"
 #include "bsm_core/interface/Thread.h"
 
 namespace bsm
 {
+    class Checkpoint;
+    class DatasetManifest;
+    class MappedReader;
     class Reader;
+    class RecordReader;
+    class RuntimeHistory;
+    class StagingCache;
     class ThreadController;
 
     typedef boost::shared_ptr<Analyzer> AnalyzerPtr;
+    typedef boost::shared_ptr<StagingCache> StagingCachePtr;
+
+    // Part of the input file to be processed: Event records at byte offsets
+    // [begin, end). Empty range stands for the whole file
+    //
+    struct InputChunk
+    {
+        InputChunk(const std::string &file_name = "",
+                const uint64_t &begin = 0,
+                const uint64_t &end = 0);
+
+        bool isWholeFile() const;
+
+        std::string file_name;
+
+        uint64_t begin;
+        uint64_t end;
+
+        // Estimated processing cost: inputs are scheduled largest-first
+        //
+        double cost;
+    };
+
+    typedef TaskPool<InputChunk> InputTasks;
+    typedef boost::shared_ptr<InputTasks> InputTasksPtr;
+
+    // Progress of the running analyzer or reader thread
+    //
+    struct ThreadStats
+    {
+        ThreadStats();
+
+        std::string type;
+        uint32_t id;
+
+        uint64_t events;
+        uint64_t bytes;
+
+        std::string input; // being processed
+    };
+
+    // Snapshot of the job progress: finished rounds and running threads
+    //
+    struct JobStats
+    {
+        typedef std::vector<ThreadStats> Threads;
+
+        JobStats();
+
+        double elapsed; // seconds since the job start
+
+        uint64_t events;
+        uint64_t bytes;
+
+        // Events in the job inputs given by the dataset manifest. Inputs
+        // missing in the manifest are estimated by size. Zero if there is
+        // no manifest
+        //
+        uint64_t events_expected;
+
+        uint32_t inputs_processed;
+        uint32_t inputs_left;
+
+        uint32_t batches; // pipelined mode ring
+        uint32_t batches_capacity;
+
+        uint32_t processes;
+
+        Threads threads;
+    };
 
     // Keyaboard Thread: watch for keyboard input and report to the controller
     //
@@ -54,12 +142,216 @@ namespace bsm
             core::Thread *_thread;
             ThreadController *_thread_controller;
 
-            bool _continue;
+            boost::atomic<bool> _continue;
 
             boost::shared_ptr<core::Keyboard> _keyboard_controller;
     };
 
-    // Analyzer Thread: perform the analysis
+    // Stats Thread: periodically write job progress to the JSON file for
+    // monitoring jobs without terminal. File is replaced atomically
+    //
+    class StatsOperation : public core::Operation
+    {
+        public:
+            StatsOperation();
+
+            void init(ThreadController *,
+                    const std::string &file_name,
+                    const uint32_t &interval);
+
+            // Operation interface
+            //
+            virtual void run();
+            virtual void stop();
+
+            virtual void onThreadInit(core::Thread *);
+
+        private:
+            // Sleep for the interval. False is returned if thread was
+            // stopped
+            //
+            bool wait();
+
+            // Write progress. Rates are measured since the previous
+            // snapshot
+            //
+            void write(const JobStats &);
+
+            core::Thread *_thread;
+            ThreadController *_thread_controller;
+
+            std::string _file_name;
+            uint32_t _interval;
+
+            boost::mutex _mutex;
+            boost::condition_variable _condition;
+            bool _continue;
+
+            JobStats _previous;
+    };
+
+    // Readahead Thread: ask the system to load inputs the workers are going
+    // to take next into the page cache. Workers do not wait for the first
+    // read of the file on network file systems. Inputs being loaded are
+    // limited in total size
+    //
+    class ReadaheadOperation : public core::Operation
+    {
+        public:
+            ReadaheadOperation();
+
+            // Tasks can only be set when thread is not running. Up to N
+            // next inputs of each worker are loaded
+            //
+            void use(const InputTasksPtr &tasks,
+                    const uint32_t &inputs,
+                    const uint64_t &bytes);
+
+            // Operation interface
+            //
+            virtual void run();
+            virtual void stop();
+
+            virtual void onThreadInit(core::Thread *);
+
+            uint32_t inputsLoaded() const;
+            uint64_t bytesLoaded() const;
+
+        private:
+            typedef std::pair<std::string, std::pair<uint64_t, uint64_t> >
+                Input;
+
+            typedef std::map<Input, uint64_t> Inputs; // size in bytes
+
+            bool isRunning() const;
+            bool isContinue() const;
+
+            // Sleep between the passes. False is returned if thread was
+            // stopped
+            //
+            bool wait();
+
+            // Load inputs that entered the window of next tasks
+            //
+            void process();
+
+            // Start loading of the input: system readahead is used if
+            // supported, input is read otherwise
+            //
+            void load(const InputChunk &, const uint64_t &bytes);
+
+            Input key(const InputChunk &) const;
+
+            core::Thread *_thread;
+
+            InputTasksPtr _tasks;
+            uint32_t _inputs;
+            uint64_t _max_bytes;
+
+            mutable boost::mutex _mutex;
+            boost::condition_variable _condition;
+            bool _continue;
+
+            Inputs _loaded; // inputs in the window that are loaded
+
+            boost::atomic<uint32_t> _inputs_loaded;
+            boost::atomic<uint64_t> _bytes_loaded;
+    };
+
+    // Reader Thread: open inputs, parse Events and pass them to Analyzer
+    // threads through the ring in batches
+    //
+    class ReaderOperation : public core::Operation
+    {
+        public:
+            ReaderOperation();
+
+            // Tasks and Ring can only be set when thread is not running
+            //
+            void use(const InputTasksPtr &tasks, const uint32_t &worker);
+            void use(const EventRingPtr &events);
+
+            // Parse only Event fields used by analyzers
+            //
+            void use(const EventFields &fields);
+
+            // Read inputs with MappedReader
+            //
+            void useMappedReader(const bool &use);
+
+            // Read inputs with asynchronous io_uring reads
+            //
+            void useUringReader(const bool &use);
+
+            // Read local copies of the inputs from the staging cache
+            //
+            void use(const StagingCachePtr &staging);
+
+            // Operation interface
+            //
+            virtual void run();
+            virtual void stop();
+
+            virtual void onThreadInit(core::Thread *);
+
+            uint32_t worker() const;
+
+            // Progress counters are atomic
+            //
+            uint32_t eventsRead() const;
+            uint64_t bytesRead() const;
+            uint32_t inputsProcessed() const;
+
+            std::string currentInput() const;
+
+        private:
+            core::Thread *thread() const;
+
+            bool isRunning() const;
+            bool isContinue() const;
+
+            // Read input and push events into the ring
+            //
+            void process(const InputChunk &);
+
+            // Read chunk from the file: staged copy or the original
+            // input. False is returned if file can not be opened
+            //
+            bool process(const InputChunk &,
+                    const std::string &file_name,
+                    const EventBatchPtr &);
+
+            template<class T>
+                void read(T &reader, EventBatchPtr batch);
+
+            core::Thread *_thread;
+
+            boost::atomic<bool> _continue;
+
+            InputTasksPtr _tasks;
+            uint32_t _worker;
+
+            EventRingPtr _events;
+            EventFields _fields;
+
+            bool _use_mapped_reader;
+            bool _use_uring_reader;
+
+            StagingCachePtr _staging;
+
+            boost::atomic<uint32_t> _events_read;
+            boost::atomic<uint64_t> _bytes_read;
+            boost::atomic<uint32_t> _inputs_processed;
+
+            // Input has own lock: it is read by the stats under the
+            // controller lock
+            //
+            mutable boost::mutex _input_mutex;
+            std::string _input;
+    };
+
+    // Analyzer Thread: perform the analysis. Thread is kept in the pool and
+    // waits for the next job once current one is done
     //
     class AnalyzerOperation : public core::Operation,
                                 public core::RunLoopDelegate
@@ -68,17 +360,74 @@ namespace bsm
             AnalyzerOperation();
             virtual ~AnalyzerOperation();
 
-            // Controller and Analyzer can only be set when thread
-            // is not running
+            // Controller, Analyzer and Tasks can only be set when thread
+            // is idle: there is no job running
             //
             void use(ThreadController *controller);
-            void use(const AnalyzerPtr &analyzer);
 
-            AnalyzerPtr analyzer() const;
+            // Master analyzer identifies the job analysis: clone of the
+            // previous job is reused if master is the same and clone
+            // supports reset. Otherwise prototype is cloned at the job
+            // start
+            //
+            void use(const AnalyzerPtr &master, const AnalyzerPtr &prototype);
+
+            // Tasks are taken from the worker deque in the pool. Idle
+            // worker steals tasks from the others
+            //
+            void use(const InputTasksPtr &tasks, const uint32_t &worker);
 
-            // Scheule file for processing. Method does nothing is file
-            // is already set but processing didn't start
-            bool init(const std::string &file_name);
+            // Take decoded events from the ring instead of reading inputs:
+            // pipelined mode
+            //
+            void use(const EventRingPtr &events);
+
+            // Read inputs straight from the memory mapped files instead of
+            // streaming them through the Reader
+            //
+            void useMappedReader(const bool &use);
+
+            // Read inputs with RecordReader using asynchronous io_uring
+            // reads
+            //
+            void useUringReader(const bool &use);
+
+            // Read local copies of the inputs from the staging cache.
+            // Analyzer is given the original file names
+            //
+            void use(const StagingCachePtr &staging);
+
+            // Release memory of the decoded Event every N events. Event is
+            // reused between records otherwise
+            //
+            void setEventReset(const uint32_t &events);
+
+            // Bind thread to the CPUs at the job start. Analyzer is cloned
+            // right after that in the thread itself: clone memory is
+            // touched first by the pinned thread and therefore is
+            // allocated on the CPU NUMA node. Pooled thread is bound to
+            // all CPUs allowed for the process if it is not pinned: it
+            // may have been pinned by the previous job. Empty list leaves
+            // affinity unchanged
+            //
+            void pin(const std::vector<int> &cpus);
+
+            // Start job with current settings. Controller is notified
+            // when job is done and thread goes back to idle
+            //
+            void startJob();
+
+            // Leave the pool: running job is stopped and thread quits
+            //
+            void shutdown();
+
+            bool isIdle() const;
+
+            // Test if clone of the previous job was reused by last job
+            //
+            bool isCloneReused() const;
+
+            AnalyzerPtr analyzer() const;
 
             // Operation interface
             //
@@ -91,49 +440,137 @@ namespace bsm
             //
             virtual void onRunLoopCommand(const uint32_t &);
 
+            // Progress counters are atomic and can be read at any time
+            // without blocking the thread
+            //
             uint32_t eventsProcessed() const;
-            uint32_t totalEventsSize() const;
+            uint64_t totalEventsSize() const;
+            uint32_t inputsProcessed() const;
+
+            // Event recycler counters are only valid once the job is done
+            //
+            uint32_t eventResets() const;
+            uint64_t peakEventBytes() const;
+
+            std::string currentInput() const;
 
         private:
             typedef boost::shared_ptr<Reader> ReaderPtr;
+            typedef boost::shared_ptr<RecordReader> RecordReaderPtr;
+            typedef boost::shared_ptr<MappedReader> MappedReaderPtr;
 
             core::Thread *thread() const;
 
-            bool isRunning() const;
-            // isContinue is called only when thread is running and therefore
-            // uses lock
+            // isContinue is checked before every event: stop flag is atomic
+            // and does not need a lock. Thread is stopped at most one event
+            // after stop() is called
             //
             bool isContinue() const;
-            bool isFileEmpty() const;
 
-            // hasAnalyzer/Controller are only called when thread is running.
-            // Therefore lock is safe for use
+            // hasAnalyzer/Controller/Tasks are only called when thread is
+            // running. Therefore lock is safe for use
             //
             bool hasAnalyzer() const;
             bool hasController() const;
+            bool hasTasks() const;
+            bool hasEvents() const;
+
+            // Wait for the next job. False is returned on shutdown
+            //
+            bool waitForJob();
+
+            // Go back to idle and notify controller
+            //
+            void finishJob();
+
+            // Set thread affinity to the CPUs
+            //
+            void pinThread();
+
+            // Reset analyzer of the previous job or clone the master
+            //
+            void prepareAnalyzer();
 
-            // Create input file reader and reset input_file
+            // Create input file reader
             //
-            ReaderPtr createReader();
+            ReaderPtr createReader(const InputChunk &);
 
-            // Create input file reader and apply analyzer to events
+            // Open input file chunk
             //
-            void processFile();
+            RecordReaderPtr createRecordReader(const InputChunk &);
+
+            // Map input file or its chunk
+            //
+            MappedReaderPtr createMappedReader(const InputChunk &);
+
+            // Create input file reader and apply analyzer to events. False
+            // is returned if input can not be opened
+            //
+            void process(const InputChunk &);
+            bool processInput(const InputChunk &);
+
+            template<class T>
+                bool processReader(const boost::shared_ptr<T> &);
 
-            // Wait for new instructions from Controller
+            // Apply analyzer to events from the ring
             //
-            void waitForInstructions();
+            void processEvents();
+
+            // Pass clone of the results and processed inputs to the
+            // controller for the checkpoint
+            //
+            void publishSnapshot(const bool &is_done);
+
+            // Merge analyzers of other finished threads into own one until
+            // there is no partner left
+            //
+            void reduce();
+
+            // Inform Controller that there are no more tasks left and
+            // analyzer is ready to be merged
+            //
+            void notifyController();
 
             core::Thread *_thread;
             ThreadController *_controller;
 
-            bool _continue;
+            boost::atomic<bool> _continue;
 
+            bool _has_job;
+            bool _shutdown;
+
+            AnalyzerPtr _master;
+            AnalyzerPtr _prototype;
             AnalyzerPtr _analyzer;
-            std::string _file_name;
+            boost::weak_ptr<Analyzer> _cloned_from;
+            bool _is_clone_reused;
 
-            uint32_t _events_processed;
-            uint32_t _total_events_size;
+            InputTasksPtr _tasks;
+            uint32_t _worker;
+
+            EventRingPtr _events;
+
+            bool _use_mapped_reader;
+            bool _use_uring_reader;
+
+            StagingCachePtr _staging;
+
+            EventRecycler _recycler;
+
+            std::vector<int> _cpus;
+
+            boost::atomic<uint32_t> _events_processed;
+            boost::atomic<uint64_t> _total_events_size;
+            boost::atomic<uint32_t> _inputs_processed;
+
+            // Inputs processed by the job and the last checkpoint snapshot
+            // generation results were published for
+            //
+            std::vector<InputChunk> _processed_inputs;
+            uint32_t _snapshot_generation;
+
+            mutable boost::mutex _input_mutex; // see ReaderOperation
+            std::string _input;
     };
 
     class ThreadController
@@ -146,35 +583,270 @@ namespace bsm
 
             void use(const AnalyzerPtr &analyzer);
 
-            // Schedule file for processing
+            // Schedule file for processing. Standard input ("-") and
+            // named pipes are read as streams of Events by a reader thread
+            // (see StreamReader)
             //
             void push(const std::string &file_name);
 
+            // Number of analyzer threads. Threads may oversubscribe cores,
+            // e.g. for I/O bound jobs. Number of cores is used with zero
+            // (default)
+            //
+            void setMaxThreads(const uint32_t &threads);
+
+            // Pin analyzer threads to the allowed CPUs, one thread per CPU
+            // in turn. Analyzer clones are allocated by the pinned threads
+            //
+            void setPinThreads(const bool &pin);
+
+            // Split input files into chunks of N events each. Any idle
+            // thread takes the next chunk: one file may be processed by
+            // several threads at once. Chunks are turned off with zero
+            // (default)
+            //
+            void setEventsPerChunk(const uint32_t &events);
+
+            // Decode input events in N dedicated reader threads and pass
+            // them to the analyzer threads through the bounded ring.
+            // Analyzer threads never wait for I/O unless the ring is
+            // empty. Events are read by the analyzer threads with zero
+            // (default)
+            //
+            void setReaderThreads(const uint32_t &readers);
+
+            // Write checkpoint every N processed inputs (files or chunks):
+            // processed inputs and merged analyzer results. Analyzer
+            // threads publish clones of their results at the next input
+            // boundary and go on: controller merges the clones and writes
+            // the checkpoint. Worker processes and pipelined mode process
+            // inputs in rounds of N inputs instead and save each round.
+            // Interrupted inputs are not saved. Analyzer should support
+            // save/load
+            //
+            void setCheckpoint(const std::string &file_name,
+                    const uint32_t &inputs);
+
+            // Skip inputs found in the checkpoint and add checkpoint
+            // results to the analyzer
+            //
+            void setResume(const bool &resume);
+
+            // Fork N worker processes instead of analyzer threads: each
+            // process runs single analyzer thread over own share of the
+            // inputs. Results are passed back through the shared memory
+            // and merged by the controller. Use with analyzers that are
+            // not thread-safe. Workers are forked once at the job start,
+            // before any thread is started, and get inputs of each round
+            // through the pipe. Job is not run if analyzer does not
+            // support save/load. Threads are used with zero (default)
+            //
+            void setProcesses(const uint32_t &processes);
+
+            // Write job progress to the JSON file every N seconds. Stats
+            // are turned off with empty file name (default)
+            //
+            void setStats(const std::string &file_name,
+                    const uint32_t &interval);
+
+            // Inputs are scheduled largest-first by their size. Processing
+            // time of the inputs is saved to the history file and used by
+            // the next jobs instead of size
+            //
+            void setHistory(const std::string &file_name);
+
+            // Job progress and ETA are measured in events of the inputs
+            // found in the dataset manifest. Inputs without history are
+            // scheduled by their number of events instead of size
+            //
+            void setManifest(const std::string &file_name);
+
+            // Load next N inputs of each worker into the page cache while
+            // workers are busy. At most given number of megabytes are
+            // loaded ahead. Readahead is turned off with zero (default)
+            //
+            void setReadahead(const uint32_t &inputs,
+                    const uint32_t &megabytes);
+
+            // Read inputs from the memory mapped files
+            //
+            void setMappedReader(const bool &use);
+
+            // Keep several large reads of each input in flight with
+            // io_uring (Linux): analyzer does not wait for every read.
+            // Regular reads are used if kernel does not support io_uring
+            //
+            void setUringReader(const bool &use);
+
+            // Release memory of the Event decoded by analyzer thread every
+            // N events. Event is reused between records otherwise. Memory
+            // is never released with zero (default)
+            //
+            void setEventReset(const uint32_t &events);
+
+            // Copy inputs into the local cache directory and read the
+            // copies. Copies are shared by the jobs on the node: the least
+            // recently used ones are removed once cache reaches the size
+            //
+            void setStaging(const std::string &directory,
+                    const uint32_t &megabytes);
+
             // Start processing scheduled files
             //
             void start();
 
             void threadIsWaiting(core::Thread *);
 
+            // Pairwise reduction of the analyzers: thread either gets the
+            // analyzer left by another finished thread to merge with (true
+            // is returned) or leaves own analyzer for the next thread.
+            // Merges run in parallel on the worker threads and only the
+            // last analyzer is merged into the master one
+            //
+            bool reduce(const AnalyzerPtr &analyzer, AnalyzerPtr &partner);
+
+            // Checkpoint snapshots are taken while analyzer threads run:
+            // thread counts processed inputs and publishes a clone of its
+            // results together with the inputs it has processed once the
+            // snapshot generation changes. Thread that ran out of inputs
+            // publishes the final results. Snapshot is written by the
+            // controller when every thread has published the generation
+            //
+            bool hasSnapshots() const;
+            uint32_t snapshotGeneration() const;
+
+            void addProcessedInput();
+            void addSnapshot(const uint32_t &worker,
+                    const AnalyzerPtr &results,
+                    const std::vector<InputChunk> &inputs,
+                    const bool &is_done);
+
+            // Analyzer thread reports processing time of the input
+            //
+            void addRuntime(const InputChunk &input,
+                    const uint64_t &bytes,
+                    const double &seconds);
+
             void quit();
             void info();
 
+            JobStats stats() const;
+
         private:
+            typedef std::queue<InputChunk> InputFiles; // FIFO
+            typedef std::vector<InputFiles> InputShares;
+
             // Test if any input files left for processing
             //
             bool hasInputFiles() const;
             bool hasAnalyzer() const;
 
+            bool isCancelled() const;
+
+            // Load checkpoint and drop processed inputs if job is resumed.
+            // False is returned if job can not be resumed
+            //
+            bool openCheckpoint();
+
+            // Add inputs merged into the master to the checkpoint and
+            // save it
+            //
+            void saveCheckpoint(const InputFiles &merged);
+
+            // Move next round inputs from the pending ones. False is
+            // returned if there is nothing left
+            //
+            bool nextRound(InputFiles &round);
+
+            // Process round inputs with the pool threads and merge results
+            // into the master analyzer. Inputs whose results are merged
+            // are returned
+            //
+            void processRound(InputFiles &merged);
+
+            // Merge published results of the analyzer threads on top of
+            // the master analyzer and write them with their inputs to the
+            // checkpoint. Snapshot is written only if it is ready unless
+            // forced
+            //
+            void writeSnapshot(const bool &force = false);
+
+            // Fork worker processes for the pending inputs. Controller
+            // should not run any thread: idle pool threads are stopped
+            //
+            bool startProcesses();
+
+            // Close command pipes and wait for the workers to leave
+            //
+            void stopProcesses();
+
+            // Send round inputs to the worker processes and merge their
+            // results into the master analyzer. Share of the failed worker
+            // is sent to the remaining ones
+            //
+            void processRoundInWorkers(InputFiles &merged);
+
+            // Report inputs that could not be processed by any worker
+            //
+            void failShare(const InputFiles &);
+
+            // Worker process body: process inputs of each round received
+            // from the command pipe until it is closed
+            //
+            bool runWorker(const int &commands, const int &results,
+                    void *slot);
+
+            // Apply prototype clone to the inputs and write results into
+            // the shared memory slot
+            //
+            bool runProcess(const InputFiles &inputs, void *slot);
+
+            // Shut down and join idle pool threads
+            //
+            void stopPool();
+
             // Return maximum number of threads to be created:
-            //  min(CORES, Input FILES)
+            //  min(CORES, Input FILES or CHUNKS)
             //
             uint32_t countMaxThreads();
 
-            // Create new thread, instruct and start
+            // Return number of reader threads to be created:
+            //  min(READERS, Input FILES or CHUNKS)
             //
-            void addThread();
+            uint32_t countReaderThreads();
 
-            void instruct(AnalyzerOperation *operation);
+            // Replace scheduled files with chunks. Record offsets are taken
+            // from the index sidecar or found with file pre-scan
+            //
+            void splitInputs();
+
+            // Estimate cost of the scheduled inputs and sort them: the most
+            // expensive inputs go first
+            //
+            void sortInputs();
+
+            // Longest processing time first: move scheduled inputs to the
+            // least loaded worker share one by one. Shares are ordered
+            // largest-first
+            //
+            InputShares balanceInputs(const uint32_t &workers);
+
+            // Distribute scheduled inputs among workers' task deques
+            //
+            void scheduleTasks(const uint32_t &workers);
+
+            // Give job to the worker thread from the pool. Thread is created
+            // if pool is too small
+            //
+            void addThread(const uint32_t &worker);
+
+            // Create reader thread and start
+            //
+            void addReaderThread(const uint32_t &worker);
+
+            // Wait for reader threads to finish
+            //
+            void stopReaderThreads();
 
             void run();
             void wait();
@@ -187,31 +859,121 @@ namespace bsm
             void startKeyboardThread();
             void stopKeyboardThread();
 
+            void startStatsThread();
+            void stopStatsThread();
+
+            void startReadaheadThread();
+            void stopReadaheadThread();
+
             // Typedefs
             //
-            typedef std::queue<std::string> InputFiles; // FIFO
-
             typedef boost::shared_ptr<core::Thread> ThreadPtr;
 
+            typedef std::vector<ThreadPtr> ThreadPool;
             typedef std::map<core::Thread *, ThreadPtr> Threads;
             typedef std::queue<core::Thread *> ThreadsFIFO;
 
             typedef boost::shared_ptr<ThreadsFIFO> ThreadsFIFOPtr;
 
+            typedef std::vector<int> CPUs;
+
+            // Worker process and controller ends of its pipes
+            //
+            struct WorkerProcess
+            {
+                pid_t pid;
+                uint32_t slot;  // shared memory slot
+
+                int commands;   // round inputs are written
+                int results;    // round status is read
+            };
+
+            typedef std::vector<WorkerProcess> Processes;
+
+            // Results of the inputs processed by the analyzer thread
+            //
+            struct Snapshot
+            {
+                Snapshot();
+
+                AnalyzerPtr results;
+                std::vector<InputChunk> inputs;
+
+                uint32_t generation;
+                bool is_done;
+            };
+
+            typedef std::vector<Snapshot> Snapshots;
+
             // Properties
             //
-            const uint32_t _max_threads;
+            uint32_t _max_threads;
+            uint32_t _events_per_chunk;
+            uint32_t _reader_threads;
+            uint32_t _processes;
 
-            core::ConditionPtr _condition;
-            boost::shared_ptr<InputFiles> _input_files;
+            std::string _stats_file;
+            uint32_t _stats_interval;
+
+            std::string _history_file;
+            boost::shared_ptr<RuntimeHistory> _history;
+
+            std::string _manifest_file;
+            boost::shared_ptr<DatasetManifest> _manifest;
+            uint64_t _events_expected;
 
-            uint32_t _processed_files;
+            uint32_t _readahead_inputs;
+            uint64_t _readahead_bytes;
 
-            Threads _threads;
+            bool _use_mapped_reader;
+            bool _use_uring_reader;
+            uint32_t _event_reset;
+
+            std::string _staging_directory;
+            uint64_t _staging_bytes;
+            StagingCachePtr _staging;
+
+            CPUs _cpus; // empty if threads are not pinned
+
+            // Process affinity at the controller start: threads that are
+            // not pinned run on any of these CPUs
+            //
+            CPUs _allowed_cpus;
+
+            std::string _checkpoint_file;
+            uint32_t _checkpoint_inputs;
+            bool _resume;
+            boost::shared_ptr<Checkpoint> _checkpoint;
+
+            Snapshots _snapshots; // one per analyzer thread
+            boost::atomic<uint32_t> _snapshot_generation;
+            uint32_t _snapshot_written;
+            uint32_t _inputs_unsaved;
+            bool _is_snapshot_ready;
+
+            core::ConditionPtr _condition;
+            boost::shared_ptr<InputFiles> _input_files; // current round
+            boost::shared_ptr<InputFiles> _pending_files;
+            InputTasksPtr _tasks;
+            EventRingPtr _events;
+
+            ThreadPool _pool; // analyzer threads are kept between jobs
+            Threads _threads; // threads running the job
+            Threads _readers;
             ThreadsFIFOPtr _threads_waiting;
             ThreadPtr _keyboard_thread;
+            ThreadPtr _stats_thread;
+            ThreadPtr _readahead_thread;
+            Processes _children; // worker processes of the job
+            void *_process_memory; // shared memory slots of the workers
+            uint32_t _process_slots;
 
             AnalyzerPtr _analyzer;
+            AnalyzerPtr _prototype; // analyzer state at the job start
+            AnalyzerPtr _reduced_analyzer;
+
+            bool _is_cancelled;
+            bool _use_processes;
 
             class Summary;
 
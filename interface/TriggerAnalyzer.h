@@ -30,6 +30,15 @@ namespace bsm
             virtual void onFileOpen(const std::string &filename, const Input *);
             virtual void process(const Event *);
 
+            virtual bool reset();
+
+            virtual bool save(std::ostream &) const;
+            virtual bool load(std::istream &);
+
+            // Only triggers are used
+            //
+            virtual EventFields fields() const;
+
             // Object interface
             //
             virtual uint32_t id() const;
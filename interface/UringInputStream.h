@@ -0,0 +1,125 @@
+// Uring Input Stream
+//
+// Read part of the file with asynchronous io_uring reads (Linux). Several
+// large aligned reads are kept in flight: the parser works on one buffer
+// while the kernel fills the next ones. Reading thread waits only if the
+// device is slower than parsing. No extra threads are started.
+//
+// Stream is a protobuf ZeroCopyInputStream and replaces FileInputStream
+// in RecordReader. Use isSupported() to check if kernel allows io_uring
+// reads.
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_URING_INPUT_STREAM
+#define BSM_URING_INPUT_STREAM
+
+#include <vector>
+
+#include <google/protobuf/io/zero_copy_stream.h>
+
+namespace bsm
+{
+    class UringInputStream : public google::protobuf::io::ZeroCopyInputStream
+    {
+        public:
+            // Bytes in [offset, limit) are read. Stream reads up to the end
+            // of file with zero limit
+            //
+            UringInputStream(const int &fd,
+                    const uint64_t &offset,
+                    const uint64_t &limit = 0,
+                    const uint32_t &buffers = 4,
+                    const uint32_t &buffer_size = 1024 * 1024);
+
+            // Reads in flight are waited for
+            //
+            virtual ~UringInputStream();
+
+            static bool isSupported();
+
+            // Ring could not be set up or read failed
+            //
+            bool hadError() const;
+
+            // ZeroCopyInputStream interface
+            //
+            virtual bool Next(const void **data, int *size);
+            virtual void BackUp(int count);
+            virtual bool Skip(int count);
+            virtual google::protobuf::int64 ByteCount() const;
+
+        private:
+            // Prevent copying
+            //
+            UringInputStream(const UringInputStream &);
+            UringInputStream &operator =(const UringInputStream &);
+
+            struct Buffer
+            {
+                Buffer();
+
+                char *data;
+                uint32_t capacity;
+
+                uint64_t offset;
+                uint32_t requested;
+                int32_t result; // bytes read or -errno
+
+                int state;
+            };
+
+            typedef std::vector<Buffer> Buffers;
+
+            bool setup(const uint32_t &entries);
+            void release();
+
+            // Queue read of the next part of the file into the buffer
+            //
+            bool submit(Buffer &);
+
+            // Wait for at least one read to complete
+            //
+            bool complete();
+
+            // Short and failed reads are continued synchronously: buffers
+            // follow each other in the file
+            //
+            bool finish(Buffer &);
+
+            int _fd;
+            uint64_t _offset;   // of the next read
+            uint64_t _limit;
+
+            Buffers _buffers;
+            uint32_t _next;     // buffer to be returned by Next()
+            uint32_t _in_flight;
+
+            bool _is_current;   // buffer before next is held by the caller
+            int _backed_up;
+
+            google::protobuf::int64 _byte_count;
+            bool _had_error;
+
+            // Ring
+            //
+            int _ring_fd;
+
+            void *_sq_ring;
+            void *_cq_ring;
+            void *_sqes;
+            size_t _sq_ring_size;
+            size_t _cq_ring_size;
+            size_t _sqes_size;
+
+            unsigned *_sq_tail;
+            unsigned *_sq_mask;
+            unsigned *_sq_array;
+            unsigned *_cq_head;
+            unsigned *_cq_tail;
+            unsigned *_cq_mask;
+            void *_cqes;
+    };
+}
+
+#endif
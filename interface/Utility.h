@@ -8,8 +8,10 @@
 #ifndef BSM_UTILITY
 #define BSM_UTILITY
 
+#include <istream>
 #include <ostream>
 #include <functional>
+#include <string>
 
 class TLorentzVector;
 
@@ -30,6 +32,19 @@ namespace bsm
         };
 
         void set(TLorentzVector *root_p4, const LorentzVector *bsm_p4);
+
+        // Checkpoint helpers: values are written as raw bytes, strings
+        // are prefixed with their size. False is returned if value can
+        // not be read
+        //
+        template<typename T>
+            void write(std::ostream &, const T &);
+
+        template<typename T>
+            bool read(std::istream &, T &);
+
+        void write(std::ostream &, const std::string &);
+        bool read(std::istream &, std::string &);
     }
 
     template<typename T>
@@ -51,6 +66,18 @@ namespace bsm
         std::ostream &operator <<(std::ostream &, const std::logical_and<T> &);
 }
 
+template<typename T>
+    void bsm::utility::write(std::ostream &out, const T &value)
+{
+    out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+template<typename T>
+    bool bsm::utility::read(std::istream &in, T &value)
+{
+    return !in.read(reinterpret_cast<char *>(&value), sizeof(value)).fail();
+}
+
 template<typename T>
     std::ostream &bsm::operator <<(std::ostream &out, const std::equal_to<T> &)
 {
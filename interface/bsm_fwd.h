@@ -20,16 +20,32 @@ namespace bsm
         class NeutrinoReconstruct;
     }
 
+    class ColumnarReader;
+    class ColumnarWriter;
+    struct EventColumns;
+    class EventView;
+    class ElectronView;
+    class JetView;
+    class MuonView;
+    class PrimaryVertexView;
+
+    class SkimWriter;
+
     class Counter;
     class Cut;
+    class CutChainCounters;
     template<class Compare> class Comparator;
     class LockCounterOnUpdate;
+    class SelectionBatch;
 
     class ElectronSelector;
     class JetSelector;
     class MultiplicityCutflow;
     class MuonSelector;
     class PrimaryVertexSelector;
+    class StaticElectronSelector;
+    class StaticJetSelector;
+    class StaticMuonSelector;
     class WJetSelector;
     class LockSelectorEventCounterOnUpdate;
 
@@ -0,0 +1,30 @@
+// Analyzer base class
+//
+// Default implementation of the optional Analyzer methods
+//
+// Copyright 2011, All rights reserved
+
+#include "interface/Analyzer.h"
+
+using bsm::Analyzer;
+using bsm::EventFields;
+
+bool Analyzer::reset()
+{
+    return false;
+}
+
+bool Analyzer::save(std::ostream &) const
+{
+    return false;
+}
+
+bool Analyzer::load(std::istream &)
+{
+    return false;
+}
+
+EventFields Analyzer::fields() const
+{
+    return EventFields();
+}
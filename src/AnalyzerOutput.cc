@@ -0,0 +1,108 @@
+// Analyzer Output
+//
+// Canvases and files of the analyzers results
+//
+// Copyright 2011, All rights reserved
+
+#include <TCanvas.h>
+#include <TH1.h>
+
+#include "bsm_stat/interface/bsm_stat_fwd.h"
+#include "bsm_stat/interface/H1.h"
+#include "bsm_stat/interface/Utility.h"
+
+#include "interface/AnalyzerOutput.h"
+#include "interface/Monitor.h"
+#include "interface/MonitorAnalyzer.h"
+#include "interface/MonitorCanvas.h"
+#include "interface/MttbarAnalyzer.h"
+#include "interface/WtagMassAnalyzer.h"
+
+using boost::shared_ptr;
+
+using bsm::AnalyzerOutput;
+using bsm::DeltaCanvas;
+using bsm::ElectronCanvas;
+using bsm::JetCanvas;
+using bsm::LorentzVectorCanvas;
+using bsm::MissingEnergyCanvas;
+using bsm::MuonCanvas;
+using bsm::PrimaryVertexCanvas;
+using bsm::stat::TH1Ptr;
+
+AnalyzerOutput::AnalyzerOutput()
+{
+}
+
+AnalyzerOutput::~AnalyzerOutput()
+{
+}
+
+void AnalyzerOutput::draw(const MonitorAnalyzer &analyzer)
+{
+    keep(new JetCanvas("Jets"))->draw(*analyzer.jets());
+
+    keep(new MuonCanvas("Particle Flow Muons"))->draw(*analyzer.pfMuons());
+    keep(new MuonCanvas("Reco Muons"))->draw(*analyzer.recoMuons());
+
+    keep(new ElectronCanvas("Particle Flow Electrons"))
+        ->draw(*analyzer.pfElectrons());
+    keep(new ElectronCanvas("GSF Electrons"))
+        ->draw(*analyzer.gsfElectrons());
+
+    keep(new PrimaryVertexCanvas("Primary Vertex"))
+        ->draw(*analyzer.primaryVertices());
+
+    keep(new MissingEnergyCanvas("Missing Energy"))
+        ->draw(*analyzer.missingEnergy());
+}
+
+void AnalyzerOutput::draw(const MttbarAnalyzer &analyzer)
+{
+    TH1Ptr mttbar = convert(*analyzer.mttbar());
+    mttbar->SetName("mttbar");
+    mttbar->GetXaxis()->SetTitle("m_{t#bar{t}} [GeV/c^{2}]");
+
+    keep(new TCanvas("mttbar_canvas", "Mttbar", 640, 480));
+    mttbar->Draw();
+
+    mttbar->SaveAs("mttbar.root");
+
+    _objects.push_back(mttbar);
+
+    keep(new LorentzVectorCanvas("Selected PF Electron"))
+        ->draw(*analyzer.electronMonitor());
+
+    keep(new LorentzVectorCanvas("W-tagged Jet"))
+        ->draw(*analyzer.wjetMonitor());
+
+    keep(new LorentzVectorCanvas("Leptonic Top"))
+        ->draw(*analyzer.ltopMonitor());
+
+    keep(new LorentzVectorCanvas("Hadronic Top"))
+        ->draw(*analyzer.htopMonitor());
+
+    keep(new DeltaCanvas("Delta between Leptonic and Hadronic tops"))
+        ->draw(*analyzer.topDeltaMonitor());
+}
+
+void AnalyzerOutput::draw(const WtagMassAnalyzer &analyzer)
+{
+    TH1Ptr mttbar = convert(*analyzer.mttbar());
+    mttbar->GetXaxis()->SetTitle("m_{t#bar{t}} [GeV/c^{2}]");
+
+    keep(new TCanvas("wtag_mttbar_canvas", "W-tag Mttbar", 640, 480));
+    mttbar->Draw();
+
+    _objects.push_back(mttbar);
+}
+
+// Private
+//
+template<class T>
+    T *AnalyzerOutput::keep(T *object)
+{
+    _objects.push_back(shared_ptr<T>(object));
+
+    return object;
+}
@@ -0,0 +1,160 @@
+// Checkpoint
+//
+// List of processed inputs and merged analyzer results
+//
+// Copyright 2011, All rights reserved
+
+#include <sstream>
+
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+
+#include <google/protobuf/io/coded_stream.h>
+
+#include "interface/Analyzer.h"
+#include "interface/Checkpoint.h"
+
+using std::istringstream;
+using std::make_pair;
+using std::ostringstream;
+using std::string;
+
+using bsm::Checkpoint;
+using bsm::InputChunk;
+
+// Checkpoint file format:
+//
+//  [fixed32]   magic
+//  [fixed32]   version
+//  [fixed32]   events per chunk
+//  [fixed32]   number of processed inputs: N
+//  N x {
+//      [varint32]  file name size
+//      [bytes]     file name
+//      [fixed64]   chunk begin
+//      [fixed64]   chunk end
+//  }
+//  [varint32]  analyzer results size
+//  [bytes]     analyzer results
+//
+static const uint32_t CHECKPOINT_MAGIC = 0x42534d43; // BSMC
+static const uint32_t CHECKPOINT_VERSION = 1;
+
+Checkpoint::Checkpoint(const string &filename):
+    _file(filename, CHECKPOINT_MAGIC, CHECKPOINT_VERSION),
+    _events_per_chunk(0)
+{
+}
+
+string Checkpoint::filename() const
+{
+    return _file.filename();
+}
+
+uint32_t Checkpoint::eventsPerChunk() const
+{
+    return _events_per_chunk;
+}
+
+void Checkpoint::setEventsPerChunk(const uint32_t &events)
+{
+    _events_per_chunk = events;
+}
+
+void Checkpoint::addInput(const InputChunk &input)
+{
+    _inputs.insert(key(input));
+}
+
+bool Checkpoint::isProcessed(const InputChunk &input) const
+{
+    return _inputs.end() != _inputs.find(key(input));
+}
+
+uint32_t Checkpoint::size() const
+{
+    return _inputs.size();
+}
+
+bool Checkpoint::load(Analyzer &analyzer)
+{
+    _inputs.clear();
+
+    const bool result = _file.load(boost::bind(&Checkpoint::readBody, this,
+                _1, boost::ref(analyzer)));
+
+    if (!result)
+        _inputs.clear();
+
+    return result;
+}
+
+bool Checkpoint::save(const Analyzer &analyzer) const
+{
+    ostringstream out;
+    if (!analyzer.save(out))
+        return false;
+
+    // Previous checkpoint is replaced only with the complete one
+    //
+    return _file.save(boost::bind(&Checkpoint::writeBody, this,
+                _1, out.str()));
+}
+
+// Private
+//
+Checkpoint::Input Checkpoint::key(const InputChunk &input) const
+{
+    return make_pair(input.file_name, make_pair(input.begin, input.end));
+}
+
+bool Checkpoint::readBody(CodedInputStream &coded_in, Analyzer &analyzer)
+{
+    uint32_t inputs;
+    if (!coded_in.ReadLittleEndian32(&_events_per_chunk)
+            || !coded_in.ReadLittleEndian32(&inputs))
+        return false;
+
+    uint32_t size;
+    string file_name;
+    uint64_t begin;
+    uint64_t end;
+    for(; inputs > _inputs.size()
+            && coded_in.ReadVarint32(&size)
+            && coded_in.ReadString(&file_name, size)
+            && coded_in.ReadLittleEndian64(&begin)
+            && coded_in.ReadLittleEndian64(&end); )
+    {
+        _inputs.insert(make_pair(file_name, make_pair(begin, end)));
+    }
+
+    string results;
+    if (inputs != _inputs.size()
+            || !coded_in.ReadVarint32(&size)
+            || !coded_in.ReadString(&results, size))
+        return false;
+
+    istringstream in(results);
+
+    return analyzer.load(in);
+}
+
+void Checkpoint::writeBody(CodedOutputStream &coded_out,
+        const string &results) const
+{
+    coded_out.WriteLittleEndian32(_events_per_chunk);
+    coded_out.WriteLittleEndian32(_inputs.size());
+
+    for(Inputs::const_iterator input = _inputs.begin();
+            _inputs.end() != input;
+            ++input)
+    {
+        coded_out.WriteVarint32(input->first.size());
+        coded_out.WriteString(input->first);
+        coded_out.WriteLittleEndian64(input->second.first);
+        coded_out.WriteLittleEndian64(input->second.second);
+    }
+
+    coded_out.WriteVarint32(results.size());
+    coded_out.WriteString(results);
+}
@@ -0,0 +1,440 @@
+// Columnar File
+//
+// Cache of the Event fields in the columnar format
+//
+// Copyright 2011, All rights reserved
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+
+#include "interface/ColumnarFile.h"
+
+using std::string;
+using std::vector;
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::io::FileInputStream;
+using google::protobuf::io::FileOutputStream;
+
+using bsm::ColumnarReader;
+using bsm::ColumnarWriter;
+using bsm::EventColumns;
+
+// Columnar file format:
+//
+//  [fixed32]   magic
+//  [fixed32]   version
+//  [fixed32]   number of columns per block: C
+//  blocks {
+//      [fixed32]   number of events
+//      C x {
+//          [fixed32]   number of elements: N
+//          [bytes]     N elements in the native byte order
+//      }
+//  }
+//
+// Columns follow the EventColumns::visit order. Version changes whenever
+// columns are added or changed
+//
+static const uint32_t COLUMNAR_MAGIC = 0x42534d53; // BSMS
+static const uint32_t COLUMNAR_VERSION = 1;
+
+// Block is written early once its columns reach the size: coded stream
+// refuses to read more than 64 MB at once
+//
+static const uint64_t COLUMNAR_MAX_BLOCK_BYTES = 32 * 1024 * 1024;
+
+// Count columns
+//
+class ColumnCounter
+{
+    public:
+        ColumnCounter():
+            columns(0)
+        {
+        }
+
+        template<typename T>
+            void operator()(const vector<T> &)
+            {
+                ++columns;
+            }
+
+        uint32_t columns;
+};
+
+// Count bytes of the columns
+//
+class ColumnBytes
+{
+    public:
+        ColumnBytes():
+            bytes(0)
+        {
+        }
+
+        template<typename T>
+            void operator()(const vector<T> &column)
+            {
+                bytes += column.size() * sizeof(T);
+            }
+
+        uint64_t bytes;
+};
+
+// Write each column as a raw array
+//
+class ColumnWriter
+{
+    public:
+        ColumnWriter(CodedOutputStream &out):
+            _out(out)
+        {
+        }
+
+        template<typename T>
+            void operator()(const vector<T> &column)
+            {
+                _out.WriteLittleEndian32(column.size());
+                if (!column.empty())
+                    _out.WriteRaw(&*column.begin(), column.size() * sizeof(T));
+            }
+
+    private:
+        CodedOutputStream &_out;
+};
+
+// Read each column straight into the vector memory
+//
+class ColumnReader
+{
+    public:
+        ColumnReader(CodedInputStream &in):
+            _in(in),
+            _is_good(true)
+        {
+        }
+
+        template<typename T>
+            void operator()(vector<T> &column)
+            {
+                uint32_t size;
+                if (!_is_good
+                        || !_in.ReadLittleEndian32(&size)
+                        || COLUMNAR_MAX_BLOCK_BYTES < size * sizeof(T))
+                {
+                    _is_good = false;
+
+                    return;
+                }
+
+                column.resize(size);
+                if (size)
+                    _is_good = _in.ReadRaw(&*column.begin(), size * sizeof(T));
+            }
+
+        bool isGood() const
+        {
+            return _is_good;
+        }
+
+    private:
+        CodedInputStream &_in;
+        bool _is_good;
+};
+
+// Offsets of the collection should start at zero and never decrease:
+// views do not check bounds
+//
+static bool isConsistent(const EventColumns::Offsets &offsets,
+        const uint32_t &events)
+{
+    if (events + 1 != offsets.size()
+            || offsets.front())
+        return false;
+
+    for(uint32_t event = 0; events > event; ++event)
+    {
+        if (offsets[event] > offsets[event + 1])
+            return false;
+    }
+
+    return true;
+}
+
+// Every column of the collection keeps one value per object
+//
+template<typename T>
+    bool hasObjects(const vector<T> &column,
+            const EventColumns::Offsets &offsets)
+{
+    return offsets.back() == column.size();
+}
+
+static bool hasObjects(const EventColumns::P4s &p4s,
+        const EventColumns::Offsets &offsets)
+{
+    return hasObjects(p4s.e, offsets)
+        && hasObjects(p4s.px, offsets)
+        && hasObjects(p4s.py, offsets)
+        && hasObjects(p4s.pz, offsets);
+}
+
+static bool isConsistent(const EventColumns &columns, const uint32_t &events)
+{
+    const EventColumns::PrimaryVertices &vertices = columns.primary_vertices;
+    const EventColumns::Jets &jets = columns.jets;
+    const EventColumns::Electrons &electrons = columns.pf_electrons;
+    const EventColumns::Muons &muons = columns.pf_muons;
+    const EventColumns::Triggers &hlts = columns.hlts;
+
+    return events == columns.run.size()
+        && events == columns.lumi.size()
+        && events == columns.event.size()
+
+        && isConsistent(vertices.offsets, events)
+        && hasObjects(vertices.z, vertices.offsets)
+        && hasObjects(vertices.has_extra, vertices.offsets)
+        && hasObjects(vertices.ndof, vertices.offsets)
+        && hasObjects(vertices.rho, vertices.offsets)
+
+        && isConsistent(jets.offsets, events)
+        && hasObjects(jets.p4, jets.offsets)
+
+        && isConsistent(electrons.offsets, events)
+        && hasObjects(electrons.p4, electrons.offsets)
+        && hasObjects(electrons.vertex_z, electrons.offsets)
+
+        && isConsistent(muons.offsets, events)
+        && hasObjects(muons.p4, muons.offsets)
+        && hasObjects(muons.vertex_z, muons.offsets)
+        && hasObjects(muons.has_extra, muons.offsets)
+        && hasObjects(muons.is_global, muons.offsets)
+        && hasObjects(muons.is_tracker, muons.offsets)
+        && hasObjects(muons.number_of_matches, muons.offsets)
+        && hasObjects(muons.pixel_hits, muons.offsets)
+        && hasObjects(muons.d0_bsp, muons.offsets)
+        && hasObjects(muons.global_track_hits, muons.offsets)
+        && hasObjects(muons.global_track_normalized_chi2, muons.offsets)
+        && hasObjects(muons.inner_track_hits, muons.offsets)
+
+        && isConsistent(hlts.offsets, events)
+        && hasObjects(hlts.hash, hlts.offsets)
+        && hasObjects(hlts.pass, hlts.offsets);
+}
+
+// Columnar Writer
+//
+ColumnarWriter::ColumnarWriter(const string &filename,
+        const uint32_t &block_size):
+    _filename(filename),
+    _block_size(block_size ? block_size : 1),
+    _fd(-1),
+    _is_good(false),
+    _events(0),
+    _blocks(0)
+{
+}
+
+ColumnarWriter::~ColumnarWriter()
+{
+    close();
+}
+
+void ColumnarWriter::open()
+{
+    if (isOpen())
+        return;
+
+    _fd = ::open(_filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (0 > _fd)
+        return;
+
+    _raw_out.reset(new FileOutputStream(_fd));
+
+    ColumnCounter counter;
+    _columns.visit(counter);
+
+    CodedOutputStream coded_out(_raw_out.get());
+
+    coded_out.WriteLittleEndian32(COLUMNAR_MAGIC);
+    coded_out.WriteLittleEndian32(COLUMNAR_VERSION);
+    coded_out.WriteLittleEndian32(counter.columns);
+
+    _is_good = !coded_out.HadError();
+}
+
+bool ColumnarWriter::close()
+{
+    if (!isOpen())
+        return _is_good;
+
+    flush();
+
+    _is_good = _raw_out->Close() && _is_good;
+    _raw_out.reset();
+
+    _fd = -1;
+
+    return _is_good;
+}
+
+bool ColumnarWriter::isOpen() const
+{
+    return 0 <= _fd;
+}
+
+string ColumnarWriter::filename() const
+{
+    return _filename;
+}
+
+bool ColumnarWriter::write(const Event &event)
+{
+    if (!isOpen()
+            || !_is_good)
+        return false;
+
+    _columns.add(event);
+    ++_events;
+
+    ColumnBytes counter;
+    _columns.visit(counter);
+
+    return (_block_size > _columns.size()
+            && COLUMNAR_MAX_BLOCK_BYTES > counter.bytes)
+        || flush();
+}
+
+bool ColumnarWriter::flush()
+{
+    if (!isOpen()
+            || !_is_good)
+        return false;
+
+    if (!_columns.size())
+        return true;
+
+    {
+        CodedOutputStream coded_out(_raw_out.get());
+
+        coded_out.WriteLittleEndian32(_columns.size());
+
+        ColumnWriter writer(coded_out);
+        _columns.visit(writer);
+
+        _is_good = !coded_out.HadError();
+    }
+
+    _columns.clear();
+    ++_blocks;
+
+    return _is_good;
+}
+
+uint64_t ColumnarWriter::events() const
+{
+    return _events;
+}
+
+uint32_t ColumnarWriter::blocks() const
+{
+    return _blocks;
+}
+
+
+
+// Columnar Reader
+//
+ColumnarReader::ColumnarReader(const string &filename):
+    _filename(filename),
+    _fd(-1)
+{
+}
+
+ColumnarReader::~ColumnarReader()
+{
+    close();
+}
+
+void ColumnarReader::open()
+{
+    if (isOpen())
+        return;
+
+    _fd = ::open(_filename.c_str(), O_RDONLY);
+    if (0 > _fd)
+        return;
+
+    _raw_in.reset(new FileInputStream(_fd));
+
+    ColumnCounter counter;
+    EventColumns().visit(counter);
+
+    bool is_good;
+    {
+        CodedInputStream coded_in(_raw_in.get());
+
+        uint32_t magic;
+        uint32_t version;
+        uint32_t columns;
+
+        is_good = coded_in.ReadLittleEndian32(&magic)
+            && COLUMNAR_MAGIC == magic
+            && coded_in.ReadLittleEndian32(&version)
+            && COLUMNAR_VERSION == version
+            && coded_in.ReadLittleEndian32(&columns)
+            && counter.columns == columns;
+    }
+
+    if (!is_good)
+        close();
+}
+
+void ColumnarReader::close()
+{
+    if (!isOpen())
+        return;
+
+    _raw_in->Close();
+    _raw_in.reset();
+
+    _fd = -1;
+}
+
+bool ColumnarReader::isOpen() const
+{
+    return 0 <= _fd;
+}
+
+string ColumnarReader::filename() const
+{
+    return _filename;
+}
+
+bool ColumnarReader::read(EventColumns &columns)
+{
+    if (!isOpen())
+        return false;
+
+    // Coded stream is created per block: it limits the total number of
+    // bytes read and blocks are well below the limit
+    //
+    CodedInputStream coded_in(_raw_in.get());
+
+    uint32_t events;
+    if (!coded_in.ReadLittleEndian32(&events))
+        return false;
+
+    ColumnReader reader(coded_in);
+    columns.visit(reader);
+
+    return reader.isGood()
+        && isConsistent(columns, events);
+}
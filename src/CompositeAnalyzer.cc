@@ -0,0 +1,146 @@
+// Composite Analyzer
+//
+// Group of analyzers run in one pass over the input
+//
+// Copyright 2011, All rights reserved
+
+#include <ostream>
+
+#include <boost/pointer_cast.hpp>
+
+#include "bsm_core/interface/ID.h"
+#include "interface/CompositeAnalyzer.h"
+
+using namespace std;
+
+using boost::dynamic_pointer_cast;
+
+using bsm::CompositeAnalyzer;
+using bsm::EventFields;
+
+CompositeAnalyzer::CompositeAnalyzer()
+{
+}
+
+CompositeAnalyzer::CompositeAnalyzer(const CompositeAnalyzer &object)
+{
+    for(Analyzers::const_iterator analyzer = object._analyzers.begin();
+            object._analyzers.end() != analyzer;
+            ++analyzer)
+    {
+        add(dynamic_pointer_cast<Analyzer>((*analyzer)->clone()));
+    }
+}
+
+void CompositeAnalyzer::add(const AnalyzerPtr &analyzer)
+{
+    if (!analyzer)
+        return;
+
+    _analyzers.push_back(analyzer);
+
+    // Analyzers are merged with the ones of other group in the same order
+    //
+    monitor(analyzer);
+}
+
+const CompositeAnalyzer::Analyzers &CompositeAnalyzer::analyzers() const
+{
+    return _analyzers;
+}
+
+void CompositeAnalyzer::onFileOpen(const std::string &filename,
+        const Input *input)
+{
+    for(Analyzers::const_iterator analyzer = _analyzers.begin();
+            _analyzers.end() != analyzer;
+            ++analyzer)
+    {
+        (*analyzer)->onFileOpen(filename, input);
+    }
+}
+
+void CompositeAnalyzer::process(const Event *event)
+{
+    for(Analyzers::const_iterator analyzer = _analyzers.begin();
+            _analyzers.end() != analyzer;
+            ++analyzer)
+    {
+        (*analyzer)->process(event);
+    }
+}
+
+bool CompositeAnalyzer::reset()
+{
+    bool result = true;
+    for(Analyzers::const_iterator analyzer = _analyzers.begin();
+            _analyzers.end() != analyzer;
+            ++analyzer)
+    {
+        result = (*analyzer)->reset() && result;
+    }
+
+    return result;
+}
+
+bool CompositeAnalyzer::save(std::ostream &out) const
+{
+    for(Analyzers::const_iterator analyzer = _analyzers.begin();
+            _analyzers.end() != analyzer;
+            ++analyzer)
+    {
+        if (!(*analyzer)->save(out))
+            return false;
+    }
+
+    return true;
+}
+
+bool CompositeAnalyzer::load(std::istream &in)
+{
+    for(Analyzers::const_iterator analyzer = _analyzers.begin();
+            _analyzers.end() != analyzer;
+            ++analyzer)
+    {
+        if (!(*analyzer)->load(in))
+            return false;
+    }
+
+    return true;
+}
+
+EventFields CompositeAnalyzer::fields() const
+{
+    EventFields fields = EventFields::none();
+    for(Analyzers::const_iterator analyzer = _analyzers.begin();
+            _analyzers.end() != analyzer;
+            ++analyzer)
+    {
+        fields.add((*analyzer)->fields());
+    }
+
+    return fields;
+}
+
+uint32_t CompositeAnalyzer::id() const
+{
+    return core::ID<CompositeAnalyzer>::get();
+}
+
+CompositeAnalyzer::ObjectPtr CompositeAnalyzer::clone() const
+{
+    return ObjectPtr(new CompositeAnalyzer(*this));
+}
+
+void CompositeAnalyzer::print(std::ostream &out) const
+{
+    for(Analyzers::const_iterator analyzer = _analyzers.begin();
+            _analyzers.end() != analyzer;
+            ++analyzer)
+    {
+        if (_analyzers.begin() != analyzer)
+            out << endl;
+
+        out << **analyzer << endl;
+    }
+}
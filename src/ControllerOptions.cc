@@ -0,0 +1,149 @@
+// Controller Options
+//
+// Command line options of the ThreadController shared by all drivers
+//
+// Copyright 2011, All rights reserved
+
+#include "interface/ControllerOptions.h"
+#include "interface/Thread.h"
+
+namespace po = boost::program_options;
+
+using bsm::ControllerOptions;
+using bsm::ThreadController;
+
+ControllerOptions::ControllerOptions():
+    _description("Controller Options")
+{
+    _description.add_options()
+        ("threads",
+         po::value<uint32_t>(),
+         "Number of analyzer threads [default: number of cores]")
+
+        ("pin",
+         "Pin analyzer threads to cores")
+
+        ("chunk",
+         po::value<uint32_t>(),
+         "Split input files into chunks of N events")
+
+        ("readers",
+         po::value<uint32_t>(),
+         "Decode events in N reader threads (pipelined mode)")
+
+        ("processes",
+         po::value<uint32_t>(),
+         "Fork N worker processes instead of analyzer threads")
+
+        ("checkpoint",
+         po::value<std::string>(),
+         "Save processed inputs and results to checkpoint file")
+
+        ("checkpoint-inputs",
+         po::value<uint32_t>()->default_value(10),
+         "Save checkpoint every N inputs (files or chunks)")
+
+        ("resume",
+         "Resume interrupted job from the checkpoint")
+
+        ("mmap",
+         "Read events from memory mapped input files")
+
+        ("uring",
+         "Read input files with asynchronous io_uring reads (Linux)")
+
+        ("readahead",
+         po::value<uint32_t>(),
+         "Load next N inputs of each worker into page cache")
+
+        ("readahead-mb",
+         po::value<uint32_t>()->default_value(256),
+         "Maximum megabytes loaded ahead")
+
+        ("event-reset",
+         po::value<uint32_t>(),
+         "Release reused event memory every N events [0: never, default]")
+
+        ("stage-dir",
+         po::value<std::string>(),
+         "Copy inputs into local cache directory shared by jobs")
+
+        ("stage-mb",
+         po::value<uint32_t>()->default_value(10240),
+         "Maximum megabytes kept in the staging cache")
+
+        ("history",
+         po::value<std::string>(),
+         "Schedule inputs by processing time saved in history file")
+
+        ("manifest",
+         po::value<std::string>(),
+         "Report progress in events of the dataset manifest (bsm_manifest)")
+
+        ("stats",
+         po::value<std::string>(),
+         "Write job progress to JSON file")
+
+        ("stats-interval",
+         po::value<uint32_t>()->default_value(5),
+         "Update progress file every N seconds")
+    ;
+}
+
+const po::options_description &ControllerOptions::description() const
+{
+    return _description;
+}
+
+void ControllerOptions::apply(const po::variables_map &arguments,
+        ThreadController &controller) const
+{
+    if (arguments.count("threads"))
+        controller.setMaxThreads(arguments["threads"].as<uint32_t>());
+
+    if (arguments.count("pin"))
+        controller.setPinThreads(true);
+
+    if (arguments.count("chunk"))
+        controller.setEventsPerChunk(arguments["chunk"].as<uint32_t>());
+
+    if (arguments.count("readers"))
+        controller.setReaderThreads(arguments["readers"].as<uint32_t>());
+
+    if (arguments.count("processes"))
+        controller.setProcesses(arguments["processes"].as<uint32_t>());
+
+    if (arguments.count("checkpoint"))
+        controller.setCheckpoint(arguments["checkpoint"].as<std::string>(),
+                arguments["checkpoint-inputs"].as<uint32_t>());
+
+    if (arguments.count("resume"))
+        controller.setResume(true);
+
+    if (arguments.count("mmap"))
+        controller.setMappedReader(true);
+
+    if (arguments.count("uring"))
+        controller.setUringReader(true);
+
+    if (arguments.count("readahead"))
+        controller.setReadahead(arguments["readahead"].as<uint32_t>(),
+                arguments["readahead-mb"].as<uint32_t>());
+
+    if (arguments.count("event-reset"))
+        controller.setEventReset(arguments["event-reset"].as<uint32_t>());
+
+    if (arguments.count("stage-dir"))
+        controller.setStaging(arguments["stage-dir"].as<std::string>(),
+                arguments["stage-mb"].as<uint32_t>());
+
+    if (arguments.count("history"))
+        controller.setHistory(arguments["history"].as<std::string>());
+
+    if (arguments.count("manifest"))
+        controller.setManifest(arguments["manifest"].as<std::string>());
+
+    if (arguments.count("stats"))
+        controller.setStats(arguments["stats"].as<std::string>(),
+                arguments["stats-interval"].as<uint32_t>());
+}
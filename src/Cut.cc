@@ -6,6 +6,7 @@
 #include <boost/pointer_cast.hpp>
 
 #include "interface/Cut.h"
+#include "interface/Utility.h"
 
 using std::string;
 
@@ -14,6 +15,9 @@ using bsm::CounterPtr;
 using bsm::Cut;
 using bsm::LockCounterOnUpdate;
 
+using bsm::utility::read;
+using bsm::utility::write;
+
 // Counter
 //
 Counter::Counter():
@@ -64,6 +68,18 @@ void Counter::add()
     update();
 }
 
+bool Counter::save(std::ostream &out) const
+{
+    write(out, _count);
+
+    return !out.fail();
+}
+
+bool Counter::load(std::istream &in)
+{
+    return read(in, _count);
+}
+
 uint32_t Counter::id() const
 {
     return core::ID<Counter>::get();
@@ -195,6 +211,24 @@ void Cut::enable()
     _is_disabled = false;
 }
 
+bool Cut::save(std::ostream &out) const
+{
+    write(out, _value);
+
+    return _objects->save(out)
+        && _events->save(out);
+}
+
+bool Cut::load(std::istream &in)
+{
+    float value = 0;
+
+    return read(in, value)
+        && _value == value
+        && _objects->load(in)
+        && _events->load(in);
+}
+
 uint32_t Cut::id() const
 {
     return core::ID<Cut>::get();
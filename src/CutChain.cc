@@ -0,0 +1,274 @@
+// Cut Chain
+//
+// Cuts of the selector fixed at compile time
+//
+// Copyright 2011, All rights reserved
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "interface/CutChain.h"
+
+using std::string;
+
+using bsm::ChainCut;
+using bsm::CutChainCounters;
+using bsm::CutCount;
+using bsm::CutListEnd;
+
+using bsm::utility::read;
+using bsm::utility::write;
+
+// Cut Count
+//
+CutCount::CutCount():
+    objects(0),
+    events(0),
+    is_event_locked(false)
+{
+}
+
+
+
+// Batch Compare
+//
+#if defined(__SSE2__)
+// Mask is and-ed with the comparison result of WIDTH objects at a time
+//
+#define BSM_BATCH_COMPARE(COMPARE, SSE_COMPARE) \
+template<> \
+    void bsm::BatchCompare<COMPARE >::apply(const float *values, \
+            const float &value, \
+            uint32_t *mask, \
+            const uint32_t &size) \
+{ \
+    const __m128 cut = _mm_set1_ps(value); \
+    float *masks = reinterpret_cast<float *>(mask); \
+\
+    for(uint32_t object = 0; size > object; object += 4) \
+    { \
+        const __m128 pass = SSE_COMPARE(_mm_load_ps(values + object), cut); \
+\
+        _mm_store_ps(masks + object, \
+                _mm_and_ps(_mm_load_ps(masks + object), pass)); \
+    } \
+}
+#else
+// Plain loop: compiler is free to vectorize it
+//
+#define BSM_BATCH_COMPARE(COMPARE, SSE_COMPARE) \
+template<> \
+    void bsm::BatchCompare<COMPARE >::apply(const float *values, \
+            const float &value, \
+            uint32_t *mask, \
+            const uint32_t &size) \
+{ \
+    COMPARE functor; \
+    for(uint32_t object = 0; size > object; ++object) \
+    { \
+        if (!functor(values[object], value)) \
+            mask[object] = 0; \
+    } \
+}
+#endif
+
+BSM_BATCH_COMPARE(std::greater<float>, _mm_cmpgt_ps)
+BSM_BATCH_COMPARE(std::greater_equal<float>, _mm_cmpge_ps)
+BSM_BATCH_COMPARE(std::less<float>, _mm_cmplt_ps)
+BSM_BATCH_COMPARE(std::less_equal<float>, _mm_cmple_ps)
+
+#undef BSM_BATCH_COMPARE
+
+// Both value and cut should be non-zero. NaN is true the same way as in
+// the conversion to bool
+//
+template<>
+    void bsm::BatchCompare<std::logical_and<bool> >::apply(const float *values,
+            const float &value,
+            uint32_t *mask,
+            const uint32_t &size)
+{
+    if (!value)
+    {
+        for(uint32_t object = 0; size > object; ++object)
+        {
+            mask[object] = 0;
+        }
+
+        return;
+    }
+
+#if defined(__SSE2__)
+    const __m128 zero = _mm_setzero_ps();
+    float *masks = reinterpret_cast<float *>(mask);
+
+    for(uint32_t object = 0; size > object; object += 4)
+    {
+        const __m128 pass = _mm_cmpneq_ps(_mm_load_ps(values + object), zero);
+
+        _mm_store_ps(masks + object,
+                _mm_and_ps(_mm_load_ps(masks + object), pass));
+    }
+#else
+    for(uint32_t object = 0; size > object; ++object)
+    {
+        if (!values[object])
+            mask[object] = 0;
+    }
+#endif
+}
+
+
+
+// Chain Cut
+//
+ChainCut::ChainCut(const float &value, const string &name):
+    _value(value),
+    _name(name),
+    _is_disabled(false)
+{
+}
+
+float ChainCut::value() const
+{
+    return _value;
+}
+
+void ChainCut::setValue(const float &value)
+{
+    _value = value;
+}
+
+string ChainCut::name() const
+{
+    return _name;
+}
+
+void ChainCut::setName(const string &name)
+{
+    _name = name;
+}
+
+bool ChainCut::isDisabled() const
+{
+    return _is_disabled;
+}
+
+void ChainCut::disable()
+{
+    _is_disabled = true;
+}
+
+void ChainCut::enable()
+{
+    _is_disabled = false;
+}
+
+bool ChainCut::isMergeable(const ChainCut &cut) const
+{
+    return _value == cut._value
+        && _name == cut._name;
+}
+
+void ChainCut::print(std::ostream &out, const CutCount &count) const
+{
+    using std::setw;
+    using std::left;
+
+    out << setw(5) << left << value() << " ";
+
+    if (!isDisabled())
+        out << setw(7) << left << count.objects
+            << " " << count.events;
+}
+
+
+
+// Cut List End
+//
+void CutListEnd::enable()
+{
+}
+
+void CutListEnd::disable()
+{
+}
+
+void CutListEnd::merge(const CutListEnd &, CutCount *, const CutCount *)
+{
+}
+
+void CutListEnd::print(std::ostream &, const CutCount *) const
+{
+}
+
+
+
+// Cut Chain Counters
+//
+CutChainCounters::CutChainCounters(const uint32_t &cuts):
+    _counts(cuts),
+    _is_lock_on_update(false)
+{
+}
+
+uint32_t CutChainCounters::objects(const uint32_t &cut) const
+{
+    return _counts[cut].objects;
+}
+
+uint32_t CutChainCounters::events(const uint32_t &cut) const
+{
+    return _counts[cut].events;
+}
+
+void CutChainCounters::lockEventsOnUpdate()
+{
+    _is_lock_on_update = true;
+}
+
+void CutChainCounters::unlockEvents()
+{
+    _is_lock_on_update = false;
+
+    for(std::vector<CutCount>::iterator count = _counts.begin();
+            _counts.end() != count;
+            ++count)
+    {
+        count->is_event_locked = false;
+    }
+}
+
+bool CutChainCounters::save(std::ostream &out) const
+{
+    write(out, static_cast<uint32_t>(_counts.size()));
+    for(std::vector<CutCount>::const_iterator count = _counts.begin();
+            _counts.end() != count;
+            ++count)
+    {
+        write(out, count->objects);
+        write(out, count->events);
+    }
+
+    return !out.fail();
+}
+
+bool CutChainCounters::load(std::istream &in)
+{
+    uint32_t cuts = 0;
+    if (!read(in, cuts)
+            || _counts.size() != cuts)
+        return false;
+
+    for(std::vector<CutCount>::iterator count = _counts.begin();
+            _counts.end() != count;
+            ++count)
+    {
+        if (!read(in, count->objects)
+                || !read(in, count->events))
+            return false;
+    }
+
+    return true;
+}
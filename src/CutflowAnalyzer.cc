@@ -5,6 +5,7 @@
 // Created by Samvel Khalatyan, May 18, 2011
 // Copyright 2011, All rights reserved
 
+#include <istream>
 #include <ostream>
 
 #include <boost/pointer_cast.hpp>
@@ -161,6 +162,44 @@ void CutflowAnalyzer::process(const Event *event)
     muons(event);
 }
 
+bool CutflowAnalyzer::save(std::ostream &out) const
+{
+    return _pv_multiplicity->save(out)
+        && _jet_selector->save(out)
+        && _jet_multiplicity->save(out)
+        && _pf_el_selector->save(out)
+        && _pf_el_number_selector->save(out)
+        && _gsf_el_selector->save(out)
+        && _gsf_el_number_selector->save(out)
+        && _pf_mu_selector_step1->save(out)
+        && _pf_mu_number_selector_step1->save(out)
+        && _pf_mu_selector->save(out)
+        && _pf_mu_number_selector->save(out)
+        && _reco_mu_selector_step1->save(out)
+        && _reco_mu_number_selector_step1->save(out)
+        && _reco_mu_selector->save(out)
+        && _reco_mu_number_selector->save(out);
+}
+
+bool CutflowAnalyzer::load(std::istream &in)
+{
+    return _pv_multiplicity->load(in)
+        && _jet_selector->load(in)
+        && _jet_multiplicity->load(in)
+        && _pf_el_selector->load(in)
+        && _pf_el_number_selector->load(in)
+        && _gsf_el_selector->load(in)
+        && _gsf_el_number_selector->load(in)
+        && _pf_mu_selector_step1->load(in)
+        && _pf_mu_number_selector_step1->load(in)
+        && _pf_mu_selector->load(in)
+        && _pf_mu_number_selector->load(in)
+        && _reco_mu_selector_step1->load(in)
+        && _reco_mu_number_selector_step1->load(in)
+        && _reco_mu_selector->load(in)
+        && _reco_mu_number_selector->load(in);
+}
+
 uint32_t CutflowAnalyzer::id() const
 {
     return core::ID<CutflowAnalyzer>::get();
@@ -446,6 +485,30 @@ void MuonCutflowAnalyzer::process(const Event *event)
     _cutflow->apply(HT_LEP);
 }
 
+bool MuonCutflowAnalyzer::save(std::ostream &out) const
+{
+    return _cutflow->save(out)
+        && _pv_multiplicity->save(out)
+        && _jet_selector->save(out)
+        && _jet_multiplicity->save(out)
+        && _el_selector->save(out)
+        && _el_number_selector->save(out)
+        && _mu_selector->save(out)
+        && _mu_number_selector->save(out);
+}
+
+bool MuonCutflowAnalyzer::load(std::istream &in)
+{
+    return _cutflow->load(in)
+        && _pv_multiplicity->load(in)
+        && _jet_selector->load(in)
+        && _jet_multiplicity->load(in)
+        && _el_selector->load(in)
+        && _el_number_selector->load(in)
+        && _mu_selector->load(in)
+        && _mu_number_selector->load(in);
+}
+
 uint32_t MuonCutflowAnalyzer::id() const
 {
     return core::ID<MuonCutflowAnalyzer>::get();
@@ -0,0 +1,365 @@
+// Dataset Manifest
+//
+// Size, number of events and run range of every input file of the dataset
+//
+// Copyright 2011, All rights reserved
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <fstream>
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include <google/protobuf/io/coded_stream.h>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "interface/DatasetManifest.h"
+#include "interface/EventFields.h"
+#include "interface/RecordReader.h"
+
+using std::ifstream;
+using std::string;
+using std::vector;
+
+using bsm::DatasetManifest;
+using bsm::Event;
+using bsm::EventFields;
+using bsm::RecordReader;
+
+// Manifest file format:
+//
+//  [fixed32]   magic
+//  [fixed32]   version
+//  [fixed32]   number of files: N
+//  N x {
+//      [varint32]  file name size
+//      [bytes]     file name
+//      [fixed64]   file size in bytes
+//      [fixed64]   file modification time
+//      [fixed32]   number of events
+//      [fixed32]   first run
+//      [fixed32]   last run
+//  }
+//
+static const uint32_t MANIFEST_MAGIC = 0x42534d4d; // BSMM
+static const uint32_t MANIFEST_VERSION = 1;
+
+// Scan files of the list one by one: next file is taken by any idle thread
+//
+struct ManifestScan
+{
+    ManifestScan(const DatasetManifest::Files &scan_files):
+        files(scan_files),
+        entries(scan_files.size()),
+        is_scanned(scan_files.size(), false),
+        next(0)
+    {
+    }
+
+    const DatasetManifest::Files &files;
+
+    vector<DatasetManifest::Entry> entries;
+    vector<char> is_scanned;
+
+    boost::atomic<uint32_t> next;
+};
+
+DatasetManifest::Entry::Entry():
+    size(0),
+    mtime(0),
+    events(0),
+    first_run(0),
+    last_run(0)
+{
+}
+
+DatasetManifest::DatasetManifest(const string &filename):
+    _file(filename, MANIFEST_MAGIC, MANIFEST_VERSION)
+{
+}
+
+string DatasetManifest::filename() const
+{
+    return _file.filename();
+}
+
+bool DatasetManifest::load()
+{
+    _entries.clear();
+
+    const bool result = _file.load(boost::bind(&DatasetManifest::readBody,
+                this, _1));
+
+    if (!result)
+        _entries.clear();
+
+    return result;
+}
+
+bool DatasetManifest::save() const
+{
+    return _file.save(boost::bind(&DatasetManifest::writeBody, this, _1));
+}
+
+static void scanFiles(ManifestScan *scan)
+{
+    for(uint32_t file = scan->next.fetch_add(1);
+            scan->files.size() > file;
+            file = scan->next.fetch_add(1))
+    {
+        scan->is_scanned[file] = DatasetManifest::scan(scan->files[file],
+                scan->entries[file]);
+    }
+}
+
+uint32_t DatasetManifest::update(const Files &files, const uint32_t &threads)
+{
+    // Keep entries of the unchanged files in the list
+    //
+    Entries entries;
+    Files scan_files;
+    for(Files::const_iterator file = files.begin();
+            files.end() != file;
+            ++file)
+    {
+        if (entries.count(*file))
+            continue;
+
+        Entry entry;
+        if (find(*file, entry))
+            entries[*file] = entry;
+        else if (scan_files.end() == std::find(scan_files.begin(),
+                    scan_files.end(), *file))
+            scan_files.push_back(*file);
+    }
+
+    ManifestScan scan(scan_files);
+
+    boost::thread_group scan_threads;
+    for(uint32_t thread = 0;
+            threads > thread
+                && scan_files.size() > thread;
+            ++thread)
+    {
+        scan_threads.create_thread(boost::bind(scanFiles, &scan));
+    }
+
+    // Scan in the calling thread if no threads are requested
+    //
+    if (!threads)
+        scanFiles(&scan);
+
+    scan_threads.join_all();
+
+    for(uint32_t file = 0; scan_files.size() > file; ++file)
+    {
+        if (scan.is_scanned[file])
+            entries[scan_files[file]] = scan.entries[file];
+    }
+
+    _entries.swap(entries);
+
+    return scan_files.size();
+}
+
+bool DatasetManifest::find(const string &file_name, Entry &entry) const
+{
+    Entries::const_iterator found = _entries.find(file_name);
+    if (_entries.end() == found)
+        return false;
+
+    Entry current;
+    if (!stat(file_name, current)
+            || current.size != found->second.size
+            || current.mtime != found->second.mtime)
+        return false;
+
+    entry = found->second;
+
+    return true;
+}
+
+uint32_t DatasetManifest::size() const
+{
+    return _entries.size();
+}
+
+uint64_t DatasetManifest::events() const
+{
+    uint64_t events = 0;
+    for(Entries::const_iterator entry = _entries.begin();
+            _entries.end() != entry;
+            ++entry)
+    {
+        events += entry->second.events;
+    }
+
+    return events;
+}
+
+uint64_t DatasetManifest::bytes() const
+{
+    uint64_t bytes = 0;
+    for(Entries::const_iterator entry = _entries.begin();
+            _entries.end() != entry;
+            ++entry)
+    {
+        bytes += entry->second.size;
+    }
+
+    return bytes;
+}
+
+uint32_t DatasetManifest::firstRun() const
+{
+    uint32_t run = 0;
+    for(Entries::const_iterator entry = _entries.begin();
+            _entries.end() != entry;
+            ++entry)
+    {
+        if (entry->second.events
+                && (!run
+                    || entry->second.first_run < run))
+            run = entry->second.first_run;
+    }
+
+    return run;
+}
+
+uint32_t DatasetManifest::lastRun() const
+{
+    uint32_t run = 0;
+    for(Entries::const_iterator entry = _entries.begin();
+            _entries.end() != entry;
+            ++entry)
+    {
+        if (entry->second.events
+                && entry->second.last_run > run)
+            run = entry->second.last_run;
+    }
+
+    return run;
+}
+
+bool DatasetManifest::readList(const string &list, Files &files)
+{
+    ifstream in(list.c_str());
+    if (!in.is_open())
+        return false;
+
+    for(string line; getline(in, line); )
+    {
+        const string::size_type begin = line.find_first_not_of(" \t\r");
+        if (string::npos == begin
+                || '#' == line[begin])
+            continue;
+
+        const string::size_type end = line.find_last_not_of(" \t\r");
+
+        files.push_back(line.substr(begin, end - begin + 1));
+    }
+
+    return true;
+}
+
+// Private
+//
+bool DatasetManifest::stat(const string &file_name, Entry &entry)
+{
+    struct stat file_stat;
+    if (::stat(file_name.c_str(), &file_stat))
+        return false;
+
+    entry.size = file_stat.st_size;
+    entry.mtime = file_stat.st_mtime;
+
+    return true;
+}
+
+bool DatasetManifest::readBody(CodedInputStream &coded_in)
+{
+    uint32_t files;
+    if (!coded_in.ReadLittleEndian32(&files))
+        return false;
+
+    uint32_t size;
+    string file_name;
+    uint64_t mtime;
+    Entry entry;
+    for(; files > _entries.size()
+            && coded_in.ReadVarint32(&size)
+            && coded_in.ReadString(&file_name, size)
+            && coded_in.ReadLittleEndian64(&entry.size)
+            && coded_in.ReadLittleEndian64(&mtime)
+            && coded_in.ReadLittleEndian32(&entry.events)
+            && coded_in.ReadLittleEndian32(&entry.first_run)
+            && coded_in.ReadLittleEndian32(&entry.last_run); )
+    {
+        entry.mtime = mtime;
+
+        _entries[file_name] = entry;
+    }
+
+    return files == _entries.size();
+}
+
+void DatasetManifest::writeBody(CodedOutputStream &coded_out) const
+{
+    coded_out.WriteLittleEndian32(_entries.size());
+
+    for(Entries::const_iterator entry = _entries.begin();
+            _entries.end() != entry;
+            ++entry)
+    {
+        coded_out.WriteVarint32(entry->first.size());
+        coded_out.WriteString(entry->first);
+        coded_out.WriteLittleEndian64(entry->second.size);
+        coded_out.WriteLittleEndian64(entry->second.mtime);
+        coded_out.WriteLittleEndian32(entry->second.events);
+        coded_out.WriteLittleEndian32(entry->second.first_run);
+        coded_out.WriteLittleEndian32(entry->second.last_run);
+    }
+}
+
+bool DatasetManifest::scan(const string &file_name, Entry &entry)
+{
+    entry = Entry();
+
+    if (!stat(file_name, entry))
+        return false;
+
+    RecordReader reader(file_name);
+    reader.open();
+    if (!reader.isOpen())
+        return false;
+
+    EventFields extra = EventFields::none();
+    extra.add(Event::kExtraFieldNumber);
+
+    reader.use(extra);
+
+    for(RecordReader::EventPtr event(new Event());
+            reader.read(event);
+            event->Clear())
+    {
+        const uint32_t run = event->extra().run();
+
+        if (!entry.events
+                || run < entry.first_run)
+            entry.first_run = run;
+
+        if (!entry.events
+                || run > entry.last_run)
+            entry.last_run = run;
+
+        ++entry.events;
+    }
+
+    // Truncated file stops early: it is left out of the manifest
+    //
+    return reader.end() == reader.tell();
+}
@@ -23,6 +23,7 @@ using namespace std;
 using boost::dynamic_pointer_cast;
 
 using bsm::DecayAnalyzer;
+using bsm::EventFields;
 
 DecayAnalyzer::DecayAnalyzer()
 {
@@ -54,6 +55,14 @@ void DecayAnalyzer::process(const Event *event)
     genParticles(event->gen_particles());
 }
 
+EventFields DecayAnalyzer::fields() const
+{
+    EventFields fields = EventFields::none();
+    fields.add(Event::kGenParticlesFieldNumber);
+
+    return fields;
+}
+
 const bsm::H2Ptr DecayAnalyzer::decay_level_1() const
 {
     return _decay_level_1->histogram();
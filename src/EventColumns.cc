@@ -0,0 +1,416 @@
+// Event Columns
+//
+// Structure-of-arrays copy of the commonly used Event fields
+//
+// Copyright 2011, All rights reserved
+
+#include "bsm_input/interface/Algebra.h"
+#include "bsm_input/interface/Electron.pb.h"
+#include "bsm_input/interface/Event.pb.h"
+#include "bsm_input/interface/Jet.pb.h"
+#include "bsm_input/interface/Muon.pb.h"
+#include "bsm_input/interface/Physics.pb.h"
+#include "bsm_input/interface/PrimaryVertex.pb.h"
+#include "bsm_input/interface/Trigger.pb.h"
+#include "interface/EventColumns.h"
+
+using bsm::EventColumns;
+using bsm::EventView;
+using bsm::ElectronView;
+using bsm::JetView;
+using bsm::LorentzVector;
+using bsm::MuonView;
+using bsm::P4View;
+using bsm::PrimaryVertexView;
+
+// Event Columns
+//
+EventColumns::EventColumns()
+{
+    clear();
+}
+
+void EventColumns::add(const Event &event)
+{
+    run.push_back(event.extra().run());
+    lumi.push_back(event.extra().lumi());
+    EventColumns::event.push_back(event.extra().id());
+
+    typedef ::google::protobuf::RepeatedPtrField<PrimaryVertex> PrimaryVertices;
+    for(PrimaryVertices::const_iterator pv = event.primary_vertices().begin();
+            event.primary_vertices().end() != pv;
+            ++pv)
+    {
+        primary_vertices.z.push_back(pv->vertex().z());
+        primary_vertices.has_extra.push_back(pv->has_extra());
+        primary_vertices.ndof.push_back(pv->extra().ndof());
+        primary_vertices.rho.push_back(pv->extra().rho());
+    }
+    primary_vertices.offsets.push_back(primary_vertices.z.size());
+
+    typedef ::google::protobuf::RepeatedPtrField<Jet> Jets;
+    for(Jets::const_iterator jet = event.jets().begin();
+            event.jets().end() != jet;
+            ++jet)
+    {
+        jets.p4.add(jet->physics_object().p4());
+    }
+    jets.offsets.push_back(jets.p4.e.size());
+
+    typedef ::google::protobuf::RepeatedPtrField<Electron> Electrons;
+    for(Electrons::const_iterator electron = event.pf_electrons().begin();
+            event.pf_electrons().end() != electron;
+            ++electron)
+    {
+        pf_electrons.p4.add(electron->physics_object().p4());
+        pf_electrons.vertex_z.push_back(
+                electron->physics_object().vertex().z());
+    }
+    pf_electrons.offsets.push_back(pf_electrons.p4.e.size());
+
+    typedef ::google::protobuf::RepeatedPtrField<Muon> Muons;
+    for(Muons::const_iterator muon = event.pf_muons().begin();
+            event.pf_muons().end() != muon;
+            ++muon)
+    {
+        pf_muons.p4.add(muon->physics_object().p4());
+        pf_muons.vertex_z.push_back(muon->physics_object().vertex().z());
+
+        pf_muons.has_extra.push_back(muon->has_extra());
+        pf_muons.is_global.push_back(muon->extra().is_global());
+        pf_muons.is_tracker.push_back(muon->extra().is_tracker());
+        pf_muons.number_of_matches.push_back(
+                muon->extra().number_of_matches());
+        pf_muons.pixel_hits.push_back(muon->extra().pixel_hits());
+        pf_muons.d0_bsp.push_back(muon->extra().d0_bsp());
+
+        pf_muons.global_track_hits.push_back(muon->global_track().hits());
+        pf_muons.global_track_normalized_chi2.push_back(
+                muon->global_track().normalized_chi2());
+        pf_muons.inner_track_hits.push_back(muon->inner_track().hits());
+    }
+    pf_muons.offsets.push_back(pf_muons.p4.e.size());
+
+    typedef ::google::protobuf::RepeatedPtrField<Trigger> Triggers;
+    for(Triggers::const_iterator hlt = event.hlts().begin();
+            event.hlts().end() != hlt;
+            ++hlt)
+    {
+        hlts.hash.push_back(hlt->hash());
+        hlts.pass.push_back(hlt->pass());
+    }
+    hlts.offsets.push_back(hlts.hash.size());
+}
+
+void EventColumns::clear()
+{
+    run.clear();
+    lumi.clear();
+    event.clear();
+
+    primary_vertices.offsets.assign(1, 0);
+    primary_vertices.z.clear();
+    primary_vertices.has_extra.clear();
+    primary_vertices.ndof.clear();
+    primary_vertices.rho.clear();
+
+    jets.offsets.assign(1, 0);
+    jets.p4.clear();
+
+    pf_electrons.offsets.assign(1, 0);
+    pf_electrons.p4.clear();
+    pf_electrons.vertex_z.clear();
+
+    pf_muons.offsets.assign(1, 0);
+    pf_muons.p4.clear();
+    pf_muons.vertex_z.clear();
+    pf_muons.has_extra.clear();
+    pf_muons.is_global.clear();
+    pf_muons.is_tracker.clear();
+    pf_muons.number_of_matches.clear();
+    pf_muons.pixel_hits.clear();
+    pf_muons.d0_bsp.clear();
+    pf_muons.global_track_hits.clear();
+    pf_muons.global_track_normalized_chi2.clear();
+    pf_muons.inner_track_hits.clear();
+
+    hlts.offsets.assign(1, 0);
+    hlts.hash.clear();
+    hlts.pass.clear();
+}
+
+uint32_t EventColumns::size() const
+{
+    return run.size();
+}
+
+
+
+// Lorentz Vectors
+//
+void EventColumns::P4s::add(const LorentzVector &p4)
+{
+    e.push_back(p4.e());
+    px.push_back(p4.px());
+    py.push_back(p4.py());
+    pz.push_back(p4.pz());
+}
+
+void EventColumns::P4s::clear()
+{
+    e.clear();
+    px.clear();
+    py.clear();
+    pz.clear();
+}
+
+
+
+// P4 View
+//
+P4View::P4View(const EventColumns::P4s &p4s, const uint32_t &object):
+    _p4s(&p4s),
+    _object(object)
+{
+}
+
+LorentzVector P4View::p4() const
+{
+    LorentzVector p4;
+    p4.set_e(_p4s->e[_object]);
+    p4.set_px(_p4s->px[_object]);
+    p4.set_py(_p4s->py[_object]);
+    p4.set_pz(_p4s->pz[_object]);
+
+    return p4;
+}
+
+float P4View::pt() const
+{
+    return bsm::pt(p4());
+}
+
+float P4View::et() const
+{
+    return bsm::et(p4());
+}
+
+float P4View::eta() const
+{
+    return bsm::eta(p4());
+}
+
+float P4View::mass() const
+{
+    return bsm::mass(p4());
+}
+
+
+
+// Primary Vertex View
+//
+PrimaryVertexView::PrimaryVertexView(const EventColumns &columns,
+        const uint32_t &object):
+    _vertices(&columns.primary_vertices),
+    _object(object)
+{
+}
+
+float PrimaryVertexView::z() const
+{
+    return _vertices->z[_object];
+}
+
+bool PrimaryVertexView::hasExtra() const
+{
+    return _vertices->has_extra[_object];
+}
+
+float PrimaryVertexView::ndof() const
+{
+    return _vertices->ndof[_object];
+}
+
+float PrimaryVertexView::rho() const
+{
+    return _vertices->rho[_object];
+}
+
+
+
+// Jet View
+//
+JetView::JetView(const EventColumns &columns, const uint32_t &object):
+    P4View(columns.jets.p4, object)
+{
+}
+
+
+
+// Electron View
+//
+ElectronView::ElectronView(const EventColumns &columns,
+        const uint32_t &object):
+    P4View(columns.pf_electrons.p4, object),
+    _electrons(&columns.pf_electrons)
+{
+}
+
+float ElectronView::vertexZ() const
+{
+    return _electrons->vertex_z[_object];
+}
+
+
+
+// Muon View
+//
+MuonView::MuonView(const EventColumns &columns, const uint32_t &object):
+    P4View(columns.pf_muons.p4, object),
+    _muons(&columns.pf_muons)
+{
+}
+
+float MuonView::vertexZ() const
+{
+    return _muons->vertex_z[_object];
+}
+
+bool MuonView::hasExtra() const
+{
+    return _muons->has_extra[_object];
+}
+
+bool MuonView::isGlobal() const
+{
+    return _muons->is_global[_object];
+}
+
+bool MuonView::isTracker() const
+{
+    return _muons->is_tracker[_object];
+}
+
+uint32_t MuonView::numberOfMatches() const
+{
+    return _muons->number_of_matches[_object];
+}
+
+uint32_t MuonView::pixelHits() const
+{
+    return _muons->pixel_hits[_object];
+}
+
+float MuonView::d0Bsp() const
+{
+    return _muons->d0_bsp[_object];
+}
+
+uint32_t MuonView::globalTrackHits() const
+{
+    return _muons->global_track_hits[_object];
+}
+
+float MuonView::globalTrackNormalizedChi2() const
+{
+    return _muons->global_track_normalized_chi2[_object];
+}
+
+uint32_t MuonView::innerTrackHits() const
+{
+    return _muons->inner_track_hits[_object];
+}
+
+
+
+// Event View
+//
+EventView::EventView(const EventColumns &columns, const uint32_t &event):
+    _columns(&columns),
+    _event(event)
+{
+}
+
+uint32_t EventView::run() const
+{
+    return _columns->run[_event];
+}
+
+uint32_t EventView::lumi() const
+{
+    return _columns->lumi[_event];
+}
+
+uint32_t EventView::event() const
+{
+    return _columns->event[_event];
+}
+
+uint32_t EventView::primaryVertices() const
+{
+    return count(_columns->primary_vertices.offsets);
+}
+
+PrimaryVertexView EventView::primaryVertex(const uint32_t &object) const
+{
+    return PrimaryVertexView(*_columns,
+            first(_columns->primary_vertices.offsets) + object);
+}
+
+uint32_t EventView::jets() const
+{
+    return count(_columns->jets.offsets);
+}
+
+JetView EventView::jet(const uint32_t &object) const
+{
+    return JetView(*_columns, first(_columns->jets.offsets) + object);
+}
+
+uint32_t EventView::electrons() const
+{
+    return count(_columns->pf_electrons.offsets);
+}
+
+ElectronView EventView::electron(const uint32_t &object) const
+{
+    return ElectronView(*_columns,
+            first(_columns->pf_electrons.offsets) + object);
+}
+
+uint32_t EventView::muons() const
+{
+    return count(_columns->pf_muons.offsets);
+}
+
+MuonView EventView::muon(const uint32_t &object) const
+{
+    return MuonView(*_columns, first(_columns->pf_muons.offsets) + object);
+}
+
+uint32_t EventView::hlts() const
+{
+    return count(_columns->hlts.offsets);
+}
+
+uint64_t EventView::hltHash(const uint32_t &object) const
+{
+    return _columns->hlts.hash[first(_columns->hlts.offsets) + object];
+}
+
+bool EventView::hltPass(const uint32_t &object) const
+{
+    return _columns->hlts.pass[first(_columns->hlts.offsets) + object];
+}
+
+// Private
+//
+uint32_t EventView::count(const EventColumns::Offsets &offsets) const
+{
+    return offsets[_event + 1] - offsets[_event];
+}
+
+uint32_t EventView::first(const EventColumns::Offsets &offsets) const
+{
+    return offsets[_event];
+}
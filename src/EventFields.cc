@@ -0,0 +1,156 @@
+// Event Fields
+//
+// Set of the Event fields used by analyzer
+//
+// Copyright 2011, All rights reserved
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/wire_format_lite.h>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "interface/EventFields.h"
+
+using std::string;
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::io::StringOutputStream;
+using google::protobuf::internal::WireFormatLite;
+
+using bsm::EventFields;
+
+const uint32_t EventFields::MAX_FIELD;
+
+EventFields::EventFields():
+    _is_all(true),
+    _mask(0)
+{
+}
+
+EventFields EventFields::none()
+{
+    EventFields fields;
+    fields._is_all = false;
+
+    return fields;
+}
+
+void EventFields::add(const uint32_t &field)
+{
+    if (_is_all)
+        return;
+
+    if (MAX_FIELD < field)
+        _is_all = true;
+    else
+        _mask |= static_cast<uint64_t>(1) << field;
+}
+
+void EventFields::add(const EventFields &fields)
+{
+    if (_is_all)
+        return;
+
+    if (fields._is_all)
+        _is_all = true;
+    else
+        _mask |= fields._mask;
+}
+
+bool EventFields::isAll() const
+{
+    return _is_all;
+}
+
+bool EventFields::has(const uint32_t &field) const
+{
+    return _is_all
+        || MAX_FIELD < field
+        || (_mask & (static_cast<uint64_t>(1) << field));
+}
+
+bool EventFields::operator ==(const EventFields &fields) const
+{
+    return _is_all == fields._is_all
+        && (_is_all || _mask == fields._mask);
+}
+
+bool EventFields::operator !=(const EventFields &fields) const
+{
+    return !(*this == fields);
+}
+
+bool EventFields::parse(const uint8_t *record,
+        const uint32_t &size,
+        Event &event,
+        string &buffer) const
+{
+    if (_is_all)
+        return event.ParseFromArray(record, size);
+
+    // Copy used fields into the buffer and skip the rest: skipped
+    // length-delimited fields cost a varint read
+    //
+    buffer.clear();
+
+    CodedInputStream coded_in(record, size);
+    for(int begin = coded_in.CurrentPosition();
+            const uint32_t tag = coded_in.ReadTag();
+            begin = coded_in.CurrentPosition())
+    {
+        if (!WireFormatLite::SkipField(&coded_in, tag))
+            return false;
+
+        if (has(WireFormatLite::GetTagFieldNumber(tag)))
+            buffer.append(reinterpret_cast<const char *>(record) + begin,
+                    coded_in.CurrentPosition() - begin);
+    }
+
+    if (!coded_in.ConsumedEntireMessage())
+        return false;
+
+    return event.ParseFromArray(buffer.data(), buffer.size());
+}
+
+bool EventFields::parse(CodedInputStream &coded_in,
+        const uint32_t &size,
+        Event &event,
+        string &buffer) const
+{
+    if (_is_all)
+    {
+        const CodedInputStream::Limit limit = coded_in.PushLimit(size);
+        if (!event.ParseFromCodedStream(&coded_in)
+                || !coded_in.ConsumedEntireMessage())
+            return false;
+        coded_in.PopLimit(limit);
+
+        return true;
+    }
+
+    // Used fields are written into the buffer as they are read from the
+    // stream. Coded stream gives unused buffer space back when destroyed
+    //
+    buffer.clear();
+    {
+        StringOutputStream raw_out(&buffer);
+        CodedOutputStream coded_out(&raw_out);
+
+        const CodedInputStream::Limit limit = coded_in.PushLimit(size);
+        for(uint32_t tag = coded_in.ReadTag(); tag; tag = coded_in.ReadTag())
+        {
+            if (has(WireFormatLite::GetTagFieldNumber(tag))
+                    ? !WireFormatLite::SkipField(&coded_in, tag, &coded_out)
+                    : !WireFormatLite::SkipField(&coded_in, tag))
+                return false;
+        }
+
+        if (!coded_in.ConsumedEntireMessage()
+                || coded_out.HadError())
+            return false;
+        coded_in.PopLimit(limit);
+    }
+
+    return event.ParseFromArray(buffer.data(), buffer.size());
+}
@@ -0,0 +1,206 @@
+// Event Index
+//
+// Map of the run, lumi and event numbers to byte offsets of the Event
+// records in the bsm_input file
+//
+// Copyright 2011, All rights reserved
+
+#include <algorithm>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "interface/EventIndex.h"
+#include "interface/RecordReader.h"
+
+using std::lower_bound;
+using std::stable_sort;
+using std::string;
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::internal::WireFormatLite;
+
+using bsm::Event;
+using bsm::EventIndex;
+using bsm::RecordReader;
+
+// Sidecar body:
+//
+//  [fixed32]   number of events: N
+//  N x {
+//      [fixed32]   run
+//      [fixed32]   lumi
+//      [fixed32]   event
+//      [fixed64]   record offset
+//  }
+//
+static const uint32_t SIDECAR_MAGIC = 0x42534d45; // BSME
+static const uint32_t SIDECAR_VERSION = 1;
+
+EventIndex::EventIndex(const string &filename):
+    Sidecar(filename, "evt", SIDECAR_MAGIC, SIDECAR_VERSION)
+{
+}
+
+bool EventIndex::scan()
+{
+    clearBody();
+
+    if (!stat())
+        return false;
+
+    RecordReader reader(filename());
+    reader.open();
+    if (!reader.isOpen())
+        return false;
+
+    Entry entry;
+    string record;
+    for(uint64_t offset = reader.tell();
+            reader.read(record);
+            offset = reader.tell())
+    {
+        // Events without extra can not be looked up
+        //
+        if (!decode(record, entry))
+            continue;
+
+        entry.offset = offset;
+
+        _entries.push_back(entry);
+    }
+
+    // Corrupted record stops the reader before the end of Events
+    //
+    if (reader.end() != reader.tell())
+    {
+        _entries.clear();
+
+        return false;
+    }
+
+    stable_sort(_entries.begin(), _entries.end());
+
+    return true;
+}
+
+uint32_t EventIndex::size() const
+{
+    return _entries.size();
+}
+
+void EventIndex::find(const uint32_t &id,
+        const uint32_t &lumi,
+        const uint32_t &run,
+        Offsets &offsets) const
+{
+    Entry key;
+    key.id = id;
+
+    for(Entries::const_iterator entry =
+                lower_bound(_entries.begin(), _entries.end(), key);
+            _entries.end() != entry
+                && id == entry->id;
+            ++entry)
+    {
+        if ((lumi ? lumi == entry->lumi : true)
+                && (run ? run == entry->run : true))
+            offsets.push_back(entry->offset);
+    }
+}
+
+// Protected
+//
+void EventIndex::clearBody()
+{
+    _entries.clear();
+}
+
+bool EventIndex::readBody(CodedInputStream &coded_in)
+{
+    uint32_t events;
+    if (!coded_in.ReadLittleEndian32(&events))
+        return false;
+
+    _entries.reserve(events);
+
+    Entry entry;
+    for(; events > _entries.size()
+            && coded_in.ReadLittleEndian32(&entry.run)
+            && coded_in.ReadLittleEndian32(&entry.lumi)
+            && coded_in.ReadLittleEndian32(&entry.id)
+            && coded_in.ReadLittleEndian64(&entry.offset); )
+    {
+        _entries.push_back(entry);
+    }
+
+    return events == _entries.size();
+}
+
+void EventIndex::writeBody(CodedOutputStream &coded_out) const
+{
+    coded_out.WriteLittleEndian32(_entries.size());
+
+    for(Entries::const_iterator entry = _entries.begin();
+            _entries.end() != entry;
+            ++entry)
+    {
+        coded_out.WriteLittleEndian32(entry->run);
+        coded_out.WriteLittleEndian32(entry->lumi);
+        coded_out.WriteLittleEndian32(entry->id);
+        coded_out.WriteLittleEndian64(entry->offset);
+    }
+}
+
+// Private
+//
+bool EventIndex::decode(const string &record, Entry &entry) const
+{
+    CodedInputStream coded_in(
+            reinterpret_cast<const uint8_t *>(record.data()),
+            record.size());
+
+    Event::Extra extra;
+    bool has_extra = false;
+    for(uint32_t tag = coded_in.ReadTag(); tag; tag = coded_in.ReadTag())
+    {
+        if (Event::kExtraFieldNumber == WireFormatLite::GetTagFieldNumber(tag)
+                && WireFormatLite::WIRETYPE_LENGTH_DELIMITED ==
+                    WireFormatLite::GetTagWireType(tag))
+        {
+            // Message fields repeated in the record are merged
+            //
+            uint32_t size;
+            if (!coded_in.ReadVarint32(&size))
+                return false;
+
+            const CodedInputStream::Limit limit = coded_in.PushLimit(size);
+            if (!extra.MergeFromCodedStream(&coded_in)
+                    || !coded_in.ConsumedEntireMessage())
+                return false;
+            coded_in.PopLimit(limit);
+
+            has_extra = true;
+        }
+        else if (!WireFormatLite::SkipField(&coded_in, tag))
+            return false;
+    }
+
+    if (!has_extra)
+        return false;
+
+    entry.run = extra.run();
+    entry.lumi = extra.lumi();
+    entry.id = extra.id();
+
+    return true;
+}
+
+// Entry
+//
+bool EventIndex::Entry::operator <(const Entry &entry) const
+{
+    return id < entry.id;
+}
@@ -0,0 +1,79 @@
+// Event Recycler
+//
+// Event reused by the thread to decode input records
+//
+// Copyright 2011, All rights reserved
+
+#include "bsm_input/interface/Event.pb.h"
+#include "interface/EventRecycler.h"
+
+using bsm::EventRecycler;
+
+EventRecycler::EventRecycler(const uint32_t &reset_events):
+    _reset_events(reset_events),
+    _events(0),
+    _resets(0),
+    _peak_bytes(0)
+{
+}
+
+void EventRecycler::setResetEvents(const uint32_t &events)
+{
+    _reset_events = events;
+}
+
+EventRecycler::EventPtr &EventRecycler::event()
+{
+    if (!_event)
+        _event.reset(new Event());
+
+    return _event;
+}
+
+void EventRecycler::recycle()
+{
+    if (_reset_events
+            && _reset_events <= ++_events)
+    {
+        reset();
+
+        ++_resets;
+    }
+    else
+        _event->Clear();
+}
+
+void EventRecycler::reset()
+{
+    _events = 0;
+
+    if (!_event)
+        return;
+
+    // SpaceUsed walks the whole message: it is only affordable once per
+    // reset
+    //
+    const uint64_t bytes = _event->SpaceUsed();
+    if (bytes > _peak_bytes)
+        _peak_bytes = bytes;
+
+    // Next Event is allocated once it is needed
+    //
+    _event.reset();
+}
+
+void EventRecycler::resetCounters()
+{
+    _resets = 0;
+    _peak_bytes = 0;
+}
+
+uint32_t EventRecycler::resets() const
+{
+    return _resets;
+}
+
+uint64_t EventRecycler::peakBytes() const
+{
+    return _peak_bytes;
+}
@@ -0,0 +1,105 @@
+// Event Ring
+//
+// Bounded ring buffer of decoded Event batches
+//
+// Copyright 2011, All rights reserved
+
+#include "interface/EventRing.h"
+
+using bsm::EventRing;
+using bsm::EventBatchPtr;
+
+typedef boost::mutex::scoped_lock Lock;
+
+EventRing::EventRing(const uint32_t &capacity, const uint32_t &producers):
+    _batches(capacity ? capacity : 1),
+    _head(0),
+    _size(0),
+    _producers(producers),
+    _closed(false)
+{
+}
+
+bool EventRing::push(const EventBatchPtr &batch)
+{
+    Lock lock(_mutex);
+
+    while(!_closed
+            && _batches.size() == _size)
+    {
+        _not_full.wait(lock);
+    }
+
+    if (_closed)
+        return false;
+
+    _batches[(_head + _size) % _batches.size()] = batch;
+    ++_size;
+
+    _not_empty.notify_one();
+
+    return true;
+}
+
+bool EventRing::pop(EventBatchPtr &batch)
+{
+    Lock lock(_mutex);
+
+    while(!_closed
+            && !_size
+            && _producers)
+    {
+        _not_empty.wait(lock);
+    }
+
+    if (_closed
+            || !_size)
+        return false;
+
+    // Release slot right away: the batch is owned by the consumer now
+    //
+    batch.swap(_batches[_head]);
+    _batches[_head].reset();
+
+    _head = (_head + 1) % _batches.size();
+    --_size;
+
+    _not_full.notify_one();
+
+    return true;
+}
+
+void EventRing::removeProducer()
+{
+    Lock lock(_mutex);
+
+    if (_producers)
+        --_producers;
+
+    // Wake up consumers to let them find out ring is drained
+    //
+    if (!_producers)
+        _not_empty.notify_all();
+}
+
+void EventRing::close()
+{
+    Lock lock(_mutex);
+
+    _closed = true;
+
+    _not_full.notify_all();
+    _not_empty.notify_all();
+}
+
+uint32_t EventRing::capacity() const
+{
+    return _batches.size();
+}
+
+uint32_t EventRing::size() const
+{
+    Lock lock(_mutex);
+
+    return _size;
+}
@@ -7,31 +7,35 @@
 
 #include <iostream>
 #include <ostream>
-#include <sstream>
 
-#include <boost/functional/hash.hpp>
-#include <boost/filesystem.hpp>
 #include <boost/pointer_cast.hpp>
-#include <boost/version.hpp>
 
 #include "bsm_input/interface/Electron.pb.h"
 #include "bsm_input/interface/Event.pb.h"
 #include "bsm_input/interface/Input.pb.h"
 #include "bsm_input/interface/MissingEnergy.pb.h"
 #include "bsm_input/interface/Muon.pb.h"
-#include "bsm_input/interface/Writer.h"
 #include "interface/FilterAnalyzer.h"
 #include "interface/Selector.h"
+#include "interface/SkimWriter.h"
 
 using namespace std;
 
 using boost::dynamic_pointer_cast;
-namespace fs = boost::filesystem;
 
+using bsm::EventBatch;
+using bsm::EventBatchPtr;
 using bsm::FilterAnalyzer;
 
-FilterAnalyzer::FilterAnalyzer()
+// Filtered events passed to the writer at once
+//
+static const uint32_t SKIM_EVENTS_PER_BATCH = 256;
+
+FilterAnalyzer::FilterAnalyzer(const std::string &prefix,
+        const uint64_t &file_size)
 {
+    _writer.reset(new SkimWriter(prefix, file_size));
+
     _pf_el_selector.reset(new ElectronSelector());
     _gsf_el_selector.reset(new ElectronSelector());
 
@@ -47,6 +51,8 @@ FilterAnalyzer::FilterAnalyzer()
 
 FilterAnalyzer::FilterAnalyzer(const FilterAnalyzer &object)
 {
+    _writer = object._writer;
+
     _pf_el_selector = 
         dynamic_pointer_cast<ElectronSelector>(object._pf_el_selector->clone());
 
@@ -66,40 +72,29 @@ FilterAnalyzer::FilterAnalyzer(const FilterAnalyzer &object)
     monitor(_reco_mu_selector);
 }
 
-void FilterAnalyzer::onFileOpen(const std::string &filename, const Input *input)
+void FilterAnalyzer::close()
 {
-    fs::path path(filename);
-
-    ostringstream file_name;
-
-    boost::hash<std::string> make_hash;
-
-    file_name << make_hash(filename);
-
-#if BOOST_VERSION < 104600
-    file_name << path.extension();
-#else
-    file_name << path.extension();
-#endif
+    flush();
 
-    _writer.reset(new Writer(file_name.str()));
-    _writer->open();
-    if (!_writer->isOpen())
-    {
-        _writer.reset();
+    _writer->close();
+}
 
-        return;
-    }
+void FilterAnalyzer::onFileOpen(const std::string &filename, const Input *input)
+{
+    flush();
 
-    *_writer->input() = *input;
+    // Input is copied once per file and shared by all batches of it
+    //
+    _batch.reset(new EventBatch());
+    _batch->file_name = filename;
+    _batch->input.reset(new Input(*input));
 
     _event.reset(new Event());
 }
 
 void FilterAnalyzer::process(const Event *event)
 {
-    if (!_writer
-            || !_event
+    if (!_batch
             || !event->primary_vertices().size())
         return;
 
@@ -109,9 +104,14 @@ void FilterAnalyzer::process(const Event *event)
     missing_energy(event);
     jets(event);
 
-    _writer->write(_event);
+    // Event is owned by the batch from now on: it is serialized by the
+    // writer thread
+    //
+    _batch->events.push_back(_event);
+    _event.reset(new Event());
 
-    _event->Clear();
+    if (SKIM_EVENTS_PER_BATCH <= _batch->events.size())
+        flush();
 }
 
 uint32_t FilterAnalyzer::id() const
@@ -124,6 +124,22 @@ FilterAnalyzer::ObjectPtr FilterAnalyzer::clone() const
     return ObjectPtr(new FilterAnalyzer(*this));
 }
 
+void FilterAnalyzer::merge(const ObjectPtr &pointer)
+{
+    if (id() != pointer->id())
+        return;
+
+    boost::shared_ptr<FilterAnalyzer> object =
+        dynamic_pointer_cast<FilterAnalyzer>(pointer);
+
+    if (!object)
+        return;
+
+    Object::merge(pointer);
+
+    object->flush();
+}
+
 void FilterAnalyzer::print(std::ostream &out) const
 {
     out << "Particle-Flow Electrons" << endl;
@@ -139,11 +155,35 @@ void FilterAnalyzer::print(std::ostream &out) const
     out << endl;
 
     out << "Reco Muons" << endl;
-    out << *_reco_mu_selector;
+    out << *_reco_mu_selector << endl;
+    out << endl;
+
+    out << "Skim" << endl;
+    out << "  Files: " << _writer->files() << endl;
+    out << " Events: " << _writer->events() << endl;
+    out << "   Size: " << _writer->bytes() / 1024 / 1024 << " MB";
+
+    if (_writer->droppedEvents())
+        out << endl << "Dropped: " << _writer->droppedEvents() << " events";
 }
 
 // Private
 //
+void FilterAnalyzer::flush()
+{
+    if (!_batch
+            || _batch->events.empty())
+        return;
+
+    EventBatchPtr batch(new EventBatch());
+    batch->file_name = _batch->file_name;
+    batch->input = _batch->input;
+
+    _batch.swap(batch);
+
+    _writer->push(batch);
+}
+
 void FilterAnalyzer::primaryVertices(const Event *event)
 {
     typedef ::google::protobuf::RepeatedPtrField<PrimaryVertex> PrimaryVertices;
@@ -0,0 +1,253 @@
+// Mapped Reader
+//
+// Read Event records straight from the memory mapped bsm_input file
+//
+// Copyright 2011, All rights reserved
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <google/protobuf/io/coded_stream.h>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "bsm_input/interface/Input.pb.h"
+#include "interface/MappedReader.h"
+#include "interface/RecordReader.h"
+
+using std::string;
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::io::CodedOutputStream;
+
+using bsm::MappedReader;
+using bsm::RecordReader;
+
+// Longest varint32
+//
+static const uint64_t MAX_VARINT32_SIZE = 5;
+
+MappedReader::MappedReader(const string &filename):
+    _filename(filename),
+    _data(0),
+    _size(0),
+    _begin(0),
+    _end(0),
+    _position(0),
+    _limit(0),
+    _had_error(false)
+{
+}
+
+MappedReader::~MappedReader()
+{
+    close();
+}
+
+void MappedReader::open()
+{
+    if (isOpen())
+        return;
+
+    int fd = ::open(_filename.c_str(), O_RDONLY);
+    if (0 > fd)
+        return;
+
+    struct stat file_stat;
+    if (!fstat(fd, &file_stat)
+            && file_stat.st_size)
+    {
+        void *data = mmap(0, file_stat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (MAP_FAILED != data)
+        {
+            _data = static_cast<const uint8_t *>(data);
+            _size = file_stat.st_size;
+
+            madvise(data, _size, MADV_SEQUENTIAL);
+        }
+    }
+
+    // Mapping keeps the file: descriptor is not needed any more
+    //
+    ::close(fd);
+
+    if (!isOpen())
+        return;
+
+    if (!readHeader()
+            || !readInput()
+            || !seek(_begin))
+        close();
+}
+
+void MappedReader::close()
+{
+    if (isOpen())
+    {
+        munmap(const_cast<uint8_t *>(_data), _size);
+
+        _data = 0;
+        _size = 0;
+    }
+
+    _input.reset();
+}
+
+bool MappedReader::isOpen() const
+{
+    return _data;
+}
+
+string MappedReader::filename() const
+{
+    return _filename;
+}
+
+MappedReader::InputPtr MappedReader::input() const
+{
+    return _input;
+}
+
+uint64_t MappedReader::begin() const
+{
+    return _begin;
+}
+
+uint64_t MappedReader::end() const
+{
+    return _end;
+}
+
+bool MappedReader::seek(const uint64_t &offset, const uint64_t &limit)
+{
+    if (!isOpen()
+            || _begin > offset
+            || _end < offset
+            || _end < limit)
+        return false;
+
+    _position = offset;
+    _limit = limit ? limit : _end;
+    _had_error = false;
+
+    return true;
+}
+
+uint64_t MappedReader::tell() const
+{
+    return _position;
+}
+
+void MappedReader::use(const EventFields &fields)
+{
+    _fields = fields;
+}
+
+bool MappedReader::read(EventPtr &event)
+{
+    uint32_t size;
+    if (!readSize(size))
+        return false;
+
+    if (!_fields.parse(_data + _position, size, *event, _buffer))
+        return fail();
+
+    _position += size;
+
+    return true;
+}
+
+bool MappedReader::skip()
+{
+    uint32_t size;
+    if (!readSize(size))
+        return false;
+
+    _position += size;
+
+    return true;
+}
+
+bool MappedReader::hadError() const
+{
+    return _had_error;
+}
+
+// Private
+//
+bool MappedReader::readHeader()
+{
+    if (RecordReader::HEADER_SIZE > _size)
+        return false;
+
+    CodedInputStream coded_in(_data, RecordReader::HEADER_SIZE);
+
+    uint32_t version;
+    uint64_t input_position;
+    if (!coded_in.ReadLittleEndian32(&version)
+            || !coded_in.ReadLittleEndian64(&input_position))
+        return false;
+
+    _begin = RecordReader::HEADER_SIZE;
+    _end = input_position
+        ? input_position
+        : _size;
+
+    return _begin <= _end
+        && _size >= _end;
+}
+
+bool MappedReader::readInput()
+{
+    _input.reset(new Input());
+
+    // Input was not written: file is still usable but carries no
+    // information about triggers, etc.
+    //
+    if (_size == _end)
+        return true;
+
+    CodedInputStream coded_in(_data + _end, _size - _end);
+
+    uint32_t size;
+    if (!coded_in.ReadVarint32(&size))
+        return false;
+
+    const CodedInputStream::Limit limit = coded_in.PushLimit(size);
+    if (!_input->ParseFromCodedStream(&coded_in))
+        return false;
+    coded_in.PopLimit(limit);
+
+    return true;
+}
+
+bool MappedReader::fail()
+{
+    _limit = _position;
+    _had_error = true;
+
+    return false;
+}
+
+bool MappedReader::readSize(uint32_t &size)
+{
+    if (!isOpen()
+            || _position >= _limit)
+        return false;
+
+    const uint64_t available = _limit - _position;
+    CodedInputStream coded_in(_data + _position,
+            MAX_VARINT32_SIZE < available ? MAX_VARINT32_SIZE : available);
+    if (!coded_in.ReadVarint32(&size))
+        return fail();
+
+    _position += CodedOutputStream::VarintSize32(size);
+
+    // Record may not cross the limit
+    //
+    if (_position + size > _limit)
+        return fail();
+
+    return true;
+}
@@ -7,6 +7,7 @@
 // Copyright 2011, All rights reserved
 
 #include <iomanip>
+#include <istream>
 #include <ostream>
 
 #include <TLorentzVector.h>
@@ -131,6 +132,24 @@ const H2Ptr DeltaMonitor::ptrel_vs_r() const
     return _ptrel_vs_r->histogram();
 }
 
+bool DeltaMonitor::save(std::ostream &out) const
+{
+    return _r->save(out)
+        && _eta->save(out)
+        && _phi->save(out)
+        && _ptrel->save(out)
+        && _ptrel_vs_r->save(out);
+}
+
+bool DeltaMonitor::load(std::istream &in)
+{
+    return _r->load(in)
+        && _eta->load(in)
+        && _phi->load(in)
+        && _ptrel->load(in)
+        && _ptrel_vs_r->load(in);
+}
+
 uint32_t DeltaMonitor::id() const
 {
     return core::ID<DeltaMonitor>::get();
@@ -215,6 +234,20 @@ const H1Ptr ElectronsMonitor::leading_pt() const
     return _leading_pt->histogram();
 }
 
+bool ElectronsMonitor::save(std::ostream &out) const
+{
+    return _multiplicity->save(out)
+        && _pt->save(out)
+        && _leading_pt->save(out);
+}
+
+bool ElectronsMonitor::load(std::istream &in)
+{
+    return _multiplicity->load(in)
+        && _pt->load(in)
+        && _leading_pt->load(in);
+}
+
 uint32_t ElectronsMonitor::id() const
 {
     return core::ID<ElectronsMonitor>::get();
@@ -281,6 +314,20 @@ const GenParticleMonitor::H1Ptr GenParticleMonitor::pt() const
     return _pt->histogram();
 }
 
+bool GenParticleMonitor::save(std::ostream &out) const
+{
+    return _pdg_id->save(out)
+        && _status->save(out)
+        && _pt->save(out);
+}
+
+bool GenParticleMonitor::load(std::istream &in)
+{
+    return _pdg_id->load(in)
+        && _status->load(in)
+        && _pt->load(in);
+}
+
 uint32_t GenParticleMonitor::id() const
 {
     return core::ID<GenParticleMonitor>::get();
@@ -407,6 +454,26 @@ const H1Ptr JetsMonitor::children() const
     return _children->histogram();
 }
 
+bool JetsMonitor::save(std::ostream &out) const
+{
+    return _multiplicity->save(out)
+        && _pt->save(out)
+        && _uncorrected_pt->save(out)
+        && _leading_pt->save(out)
+        && _leading_uncorrected_pt->save(out)
+        && _children->save(out);
+}
+
+bool JetsMonitor::load(std::istream &in)
+{
+    return _multiplicity->load(in)
+        && _pt->load(in)
+        && _uncorrected_pt->load(in)
+        && _leading_pt->load(in)
+        && _leading_uncorrected_pt->load(in)
+        && _children->load(in);
+}
+
 uint32_t JetsMonitor::id() const
 {
     return core::ID<JetsMonitor>::get();
@@ -534,6 +601,30 @@ const H1Ptr LorentzVectorMonitor::mass() const
     return _mass->histogram();
 }
 
+bool LorentzVectorMonitor::save(std::ostream &out) const
+{
+    return _energy->save(out)
+        && _px->save(out)
+        && _py->save(out)
+        && _pz->save(out)
+        && _pt->save(out)
+        && _eta->save(out)
+        && _phi->save(out)
+        && _mass->save(out);
+}
+
+bool LorentzVectorMonitor::load(std::istream &in)
+{
+    return _energy->load(in)
+        && _px->load(in)
+        && _py->load(in)
+        && _pz->load(in)
+        && _pt->load(in)
+        && _eta->load(in)
+        && _phi->load(in)
+        && _mass->load(in);
+}
+
 uint32_t LorentzVectorMonitor::id() const
 {
     return core::ID<LorentzVectorMonitor>::get();
@@ -611,6 +702,22 @@ const H1Ptr MissingEnergyMonitor::z() const
     return _z->histogram();
 }
 
+bool MissingEnergyMonitor::save(std::ostream &out) const
+{
+    return _pt->save(out)
+        && _x->save(out)
+        && _y->save(out)
+        && _z->save(out);
+}
+
+bool MissingEnergyMonitor::load(std::istream &in)
+{
+    return _pt->load(in)
+        && _x->load(in)
+        && _y->load(in)
+        && _z->load(in);
+}
+
 uint32_t MissingEnergyMonitor::id() const
 {
     return core::ID<MissingEnergyMonitor>::get();
@@ -694,6 +801,20 @@ const H1Ptr MuonsMonitor::leading_pt() const
     return _leading_pt->histogram();
 }
 
+bool MuonsMonitor::save(std::ostream &out) const
+{
+    return _multiplicity->save(out)
+        && _pt->save(out)
+        && _leading_pt->save(out);
+}
+
+bool MuonsMonitor::load(std::istream &in)
+{
+    return _multiplicity->load(in)
+        && _pt->load(in)
+        && _leading_pt->load(in);
+}
+
 uint32_t MuonsMonitor::id() const
 {
     return core::ID<MuonsMonitor>::get();
@@ -776,6 +897,22 @@ const H1Ptr PrimaryVerticesMonitor::z() const
     return _z->histogram();
 }
 
+bool PrimaryVerticesMonitor::save(std::ostream &out) const
+{
+    return _multiplicity->save(out)
+        && _x->save(out)
+        && _y->save(out)
+        && _z->save(out);
+}
+
+bool PrimaryVerticesMonitor::load(std::istream &in)
+{
+    return _multiplicity->load(in)
+        && _x->load(in)
+        && _y->load(in)
+        && _z->load(in);
+}
+
 uint32_t PrimaryVerticesMonitor::id() const
 {
     return core::ID<PrimaryVerticesMonitor>::get();
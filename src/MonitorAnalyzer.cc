@@ -131,6 +131,28 @@ void MonitorAnalyzer::process(const Event *event)
         _missing_energy->fill(event->missing_energy());
 }
 
+bool MonitorAnalyzer::save(std::ostream &out) const
+{
+    return _pf_electrons->save(out)
+        && _gsf_electrons->save(out)
+        && _pf_muons->save(out)
+        && _reco_muons->save(out)
+        && _jets->save(out)
+        && _missing_energy->save(out)
+        && _primary_vertices->save(out);
+}
+
+bool MonitorAnalyzer::load(std::istream &in)
+{
+    return _pf_electrons->load(in)
+        && _gsf_electrons->load(in)
+        && _pf_muons->load(in)
+        && _reco_muons->load(in)
+        && _jets->load(in)
+        && _missing_energy->load(in)
+        && _primary_vertices->load(in);
+}
+
 uint32_t MonitorAnalyzer::id() const
 {
     return core::ID<MonitorAnalyzer>::get();
@@ -22,7 +22,9 @@
 #include "bsm_stat/interface/H1.h"
 #include "interface/Algorithm.h"
 #include "interface/Monitor.h"
+#include "interface/SelectionBatch.h"
 #include "interface/Selector.h"
+#include "interface/StaticSelector.h"
 #include "interface/StatProxy.h"
 #include "interface/Utility.h"
 #include "interface/MttbarAnalyzer.h"
@@ -41,8 +43,9 @@ MttbarAnalyzer::MttbarAnalyzer()
     _el_multiplicity.reset(new MultiplicityCutflow(4));
     _el_monitor.reset(new LorentzVectorMonitor());
 
-    _mu_selector.reset(new MuonSelector());
+    _mu_selector.reset(new StaticMuonSelector());
     _mu_multiplicity.reset(new MultiplicityCutflow(4));
+    _mu_batch.reset(new SelectionBatch());
 
     _wjet_selector.reset(new WJetSelector());
     _wjet_monitor.reset(new LorentzVectorMonitor());
@@ -82,9 +85,10 @@ MttbarAnalyzer::MttbarAnalyzer(const MttbarAnalyzer &object)
         dynamic_pointer_cast<LorentzVectorMonitor>(object._el_monitor->clone());
 
     _mu_selector =
-        dynamic_pointer_cast<MuonSelector>(object._mu_selector->clone());
+        dynamic_pointer_cast<StaticMuonSelector>(object._mu_selector->clone());
     _mu_multiplicity =
         dynamic_pointer_cast<MultiplicityCutflow>(object._mu_multiplicity->clone());
+    _mu_batch.reset(new SelectionBatch());
 
     _wjet_selector =
         dynamic_pointer_cast<WJetSelector>(object._wjet_selector->clone());
@@ -165,6 +169,36 @@ void MttbarAnalyzer::process(const Event *event)
     electrons(event);
 }
 
+bool MttbarAnalyzer::save(std::ostream &out) const
+{
+    return _el_selector->save(out)
+        && _el_multiplicity->save(out)
+        && _el_monitor->save(out)
+        && _mu_selector->save(out)
+        && _mu_multiplicity->save(out)
+        && _wjet_selector->save(out)
+        && _wjet_monitor->save(out)
+        && _ltop_monitor->save(out)
+        && _htop_monitor->save(out)
+        && _top_delta_monitor->save(out)
+        && _mttbar->save(out);
+}
+
+bool MttbarAnalyzer::load(std::istream &in)
+{
+    return _el_selector->load(in)
+        && _el_multiplicity->load(in)
+        && _el_monitor->load(in)
+        && _mu_selector->load(in)
+        && _mu_multiplicity->load(in)
+        && _wjet_selector->load(in)
+        && _wjet_monitor->load(in)
+        && _ltop_monitor->load(in)
+        && _htop_monitor->load(in)
+        && _top_delta_monitor->load(in)
+        && _mttbar->load(in);
+}
+
 uint32_t MttbarAnalyzer::id() const
 {
     return core::ID<MttbarAnalyzer>::get();
@@ -225,20 +259,14 @@ void MttbarAnalyzer::print(std::ostream &out) const
 //
 bool MttbarAnalyzer::muons(const Event *event)
 {
-    typedef ::google::protobuf::RepeatedPtrField<Muon> Muons;
-
-    uint32_t good_muons = 0;
-
     const PrimaryVertex &pv = event->primary_vertices().Get(0);
 
+    // All muons are selected at once
+    //
     LockSelectorEventCounterOnUpdate lock(*_mu_selector);
-    for(Muons::const_iterator muon = event->pf_muons().begin();
-            event->pf_muons().end() != muon;
-            ++muon)
-    {
-        if (_mu_selector->apply(*muon, pv))
-            ++good_muons;
-    }
+    _mu_selector->apply(event->pf_muons(), pv, *_mu_batch);
+
+    const uint32_t good_muons = _mu_batch->passed();
 
     _mu_multiplicity->apply(good_muons);
 
@@ -0,0 +1,142 @@
+// Persistent File
+//
+// File with magic and version header written atomically
+//
+// Copyright 2011, All rights reserved
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+
+#include "interface/PersistentFile.h"
+
+using std::string;
+using std::vector;
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::io::FileInputStream;
+using google::protobuf::io::FileOutputStream;
+
+using bsm::PersistentFile;
+
+static const char *TEMPORARY_SUFFIX = ".tmp.XXXXXX";
+static const char *LOCK_SUFFIX = ".lock";
+
+PersistentFile::Lock::Lock(const PersistentFile &file)
+{
+    const string lock = file.filename() + LOCK_SUFFIX;
+
+    _fd = ::open(lock.c_str(), O_RDWR | O_CREAT, 0644);
+    if (0 > _fd)
+        return;
+
+    if (flock(_fd, LOCK_EX))
+    {
+        ::close(_fd);
+
+        _fd = -1;
+    }
+}
+
+PersistentFile::Lock::~Lock()
+{
+    // Lock is released with the descriptor
+    //
+    if (0 <= _fd)
+        ::close(_fd);
+}
+
+bool PersistentFile::Lock::isLocked() const
+{
+    return 0 <= _fd;
+}
+
+PersistentFile::PersistentFile(const string &filename,
+        const uint32_t &magic,
+        const uint32_t &version):
+    _filename(filename),
+    _magic(magic),
+    _version(version)
+{
+}
+
+string PersistentFile::filename() const
+{
+    return _filename;
+}
+
+bool PersistentFile::load(const BodyReader &read_body) const
+{
+    int fd = ::open(_filename.c_str(), O_RDONLY);
+    if (0 > fd)
+        return false;
+
+    bool result = false;
+    {
+        FileInputStream raw_in(fd);
+        CodedInputStream coded_in(&raw_in);
+
+        uint32_t magic;
+        uint32_t version;
+
+        result = coded_in.ReadLittleEndian32(&magic)
+            && _magic == magic
+            && coded_in.ReadLittleEndian32(&version)
+            && _version == version
+            && read_body(coded_in);
+    }
+
+    ::close(fd);
+
+    return result;
+}
+
+bool PersistentFile::save(const BodyWriter &write_body) const
+{
+    // Temporary name is unique for every writer: jobs and threads sharing
+    // the file write their own copies and the last rename wins
+    //
+    const string name = _filename + TEMPORARY_SUFFIX;
+    vector<char> temporary(name.begin(), name.end());
+    temporary.push_back(0);
+
+    int fd = mkstemp(&temporary[0]);
+    if (0 > fd)
+        return false;
+
+    // mkstemp creates the file readable by the owner only
+    //
+    bool result = !fchmod(fd, 0644);
+    {
+        FileOutputStream raw_out(fd);
+        {
+            CodedOutputStream coded_out(&raw_out);
+
+            coded_out.WriteLittleEndian32(_magic);
+            coded_out.WriteLittleEndian32(_version);
+
+            write_body(coded_out);
+
+            result = !coded_out.HadError() && result;
+        }
+
+        result = raw_out.Close() && result;
+    }
+
+    if (result)
+        result = !rename(&temporary[0], _filename.c_str());
+
+    if (!result)
+        unlink(&temporary[0]);
+
+    return result;
+}
@@ -0,0 +1,110 @@
+// Record Index
+//
+// Byte offsets of the Event records in the bsm_input file
+//
+// Created by Samvel Khalatyan, Jul 28, 2011
+// Copyright 2011, All rights reserved
+
+#include <google/protobuf/io/coded_stream.h>
+
+#include "interface/RecordIndex.h"
+#include "interface/RecordReader.h"
+
+using std::string;
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::io::CodedOutputStream;
+
+using bsm::RecordIndex;
+
+// Sidecar body:
+//
+//  [fixed32]   number of records: N
+//  [fixed64]   record offset x N
+//  [fixed64]   offset right after the last record
+//
+static const uint32_t SIDECAR_MAGIC = 0x42534d49; // BSMI
+static const uint32_t SIDECAR_VERSION = 1;
+
+RecordIndex::RecordIndex(const string &filename):
+    Sidecar(filename, "idx", SIDECAR_MAGIC, SIDECAR_VERSION),
+    _end(0)
+{
+}
+
+bool RecordIndex::scan()
+{
+    clearBody();
+
+    if (!stat())
+        return false;
+
+    RecordReader reader(filename());
+    reader.open();
+    if (!reader.isOpen())
+        return false;
+
+    for(uint64_t offset = reader.tell();
+            reader.skip();
+            offset = reader.tell())
+    {
+        _offsets.push_back(offset);
+    }
+
+    _end = reader.tell();
+
+    return true;
+}
+
+uint32_t RecordIndex::size() const
+{
+    return _offsets.size();
+}
+
+uint64_t RecordIndex::offset(const uint32_t &record) const
+{
+    return record < _offsets.size()
+        ? _offsets[record]
+        : _end;
+}
+
+// Protected
+//
+void RecordIndex::clearBody()
+{
+    _offsets.clear();
+    _end = 0;
+}
+
+bool RecordIndex::readBody(CodedInputStream &coded_in)
+{
+    uint32_t records;
+    if (!coded_in.ReadLittleEndian32(&records))
+        return false;
+
+    _offsets.reserve(records);
+
+    uint64_t offset;
+    for(; records > _offsets.size()
+            && coded_in.ReadLittleEndian64(&offset); )
+    {
+        _offsets.push_back(offset);
+    }
+
+    return records == _offsets.size()
+        && coded_in.ReadLittleEndian64(&_end);
+}
+
+void RecordIndex::writeBody(CodedOutputStream &coded_out) const
+{
+    coded_out.WriteLittleEndian32(_offsets.size());
+
+    for(Offsets::const_iterator offset = _offsets.begin();
+            _offsets.end() != offset;
+            ++offset)
+    {
+        coded_out.WriteLittleEndian64(*offset);
+    }
+
+    coded_out.WriteLittleEndian64(_end);
+}
@@ -0,0 +1,290 @@
+// Record Reader
+//
+// Read Event records from an arbitrary part of the bsm_input file
+//
+// Created by Samvel Khalatyan, Jul 28, 2011
+// Copyright 2011, All rights reserved
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "bsm_input/interface/Input.pb.h"
+#include "interface/RecordReader.h"
+#include "interface/UringInputStream.h"
+
+using std::string;
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::io::FileInputStream;
+
+using bsm::RecordReader;
+using bsm::UringInputStream;
+
+const uint64_t RecordReader::HEADER_SIZE;
+
+RecordReader::RecordReader(const string &filename):
+    _filename(filename),
+    _fd(-1),
+    _begin(0),
+    _end(0),
+    _position(0),
+    _limit(0),
+    _use_uring(false),
+    _had_error(false)
+{
+}
+
+RecordReader::~RecordReader()
+{
+    close();
+}
+
+void RecordReader::open()
+{
+    if (isOpen())
+        return;
+
+    _fd = ::open(_filename.c_str(), O_RDONLY);
+    if (0 > _fd)
+        return;
+
+    if (!readHeader()
+            || !readInput()
+            || !seek(_begin))
+        close();
+}
+
+void RecordReader::close()
+{
+    _raw_in.reset();
+
+    if (isOpen())
+    {
+        ::close(_fd);
+
+        _fd = -1;
+    }
+
+    _input.reset();
+}
+
+bool RecordReader::isOpen() const
+{
+    return 0 <= _fd;
+}
+
+string RecordReader::filename() const
+{
+    return _filename;
+}
+
+RecordReader::InputPtr RecordReader::input() const
+{
+    return _input;
+}
+
+uint64_t RecordReader::begin() const
+{
+    return _begin;
+}
+
+uint64_t RecordReader::end() const
+{
+    return _end;
+}
+
+bool RecordReader::seek(const uint64_t &offset, const uint64_t &limit)
+{
+    if (!isOpen()
+            || _begin > offset
+            || _end < offset
+            || _end < limit)
+        return false;
+
+    // Streams buffer data and can not be repositioned: start a new one.
+    // Reads of the previous stream are finished first
+    //
+    _raw_in.reset();
+
+    _position = offset;
+    _limit = limit ? limit : _end;
+    _had_error = false;
+
+    if (_use_uring)
+    {
+        boost::shared_ptr<UringInputStream> raw_in(
+                new UringInputStream(_fd, _position, _limit));
+
+        if (!raw_in->hadError())
+        {
+            _raw_in = raw_in;
+
+            return true;
+        }
+    }
+
+    if (static_cast<off_t>(offset) != lseek(_fd, offset, SEEK_SET))
+        return false;
+
+    _raw_in.reset(new FileInputStream(_fd));
+
+    return true;
+}
+
+uint64_t RecordReader::tell() const
+{
+    return _position;
+}
+
+void RecordReader::use(const EventFields &fields)
+{
+    _fields = fields;
+}
+
+bool RecordReader::hadError() const
+{
+    return _had_error;
+}
+
+void RecordReader::useUring(const bool &use)
+{
+    _use_uring = use;
+}
+
+bool RecordReader::read(EventPtr &event)
+{
+    uint32_t size;
+    if (!readSize(size))
+        return false;
+
+    // Record is parsed straight from the stream: only used fields are
+    // copied
+    //
+    CodedInputStream coded_in(_raw_in.get());
+    if (!_fields.parse(coded_in, size, *event, _buffer))
+        return fail();
+
+    _position += size;
+
+    return true;
+}
+
+bool RecordReader::read(string &record)
+{
+    uint32_t size;
+    if (!readSize(size))
+        return false;
+
+    CodedInputStream coded_in(_raw_in.get());
+    if (!coded_in.ReadString(&record, size))
+        return fail();
+
+    _position += size;
+
+    return true;
+}
+
+bool RecordReader::skip()
+{
+    uint32_t size;
+    if (!readSize(size))
+        return false;
+
+    CodedInputStream coded_in(_raw_in.get());
+    if (!coded_in.Skip(size))
+        return fail();
+
+    _position += size;
+
+    return true;
+}
+
+// Private
+//
+bool RecordReader::readHeader()
+{
+    struct stat file_stat;
+    if (fstat(_fd, &file_stat))
+        return false;
+
+    FileInputStream raw_in(_fd);
+    CodedInputStream coded_in(&raw_in);
+
+    uint32_t version;
+    uint64_t input_position;
+    if (!coded_in.ReadLittleEndian32(&version)
+            || !coded_in.ReadLittleEndian64(&input_position))
+        return false;
+
+    _begin = HEADER_SIZE;
+    _end = input_position
+        ? input_position
+        : static_cast<uint64_t>(file_stat.st_size);
+
+    return _begin <= _end
+        && static_cast<uint64_t>(file_stat.st_size) >= _end;
+}
+
+bool RecordReader::readInput()
+{
+    _input.reset(new Input());
+
+    // Input was not written: file is still usable but carries no
+    // information about triggers, etc.
+    //
+    struct stat file_stat;
+    if (fstat(_fd, &file_stat)
+            || static_cast<uint64_t>(file_stat.st_size) == _end)
+        return true;
+
+    if (static_cast<off_t>(_end) != lseek(_fd, _end, SEEK_SET))
+        return false;
+
+    FileInputStream raw_in(_fd);
+    CodedInputStream coded_in(&raw_in);
+
+    uint32_t size;
+    if (!coded_in.ReadVarint32(&size))
+        return false;
+
+    const CodedInputStream::Limit limit = coded_in.PushLimit(size);
+    if (!_input->ParseFromCodedStream(&coded_in))
+        return false;
+    coded_in.PopLimit(limit);
+
+    return true;
+}
+
+bool RecordReader::fail()
+{
+    _limit = _position;
+    _had_error = true;
+
+    return false;
+}
+
+bool RecordReader::readSize(uint32_t &size)
+{
+    if (!_raw_in
+            || _position >= _limit)
+        return false;
+
+    CodedInputStream coded_in(_raw_in.get());
+    if (!coded_in.ReadVarint32(&size))
+        return fail();
+
+    _position += CodedOutputStream::VarintSize32(size);
+
+    // Record may not cross the limit
+    //
+    if (_position + size > _limit)
+        return fail();
+
+    return true;
+}
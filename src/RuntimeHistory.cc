@@ -0,0 +1,183 @@
+// Runtime History
+//
+// Processing time of the inputs measured by earlier jobs
+//
+// Copyright 2011, All rights reserved
+
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+
+#include <google/protobuf/io/coded_stream.h>
+
+#include "interface/RuntimeHistory.h"
+
+using std::make_pair;
+using std::string;
+
+using bsm::InputChunk;
+using bsm::RuntimeHistory;
+
+// History file format:
+//
+//  [fixed32]   magic
+//  [fixed32]   version
+//  [fixed32]   number of inputs: N
+//  N x {
+//      [varint32]  file name size
+//      [bytes]     file name
+//      [fixed64]   chunk begin
+//      [fixed64]   chunk end
+//      [fixed64]   input size in bytes
+//      [fixed64]   processing time in microseconds
+//  }
+//
+static const uint32_t HISTORY_MAGIC = 0x42534d48; // BSMH
+static const uint32_t HISTORY_VERSION = 1;
+
+RuntimeHistory::RuntimeHistory(const string &filename):
+    _file(filename, HISTORY_MAGIC, HISTORY_VERSION)
+{
+}
+
+string RuntimeHistory::filename() const
+{
+    return _file.filename();
+}
+
+bool RuntimeHistory::load()
+{
+    _runtimes.clear();
+    _measured.clear();
+
+    const bool result = _file.load(boost::bind(&RuntimeHistory::readBody,
+                _1, boost::ref(_runtimes)));
+
+    if (!result)
+        _runtimes.clear();
+
+    return result;
+}
+
+bool RuntimeHistory::save() const
+{
+    PersistentFile::Lock lock(_file);
+    if (!lock.isLocked())
+        return false;
+
+    // Missing or broken history is replaced with the measured inputs
+    //
+    Runtimes runtimes;
+    if (!_file.load(boost::bind(&RuntimeHistory::readBody,
+                _1, boost::ref(runtimes))))
+        runtimes.clear();
+
+    for(Inputs::const_iterator input = _measured.begin();
+            _measured.end() != input;
+            ++input)
+    {
+        runtimes[*input] = _runtimes.find(*input)->second;
+    }
+
+    return _file.save(boost::bind(&RuntimeHistory::writeBody,
+                _1, boost::cref(runtimes)));
+}
+
+void RuntimeHistory::add(const InputChunk &input,
+        const uint64_t &bytes,
+        const double &seconds)
+{
+    Runtime runtime;
+    runtime.bytes = bytes;
+    runtime.microseconds = static_cast<uint64_t>(seconds * 1e6);
+
+    _runtimes[key(input)] = runtime;
+    _measured.insert(key(input));
+}
+
+bool RuntimeHistory::runtime(const InputChunk &input,
+        const uint64_t &bytes,
+        double &seconds) const
+{
+    Runtimes::const_iterator runtime = _runtimes.find(key(input));
+    if (_runtimes.end() == runtime
+            || bytes != runtime->second.bytes)
+        return false;
+
+    seconds = runtime->second.microseconds / 1e6;
+
+    return true;
+}
+
+double RuntimeHistory::rate() const
+{
+    uint64_t bytes = 0;
+    uint64_t microseconds = 0;
+    for(Runtimes::const_iterator runtime = _runtimes.begin();
+            _runtimes.end() != runtime;
+            ++runtime)
+    {
+        bytes += runtime->second.bytes;
+        microseconds += runtime->second.microseconds;
+    }
+
+    return bytes
+        ? microseconds / 1e6 / bytes
+        : 0;
+}
+
+uint32_t RuntimeHistory::size() const
+{
+    return _runtimes.size();
+}
+
+// Private
+//
+RuntimeHistory::Input RuntimeHistory::key(const InputChunk &input) const
+{
+    return make_pair(input.file_name, make_pair(input.begin, input.end));
+}
+
+bool RuntimeHistory::readBody(CodedInputStream &coded_in, Runtimes &runtimes)
+{
+    uint32_t inputs;
+    if (!coded_in.ReadLittleEndian32(&inputs))
+        return false;
+
+    uint32_t size;
+    string file_name;
+    uint64_t begin;
+    uint64_t end;
+    Runtime runtime;
+    for(; inputs > runtimes.size()
+            && coded_in.ReadVarint32(&size)
+            && coded_in.ReadString(&file_name, size)
+            && coded_in.ReadLittleEndian64(&begin)
+            && coded_in.ReadLittleEndian64(&end)
+            && coded_in.ReadLittleEndian64(&runtime.bytes)
+            && coded_in.ReadLittleEndian64(&runtime.microseconds); )
+    {
+        runtimes[make_pair(file_name, make_pair(begin, end))] = runtime;
+    }
+
+    return inputs == runtimes.size();
+}
+
+void RuntimeHistory::writeBody(CodedOutputStream &coded_out,
+        const Runtimes &runtimes)
+{
+    coded_out.WriteLittleEndian32(runtimes.size());
+
+    for(Runtimes::const_iterator runtime = runtimes.begin();
+            runtimes.end() != runtime;
+            ++runtime)
+    {
+        const Input &input = runtime->first;
+
+        coded_out.WriteVarint32(input.first.size());
+        coded_out.WriteString(input.first);
+        coded_out.WriteLittleEndian64(input.second.first);
+        coded_out.WriteLittleEndian64(input.second.second);
+        coded_out.WriteLittleEndian64(runtime->second.bytes);
+        coded_out.WriteLittleEndian64(runtime->second.microseconds);
+    }
+}
@@ -0,0 +1,149 @@
+// Selection Batch
+//
+// Objects of one collection selected at once
+//
+// Copyright 2011, All rights reserved
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <new>
+
+#include "interface/SelectionBatch.h"
+
+using bsm::SelectionBatch;
+
+// Enough for aligned loads of WIDTH floats
+//
+static const uint32_t BATCH_ALIGNMENT = 16;
+
+SelectionBatch::SelectionBatch():
+    _size(0),
+    _padded_size(0),
+    _columns(0),
+    _capacity(0),
+    _data(0)
+{
+}
+
+SelectionBatch::~SelectionBatch()
+{
+    free(_data);
+}
+
+void SelectionBatch::reset(const uint32_t &size, const uint32_t &columns)
+{
+    _size = size;
+    _padded_size = (size + WIDTH - 1) / WIDTH * WIDTH;
+    _columns = columns;
+
+    if (!_padded_size)
+        return;
+
+    // Mask is stored after the last column
+    //
+    const uint32_t capacity = _padded_size * (_columns + 1);
+    if (capacity > _capacity)
+    {
+        free(_data);
+        _data = 0;
+        _capacity = 0;
+
+        void *data = 0;
+        if (posix_memalign(&data, BATCH_ALIGNMENT, capacity * sizeof(float)))
+            throw std::bad_alloc();
+
+        _data = static_cast<float *>(data);
+        _capacity = capacity;
+    }
+
+    // Padding is zero in all columns: no garbage floats are compared
+    //
+    for(uint32_t column = 0; _columns > column; ++column)
+    {
+        float *values = this->column(column);
+        for(uint32_t object = _size; _padded_size > object; ++object)
+        {
+            values[object] = 0;
+        }
+    }
+
+    uint32_t *mask = this->mask();
+    memset(mask, 0xff, _size * sizeof(uint32_t));
+    memset(mask + _size, 0, (_padded_size - _size) * sizeof(uint32_t));
+}
+
+uint32_t SelectionBatch::size() const
+{
+    return _size;
+}
+
+uint32_t SelectionBatch::paddedSize() const
+{
+    return _padded_size;
+}
+
+uint32_t SelectionBatch::columns() const
+{
+    return _columns;
+}
+
+float *SelectionBatch::column(const uint32_t &column)
+{
+    return _data + column * _padded_size;
+}
+
+const float *SelectionBatch::column(const uint32_t &column) const
+{
+    return _data + column * _padded_size;
+}
+
+uint32_t *SelectionBatch::mask()
+{
+    return reinterpret_cast<uint32_t *>(_data + _columns * _padded_size);
+}
+
+const uint32_t *SelectionBatch::mask() const
+{
+    return reinterpret_cast<const uint32_t *>(_data + _columns * _padded_size);
+}
+
+bool SelectionBatch::isPass(const uint32_t &object) const
+{
+    return mask()[object];
+}
+
+void SelectionBatch::reject(const uint32_t &object)
+{
+    for(uint32_t column = 0; _columns > column; ++column)
+    {
+        this->column(column)[object] = 0;
+    }
+
+    mask()[object] = 0;
+}
+
+uint32_t SelectionBatch::passed() const
+{
+    const uint32_t *mask = this->mask();
+
+    uint32_t passed = 0;
+    for(uint32_t object = 0; _padded_size > object; ++object)
+    {
+        passed += mask[object] & 1;
+    }
+
+    return passed;
+}
+
+void SelectionBatch::indices(Indices &indices) const
+{
+    indices.clear();
+
+    const uint32_t *mask = this->mask();
+    for(uint32_t object = 0; _size > object; ++object)
+    {
+        if (mask[object])
+            indices.push_back(object);
+    }
+}
@@ -8,6 +8,7 @@
 #include <cmath>
 #include <functional>
 #include <iomanip>
+#include <istream>
 #include <ostream>
 
 #include <boost/pointer_cast.hpp>
@@ -20,7 +21,10 @@
 #include "bsm_input/interface/Physics.pb.h"
 #include "bsm_input/interface/PrimaryVertex.pb.h"
 #include "interface/Cut.h"
+#include "interface/EventColumns.h"
+#include "interface/SelectionBatch.h"
 #include "interface/Selector.h"
+#include "interface/StaticSelector.h"
 #include "interface/Utility.h"
 
 using std::endl;
@@ -33,21 +37,71 @@ using std::setfill;
 using boost::dynamic_pointer_cast;
 
 using bsm::CutPtr;
+using bsm::ElectronView;
+using bsm::EventView;
+using bsm::JetView;
+using bsm::MuonView;
+using bsm::PrimaryVertexView;
 using bsm::ElectronSelector;
 using bsm::JetSelector;
 using bsm::MultiplicityCutflow;
 using bsm::MuonSelector;
 using bsm::PrimaryVertexSelector;
+using bsm::SelectionBatch;
+using bsm::StaticElectronSelector;
+using bsm::StaticJetSelector;
+using bsm::StaticMuonSelector;
 using bsm::WJetSelector;
 using bsm::LockSelectorEventCounterOnUpdate;
 
+// Default cuts: selectors and their static versions are set up from the
+// same values
+//
+struct CutDefault
+{
+    float value;
+    const char *name;
+};
+
+static const CutDefault ELECTRON_ET_CUT = { 30, "Et" };
+static const CutDefault ELECTRON_ETA_CUT = { 2.5, "|eta|" };
+static const CutDefault ELECTRON_PRIMARY_VERTEX_CUT = { 1, "|el.z() - pv.z()|" };
+
+static const CutDefault JET_PT_CUT = { 50, "Pt" };
+static const CutDefault JET_ETA_CUT = { 2.4, "|eta|" };
+
+static const CutDefault MUON_PT_CUT = { 30, "pT" };
+static const CutDefault MUON_ETA_CUT = { 2.1, "|eta|" };
+static const CutDefault MUON_IS_GLOBAL_CUT = { true, "is Global" };
+static const CutDefault MUON_IS_TRACKER_CUT = { true, "is Tracker" };
+static const CutDefault MUON_SEGMENTS_CUT = { 1, "Muon Segments" };
+static const CutDefault MUON_HITS_CUT = { 0, "Muon Hits" };
+static const CutDefault MUON_NORMALIZED_CHI2_CUT = { 10, "Muon Chi2 / ndof" };
+static const CutDefault MUON_TRACKER_HITS_CUT = { 10, "Tracker hits" };
+static const CutDefault MUON_PIXEL_HITS_CUT = { 0, "Pixel hits" };
+static const CutDefault MUON_D0_BSP_CUT = { 0.02, "|d0_bsp|" };
+static const CutDefault MUON_PRIMARY_VERTEX_CUT = { 1, "|mu.z() - pv.z()|" };
+
+template<class Compare>
+    CutPtr createCut(const CutDefault &cut_default)
+{
+    return CutPtr(new bsm::Comparator<Compare>(cut_default.value,
+                cut_default.name));
+}
+
+static void setDefault(bsm::ChainCut &cut, const CutDefault &cut_default)
+{
+    cut.setValue(cut_default.value);
+    cut.setName(cut_default.name);
+}
+
 // ElectronSelector
 //
 ElectronSelector::ElectronSelector()
 {
-    _et.reset(new Comparator<>(30, "Et"));
-    _eta.reset(new Comparator<std::less<float> >(2.5, "|eta|"));
-    _primary_vertex.reset(new Comparator<std::less<float> >(1, "|el.z() - pv.z()|"));
+    _et = createCut<std::greater<float> >(ELECTRON_ET_CUT);
+    _eta = createCut<std::less<float> >(ELECTRON_ETA_CUT);
+    _primary_vertex = createCut<std::less<float> >(ELECTRON_PRIMARY_VERTEX_CUT);
 
     monitor(_et);
     monitor(_eta);
@@ -73,6 +127,16 @@ bool ElectronSelector::apply(const Electron &electron, const PrimaryVertex &pv)
                     - pv.vertex().z()));
 }
 
+bool ElectronSelector::apply(const ElectronView &electron,
+        const PrimaryVertexView &pv)
+{
+    const LorentzVector p4 = electron.p4();
+
+    return _et->apply(bsm::et(p4))
+        && _eta->apply(fabs(bsm::eta(p4)))
+        && _primary_vertex->apply(fabs(electron.vertexZ() - pv.z()));
+}
+
 CutPtr ElectronSelector::et() const
 {
     return _et;
@@ -102,6 +166,20 @@ void ElectronSelector::disable()
     primary_vertex()->disable();
 }
 
+bool ElectronSelector::save(std::ostream &out) const
+{
+    return _et->save(out)
+        && _eta->save(out)
+        && _primary_vertex->save(out);
+}
+
+bool ElectronSelector::load(std::istream &in)
+{
+    return _et->load(in)
+        && _eta->load(in)
+        && _primary_vertex->load(in);
+}
+
 uint32_t ElectronSelector::id() const
 {
     return core::ID<ElectronSelector>::get();
@@ -124,12 +202,172 @@ void ElectronSelector::print(std::ostream &out) const
 
 
 
+// Static Electron Selector
+//
+StaticElectronSelector::StaticElectronSelector()
+{
+    setDefault(et(), ELECTRON_ET_CUT);
+    setDefault(eta(), ELECTRON_ETA_CUT);
+    setDefault(primary_vertex(), ELECTRON_PRIMARY_VERTEX_CUT);
+}
+
+StaticElectronSelector::StaticElectronSelector(
+        const StaticElectronSelector &object):
+    _cuts(object._cuts)
+{
+}
+
+bool StaticElectronSelector::apply(const Electron &electron,
+        const PrimaryVertex &pv)
+{
+    return _cuts.apply<ET>(bsm::et(electron.physics_object().p4()))
+        && _cuts.apply<ETA>(fabs(bsm::eta(electron.physics_object().p4())))
+        && _cuts.apply<PRIMARY_VERTEX>(fabs(electron.physics_object().vertex().z()
+                    - pv.vertex().z()));
+}
+
+bool StaticElectronSelector::apply(const ElectronView &electron,
+        const PrimaryVertexView &pv)
+{
+    const LorentzVector p4 = electron.p4();
+
+    return _cuts.apply<ET>(bsm::et(p4))
+        && _cuts.apply<ETA>(fabs(bsm::eta(p4)))
+        && _cuts.apply<PRIMARY_VERTEX>(fabs(electron.vertexZ() - pv.z()));
+}
+
+void StaticElectronSelector::apply(const Electrons &electrons,
+        const PrimaryVertex &pv,
+        SelectionBatch &batch)
+{
+    batch.reset(electrons.size(), Cuts::size);
+
+    for(uint32_t object = 0, size = electrons.size(); size > object; ++object)
+    {
+        const Electron &electron = electrons.Get(object);
+
+        batch.column(ET)[object] = bsm::et(electron.physics_object().p4());
+        batch.column(ETA)[object] =
+            fabs(bsm::eta(electron.physics_object().p4()));
+        batch.column(PRIMARY_VERTEX)[object] =
+            fabs(electron.physics_object().vertex().z() - pv.vertex().z());
+    }
+
+    select(batch);
+}
+
+void StaticElectronSelector::apply(const EventView &event,
+        const PrimaryVertexView &pv,
+        SelectionBatch &batch)
+{
+    batch.reset(event.electrons(), Cuts::size);
+
+    for(uint32_t object = 0, size = event.electrons(); size > object; ++object)
+    {
+        const ElectronView electron = event.electron(object);
+        const LorentzVector p4 = electron.p4();
+
+        batch.column(ET)[object] = bsm::et(p4);
+        batch.column(ETA)[object] = fabs(bsm::eta(p4));
+        batch.column(PRIMARY_VERTEX)[object] =
+            fabs(electron.vertexZ() - pv.z());
+    }
+
+    select(batch);
+}
+
+StaticElectronSelector::Chain &StaticElectronSelector::cuts()
+{
+    return _cuts;
+}
+
+bsm::ChainCut &StaticElectronSelector::et()
+{
+    return _cuts.cut<ET>();
+}
+
+bsm::ChainCut &StaticElectronSelector::eta()
+{
+    return _cuts.cut<ETA>();
+}
+
+bsm::ChainCut &StaticElectronSelector::primary_vertex()
+{
+    return _cuts.cut<PRIMARY_VERTEX>();
+}
+
+void StaticElectronSelector::enable()
+{
+    _cuts.enable();
+}
+
+void StaticElectronSelector::disable()
+{
+    _cuts.disable();
+}
+
+bool StaticElectronSelector::save(std::ostream &out) const
+{
+    return _cuts.save(out);
+}
+
+bool StaticElectronSelector::load(std::istream &in)
+{
+    return _cuts.load(in);
+}
+
+uint32_t StaticElectronSelector::id() const
+{
+    return core::ID<StaticElectronSelector>::get();
+}
+
+StaticElectronSelector::ObjectPtr StaticElectronSelector::clone() const
+{
+    return ObjectPtr(new StaticElectronSelector(*this));
+}
+
+void StaticElectronSelector::merge(const ObjectPtr &object_pointer)
+{
+    if (id() != object_pointer->id())
+        return;
+
+    boost::shared_ptr<StaticElectronSelector> object =
+        dynamic_pointer_cast<StaticElectronSelector>(object_pointer);
+
+    if (!object)
+        return;
+
+    _cuts.merge(object->_cuts);
+
+    Object::merge(object_pointer);
+}
+
+void StaticElectronSelector::print(std::ostream &out) const
+{
+    out << "     CUT                 " << setw(5) << " "
+        << " Objects Events" << endl;
+    out << setw(45) << setfill('-') << left << " " << setfill(' ') << endl;
+
+    _cuts.print(out);
+}
+
+// Private
+//
+void StaticElectronSelector::select(SelectionBatch &batch)
+{
+    _cuts.apply<ET>(batch, ET);
+    _cuts.apply<ETA>(batch, ETA);
+    _cuts.apply<PRIMARY_VERTEX>(batch, PRIMARY_VERTEX);
+}
+
+
+
 // JetSelector
 //
 JetSelector::JetSelector()
 {
-    _pt.reset(new Comparator<>(50, "Pt"));
-    _eta.reset(new Comparator<std::less<float> >(2.4, "|eta|"));
+    _pt = createCut<std::greater<float> >(JET_PT_CUT);
+    _eta = createCut<std::less<float> >(JET_ETA_CUT);
 
     monitor(_pt);
     monitor(_eta);
@@ -150,6 +388,14 @@ bool JetSelector::apply(const Jet &jet)
         && _eta->apply(fabs(bsm::eta(jet.physics_object().p4())));
 }
 
+bool JetSelector::apply(const JetView &jet)
+{
+    const LorentzVector p4 = jet.p4();
+
+    return _pt->apply(bsm::pt(p4))
+        && _eta->apply(fabs(bsm::eta(p4)));
+}
+
 CutPtr JetSelector::pt() const
 {
     return _pt;
@@ -172,6 +418,18 @@ void JetSelector::disable()
     eta()->disable();
 }
 
+bool JetSelector::save(std::ostream &out) const
+{
+    return _pt->save(out)
+        && _eta->save(out);
+}
+
+bool JetSelector::load(std::istream &in)
+{
+    return _pt->load(in)
+        && _eta->load(in);
+}
+
 uint32_t JetSelector::id() const
 {
     return core::ID<JetSelector>::get();
@@ -193,6 +451,143 @@ void JetSelector::print(std::ostream &out) const
 
 
 
+// Static Jet Selector
+//
+StaticJetSelector::StaticJetSelector()
+{
+    setDefault(pt(), JET_PT_CUT);
+    setDefault(eta(), JET_ETA_CUT);
+}
+
+StaticJetSelector::StaticJetSelector(const StaticJetSelector &object):
+    _cuts(object._cuts)
+{
+}
+
+bool StaticJetSelector::apply(const Jet &jet)
+{
+    return _cuts.apply<PT>(bsm::pt(jet.physics_object().p4()))
+        && _cuts.apply<ETA>(fabs(bsm::eta(jet.physics_object().p4())));
+}
+
+bool StaticJetSelector::apply(const JetView &jet)
+{
+    const LorentzVector p4 = jet.p4();
+
+    return _cuts.apply<PT>(bsm::pt(p4))
+        && _cuts.apply<ETA>(fabs(bsm::eta(p4)));
+}
+
+void StaticJetSelector::apply(const Jets &jets, SelectionBatch &batch)
+{
+    batch.reset(jets.size(), Cuts::size);
+
+    for(uint32_t object = 0, size = jets.size(); size > object; ++object)
+    {
+        const Jet &jet = jets.Get(object);
+
+        batch.column(PT)[object] = bsm::pt(jet.physics_object().p4());
+        batch.column(ETA)[object] = fabs(bsm::eta(jet.physics_object().p4()));
+    }
+
+    select(batch);
+}
+
+void StaticJetSelector::apply(const EventView &event, SelectionBatch &batch)
+{
+    batch.reset(event.jets(), Cuts::size);
+
+    for(uint32_t object = 0, size = event.jets(); size > object; ++object)
+    {
+        const LorentzVector p4 = event.jet(object).p4();
+
+        batch.column(PT)[object] = bsm::pt(p4);
+        batch.column(ETA)[object] = fabs(bsm::eta(p4));
+    }
+
+    select(batch);
+}
+
+StaticJetSelector::Chain &StaticJetSelector::cuts()
+{
+    return _cuts;
+}
+
+bsm::ChainCut &StaticJetSelector::pt()
+{
+    return _cuts.cut<PT>();
+}
+
+bsm::ChainCut &StaticJetSelector::eta()
+{
+    return _cuts.cut<ETA>();
+}
+
+void StaticJetSelector::enable()
+{
+    _cuts.enable();
+}
+
+void StaticJetSelector::disable()
+{
+    _cuts.disable();
+}
+
+bool StaticJetSelector::save(std::ostream &out) const
+{
+    return _cuts.save(out);
+}
+
+bool StaticJetSelector::load(std::istream &in)
+{
+    return _cuts.load(in);
+}
+
+uint32_t StaticJetSelector::id() const
+{
+    return core::ID<StaticJetSelector>::get();
+}
+
+StaticJetSelector::ObjectPtr StaticJetSelector::clone() const
+{
+    return ObjectPtr(new StaticJetSelector(*this));
+}
+
+void StaticJetSelector::merge(const ObjectPtr &object_pointer)
+{
+    if (id() != object_pointer->id())
+        return;
+
+    boost::shared_ptr<StaticJetSelector> object =
+        dynamic_pointer_cast<StaticJetSelector>(object_pointer);
+
+    if (!object)
+        return;
+
+    _cuts.merge(object->_cuts);
+
+    Object::merge(object_pointer);
+}
+
+void StaticJetSelector::print(std::ostream &out) const
+{
+    out << "     CUT                 " << setw(5) << " "
+        << " Objects Events" << endl;
+    out << setw(45) << setfill('-') << left << " " << setfill(' ') << endl;
+
+    _cuts.print(out);
+}
+
+// Private
+//
+void StaticJetSelector::select(SelectionBatch &batch)
+{
+    _cuts.apply<PT>(batch, PT);
+    _cuts.apply<ETA>(batch, ETA);
+}
+
+
+
 // Multiplicity Cutflow
 //
 MultiplicityCutflow::MultiplicityCutflow(const uint32_t &max)
@@ -261,6 +656,32 @@ void MultiplicityCutflow::disable()
     }
 }
 
+bool MultiplicityCutflow::save(std::ostream &out) const
+{
+    for(Cuts::const_iterator cut = _cuts.begin();
+            _cuts.end() != cut;
+            ++cut)
+    {
+        if (!(*cut)->save(out))
+            return false;
+    }
+
+    return true;
+}
+
+bool MultiplicityCutflow::load(std::istream &in)
+{
+    for(Cuts::const_iterator cut = _cuts.begin();
+            _cuts.end() != cut;
+            ++cut)
+    {
+        if (!(*cut)->load(in))
+            return false;
+    }
+
+    return true;
+}
+
 uint32_t MultiplicityCutflow::id() const
 {
     return core::ID<MultiplicityCutflow>::get();
@@ -289,17 +710,17 @@ void MultiplicityCutflow::print(std::ostream &out) const
 //
 MuonSelector::MuonSelector()
 {
-    _pt.reset(new Comparator<>(30, "pT"));
-    _eta.reset(new Comparator<std::less<float> >(2.1, "|eta|"));
-    _is_global.reset(new Comparator<std::logical_and<bool> >(true, "is Global"));
-    _is_tracker.reset(new Comparator<std::logical_and<bool> >(true, "is Tracker"));
-    _muon_segments.reset(new Comparator<>(1, "Muon Segments"));
-    _muon_hits.reset(new Comparator<>(0, "Muon Hits"));
-    _muon_normalized_chi2.reset(new Comparator<std::less<float> >(10, "Muon Chi2 / ndof"));
-    _tracker_hits.reset(new Comparator<>(10, "Tracker hits"));
-    _pixel_hits.reset(new Comparator<>(0, "Pixel hits"));
-    _d0_bsp.reset(new Comparator<std::less<float> >(0.02, "|d0_bsp|"));
-    _primary_vertex.reset(new Comparator<std::less<float> >(1, "|mu.z() - pv.z()|"));
+    _pt = createCut<std::greater<float> >(MUON_PT_CUT);
+    _eta = createCut<std::less<float> >(MUON_ETA_CUT);
+    _is_global = createCut<std::logical_and<bool> >(MUON_IS_GLOBAL_CUT);
+    _is_tracker = createCut<std::logical_and<bool> >(MUON_IS_TRACKER_CUT);
+    _muon_segments = createCut<std::greater<float> >(MUON_SEGMENTS_CUT);
+    _muon_hits = createCut<std::greater<float> >(MUON_HITS_CUT);
+    _muon_normalized_chi2 = createCut<std::less<float> >(MUON_NORMALIZED_CHI2_CUT);
+    _tracker_hits = createCut<std::greater<float> >(MUON_TRACKER_HITS_CUT);
+    _pixel_hits = createCut<std::greater<float> >(MUON_PIXEL_HITS_CUT);
+    _d0_bsp = createCut<std::less<float> >(MUON_D0_BSP_CUT);
+    _primary_vertex = createCut<std::less<float> >(MUON_PRIMARY_VERTEX_CUT);
 
     monitor(_pt);
     monitor(_eta);
@@ -357,6 +778,26 @@ bool MuonSelector::apply(const Muon &muon, const PrimaryVertex &pv)
         && _primary_vertex->apply(fabs(muon.physics_object().vertex().z() - pv.vertex().z()));
 }
 
+bool MuonSelector::apply(const MuonView &muon, const PrimaryVertexView &pv)
+{
+    if (!muon.hasExtra())
+        return false;
+
+    const LorentzVector p4 = muon.p4();
+
+    return _pt->apply(bsm::pt(p4))
+        && _eta->apply(fabs(bsm::eta(p4)))
+        && _is_global->apply(muon.isGlobal())
+        && _is_tracker->apply(muon.isTracker())
+        && _muon_segments->apply(muon.numberOfMatches())
+        && _muon_hits->apply(muon.globalTrackHits())
+        && _muon_normalized_chi2->apply(muon.globalTrackNormalizedChi2())
+        && _tracker_hits->apply(muon.innerTrackHits())
+        && _pixel_hits->apply(muon.pixelHits())
+        && _d0_bsp->apply(fabs(muon.d0Bsp()))
+        && _primary_vertex->apply(fabs(muon.vertexZ() - pv.z()));
+}
+
 CutPtr MuonSelector::pt() const
 {
     return _pt;
@@ -442,6 +883,36 @@ void MuonSelector::disable()
     primary_vertex()->disable();
 }
 
+bool MuonSelector::save(std::ostream &out) const
+{
+    return _pt->save(out)
+        && _eta->save(out)
+        && _is_global->save(out)
+        && _is_tracker->save(out)
+        && _muon_segments->save(out)
+        && _muon_hits->save(out)
+        && _muon_normalized_chi2->save(out)
+        && _tracker_hits->save(out)
+        && _pixel_hits->save(out)
+        && _d0_bsp->save(out)
+        && _primary_vertex->save(out);
+}
+
+bool MuonSelector::load(std::istream &in)
+{
+    return _pt->load(in)
+        && _eta->load(in)
+        && _is_global->load(in)
+        && _is_tracker->load(in)
+        && _muon_segments->load(in)
+        && _muon_hits->load(in)
+        && _muon_normalized_chi2->load(in)
+        && _tracker_hits->load(in)
+        && _pixel_hits->load(in)
+        && _d0_bsp->load(in)
+        && _primary_vertex->load(in);
+}
+
 uint32_t MuonSelector::id() const
 {
     return core::ID<MuonSelector>::get();
@@ -472,6 +943,270 @@ void MuonSelector::print(std::ostream &out) const
 
 
 
+// Static Muon Selector
+//
+StaticMuonSelector::StaticMuonSelector()
+{
+    setDefault(pt(), MUON_PT_CUT);
+    setDefault(eta(), MUON_ETA_CUT);
+    setDefault(is_global(), MUON_IS_GLOBAL_CUT);
+    setDefault(is_tracker(), MUON_IS_TRACKER_CUT);
+    setDefault(muon_segments(), MUON_SEGMENTS_CUT);
+    setDefault(muon_hits(), MUON_HITS_CUT);
+    setDefault(muon_normalized_chi2(), MUON_NORMALIZED_CHI2_CUT);
+    setDefault(tracker_hits(), MUON_TRACKER_HITS_CUT);
+    setDefault(pixel_hits(), MUON_PIXEL_HITS_CUT);
+    setDefault(d0_bsp(), MUON_D0_BSP_CUT);
+    setDefault(primary_vertex(), MUON_PRIMARY_VERTEX_CUT);
+}
+
+StaticMuonSelector::StaticMuonSelector(const StaticMuonSelector &object):
+    _cuts(object._cuts)
+{
+}
+
+bool StaticMuonSelector::apply(const Muon &muon, const PrimaryVertex &pv)
+{
+    return muon.has_extra()
+        && _cuts.apply<PT>(bsm::pt(muon.physics_object().p4()))
+        && _cuts.apply<ETA>(fabs(bsm::eta(muon.physics_object().p4())))
+        && _cuts.apply<IS_GLOBAL>(muon.extra().is_global())
+        && _cuts.apply<IS_TRACKER>(muon.extra().is_tracker())
+        && _cuts.apply<MUON_SEGMENTS>(muon.extra().number_of_matches())
+        && _cuts.apply<MUON_HITS>(muon.global_track().hits())
+        && _cuts.apply<MUON_NORMALIZED_CHI2>(muon.global_track().normalized_chi2())
+        && _cuts.apply<TRACKER_HITS>(muon.inner_track().hits())
+        && _cuts.apply<PIXEL_HITS>(muon.extra().pixel_hits())
+        && _cuts.apply<D0_BSP>(fabs(muon.extra().d0_bsp()))
+        && _cuts.apply<PRIMARY_VERTEX>(fabs(muon.physics_object().vertex().z() - pv.vertex().z()));
+}
+
+bool StaticMuonSelector::apply(const MuonView &muon,
+        const PrimaryVertexView &pv)
+{
+    if (!muon.hasExtra())
+        return false;
+
+    const LorentzVector p4 = muon.p4();
+
+    return _cuts.apply<PT>(bsm::pt(p4))
+        && _cuts.apply<ETA>(fabs(bsm::eta(p4)))
+        && _cuts.apply<IS_GLOBAL>(muon.isGlobal())
+        && _cuts.apply<IS_TRACKER>(muon.isTracker())
+        && _cuts.apply<MUON_SEGMENTS>(muon.numberOfMatches())
+        && _cuts.apply<MUON_HITS>(muon.globalTrackHits())
+        && _cuts.apply<MUON_NORMALIZED_CHI2>(muon.globalTrackNormalizedChi2())
+        && _cuts.apply<TRACKER_HITS>(muon.innerTrackHits())
+        && _cuts.apply<PIXEL_HITS>(muon.pixelHits())
+        && _cuts.apply<D0_BSP>(fabs(muon.d0Bsp()))
+        && _cuts.apply<PRIMARY_VERTEX>(fabs(muon.vertexZ() - pv.z()));
+}
+
+void StaticMuonSelector::apply(const Muons &muons,
+        const PrimaryVertex &pv,
+        SelectionBatch &batch)
+{
+    batch.reset(muons.size(), Cuts::size);
+
+    for(uint32_t object = 0, size = muons.size(); size > object; ++object)
+    {
+        const Muon &muon = muons.Get(object);
+
+        if (!muon.has_extra())
+        {
+            batch.reject(object);
+
+            continue;
+        }
+
+        batch.column(PT)[object] = bsm::pt(muon.physics_object().p4());
+        batch.column(ETA)[object] = fabs(bsm::eta(muon.physics_object().p4()));
+        batch.column(IS_GLOBAL)[object] = muon.extra().is_global();
+        batch.column(IS_TRACKER)[object] = muon.extra().is_tracker();
+        batch.column(MUON_SEGMENTS)[object] = muon.extra().number_of_matches();
+        batch.column(MUON_HITS)[object] = muon.global_track().hits();
+        batch.column(MUON_NORMALIZED_CHI2)[object] =
+            muon.global_track().normalized_chi2();
+        batch.column(TRACKER_HITS)[object] = muon.inner_track().hits();
+        batch.column(PIXEL_HITS)[object] = muon.extra().pixel_hits();
+        batch.column(D0_BSP)[object] = fabs(muon.extra().d0_bsp());
+        batch.column(PRIMARY_VERTEX)[object] =
+            fabs(muon.physics_object().vertex().z() - pv.vertex().z());
+    }
+
+    select(batch);
+}
+
+void StaticMuonSelector::apply(const EventView &event,
+        const PrimaryVertexView &pv,
+        SelectionBatch &batch)
+{
+    batch.reset(event.muons(), Cuts::size);
+
+    for(uint32_t object = 0, size = event.muons(); size > object; ++object)
+    {
+        const MuonView muon = event.muon(object);
+
+        if (!muon.hasExtra())
+        {
+            batch.reject(object);
+
+            continue;
+        }
+
+        const LorentzVector p4 = muon.p4();
+
+        batch.column(PT)[object] = bsm::pt(p4);
+        batch.column(ETA)[object] = fabs(bsm::eta(p4));
+        batch.column(IS_GLOBAL)[object] = muon.isGlobal();
+        batch.column(IS_TRACKER)[object] = muon.isTracker();
+        batch.column(MUON_SEGMENTS)[object] = muon.numberOfMatches();
+        batch.column(MUON_HITS)[object] = muon.globalTrackHits();
+        batch.column(MUON_NORMALIZED_CHI2)[object] =
+            muon.globalTrackNormalizedChi2();
+        batch.column(TRACKER_HITS)[object] = muon.innerTrackHits();
+        batch.column(PIXEL_HITS)[object] = muon.pixelHits();
+        batch.column(D0_BSP)[object] = fabs(muon.d0Bsp());
+        batch.column(PRIMARY_VERTEX)[object] = fabs(muon.vertexZ() - pv.z());
+    }
+
+    select(batch);
+}
+
+StaticMuonSelector::Chain &StaticMuonSelector::cuts()
+{
+    return _cuts;
+}
+
+bsm::ChainCut &StaticMuonSelector::pt()
+{
+    return _cuts.cut<PT>();
+}
+
+bsm::ChainCut &StaticMuonSelector::eta()
+{
+    return _cuts.cut<ETA>();
+}
+
+bsm::ChainCut &StaticMuonSelector::is_global()
+{
+    return _cuts.cut<IS_GLOBAL>();
+}
+
+bsm::ChainCut &StaticMuonSelector::is_tracker()
+{
+    return _cuts.cut<IS_TRACKER>();
+}
+
+bsm::ChainCut &StaticMuonSelector::muon_segments()
+{
+    return _cuts.cut<MUON_SEGMENTS>();
+}
+
+bsm::ChainCut &StaticMuonSelector::muon_hits()
+{
+    return _cuts.cut<MUON_HITS>();
+}
+
+bsm::ChainCut &StaticMuonSelector::muon_normalized_chi2()
+{
+    return _cuts.cut<MUON_NORMALIZED_CHI2>();
+}
+
+bsm::ChainCut &StaticMuonSelector::tracker_hits()
+{
+    return _cuts.cut<TRACKER_HITS>();
+}
+
+bsm::ChainCut &StaticMuonSelector::pixel_hits()
+{
+    return _cuts.cut<PIXEL_HITS>();
+}
+
+bsm::ChainCut &StaticMuonSelector::d0_bsp()
+{
+    return _cuts.cut<D0_BSP>();
+}
+
+bsm::ChainCut &StaticMuonSelector::primary_vertex()
+{
+    return _cuts.cut<PRIMARY_VERTEX>();
+}
+
+void StaticMuonSelector::enable()
+{
+    _cuts.enable();
+}
+
+void StaticMuonSelector::disable()
+{
+    _cuts.disable();
+}
+
+bool StaticMuonSelector::save(std::ostream &out) const
+{
+    return _cuts.save(out);
+}
+
+bool StaticMuonSelector::load(std::istream &in)
+{
+    return _cuts.load(in);
+}
+
+uint32_t StaticMuonSelector::id() const
+{
+    return core::ID<StaticMuonSelector>::get();
+}
+
+StaticMuonSelector::ObjectPtr StaticMuonSelector::clone() const
+{
+    return ObjectPtr(new StaticMuonSelector(*this));
+}
+
+void StaticMuonSelector::merge(const ObjectPtr &object_pointer)
+{
+    if (id() != object_pointer->id())
+        return;
+
+    boost::shared_ptr<StaticMuonSelector> object =
+        dynamic_pointer_cast<StaticMuonSelector>(object_pointer);
+
+    if (!object)
+        return;
+
+    _cuts.merge(object->_cuts);
+
+    Object::merge(object_pointer);
+}
+
+void StaticMuonSelector::print(std::ostream &out) const
+{
+    out << "     CUT                 " << setw(5) << " "
+        << " Objects Events" << endl;
+    out << setw(45) << setfill('-') << left << " " << setfill(' ') << endl;
+
+    _cuts.print(out);
+}
+
+// Private
+//
+void StaticMuonSelector::select(SelectionBatch &batch)
+{
+    _cuts.apply<PT>(batch, PT);
+    _cuts.apply<ETA>(batch, ETA);
+    _cuts.apply<IS_GLOBAL>(batch, IS_GLOBAL);
+    _cuts.apply<IS_TRACKER>(batch, IS_TRACKER);
+    _cuts.apply<MUON_SEGMENTS>(batch, MUON_SEGMENTS);
+    _cuts.apply<MUON_HITS>(batch, MUON_HITS);
+    _cuts.apply<MUON_NORMALIZED_CHI2>(batch, MUON_NORMALIZED_CHI2);
+    _cuts.apply<TRACKER_HITS>(batch, TRACKER_HITS);
+    _cuts.apply<PIXEL_HITS>(batch, PIXEL_HITS);
+    _cuts.apply<D0_BSP>(batch, D0_BSP);
+    _cuts.apply<PRIMARY_VERTEX>(batch, PRIMARY_VERTEX);
+}
+
+
+
 // PrimaryVertex Selector
 //
 PrimaryVertexSelector::PrimaryVertexSelector()
@@ -504,6 +1239,14 @@ bool PrimaryVertexSelector::apply(const PrimaryVertex &pv)
         && _rho->apply(pv.extra().rho());
 }
 
+bool PrimaryVertexSelector::apply(const PrimaryVertexView &pv)
+{
+    return pv.hasExtra()
+        && _ndof->apply(pv.ndof())
+        && _vertex_z->apply(pv.z())
+        && _rho->apply(pv.rho());
+}
+
 CutPtr PrimaryVertexSelector::ndof() const
 {
     return _ndof;
@@ -533,6 +1276,20 @@ void PrimaryVertexSelector::disable()
     rho()->disable();
 }
 
+bool PrimaryVertexSelector::save(std::ostream &out) const
+{
+    return _ndof->save(out)
+        && _vertex_z->save(out)
+        && _rho->save(out);
+}
+
+bool PrimaryVertexSelector::load(std::istream &in)
+{
+    return _ndof->load(in)
+        && _vertex_z->load(in)
+        && _rho->load(in);
+}
+
 uint32_t PrimaryVertexSelector::id() const
 {
     return core::ID<PrimaryVertexSelector>::get();
@@ -649,6 +1406,24 @@ void WJetSelector::disable()
     mass_upper_bound()->disable();
 }
 
+bool WJetSelector::save(std::ostream &out) const
+{
+    return _children->save(out)
+        && _pt->save(out)
+        && _mass_drop->save(out)
+        && _mass_lower_bound->save(out)
+        && _mass_upper_bound->save(out);
+}
+
+bool WJetSelector::load(std::istream &in)
+{
+    return _children->load(in)
+        && _pt->load(in)
+        && _mass_drop->load(in)
+        && _mass_lower_bound->load(in)
+        && _mass_upper_bound->load(in);
+}
+
 uint32_t WJetSelector::id() const
 {
     return core::ID<WJetSelector>::get();
@@ -676,7 +1451,8 @@ void WJetSelector::print(std::ostream &out) const
 // Lock Selector Event Counter on Update
 //
 LockSelectorEventCounterOnUpdate::LockSelectorEventCounterOnUpdate(
-        ElectronSelector &selector)
+        ElectronSelector &selector):
+    _chain(0)
 {
     _lockers.push_back(Locker(
                 new LockCounterOnUpdate(selector.et()->events())));
@@ -687,7 +1463,8 @@ LockSelectorEventCounterOnUpdate::LockSelectorEventCounterOnUpdate(
 }
 
 LockSelectorEventCounterOnUpdate::LockSelectorEventCounterOnUpdate(
-        JetSelector &selector)
+        JetSelector &selector):
+    _chain(0)
 {
     _lockers.push_back(Locker(
                 new LockCounterOnUpdate(selector.pt()->events())));
@@ -696,7 +1473,8 @@ LockSelectorEventCounterOnUpdate::LockSelectorEventCounterOnUpdate(
 }
 
 LockSelectorEventCounterOnUpdate::LockSelectorEventCounterOnUpdate(
-        MuonSelector &selector)
+        MuonSelector &selector):
+    _chain(0)
 {
     _lockers.push_back(Locker(
                 new LockCounterOnUpdate(selector.pt()->events())));
@@ -723,7 +1501,8 @@ LockSelectorEventCounterOnUpdate::LockSelectorEventCounterOnUpdate(
 }
 
 LockSelectorEventCounterOnUpdate::LockSelectorEventCounterOnUpdate(
-        WJetSelector &selector)
+        WJetSelector &selector):
+    _chain(0)
 {
     _lockers.push_back(Locker(
                 new LockCounterOnUpdate(selector.children()->events())));
@@ -736,3 +1515,30 @@ LockSelectorEventCounterOnUpdate::LockSelectorEventCounterOnUpdate(
     _lockers.push_back(Locker(
                 new LockCounterOnUpdate(selector.mass_upper_bound()->events())));
 }
+
+LockSelectorEventCounterOnUpdate::LockSelectorEventCounterOnUpdate(
+        StaticElectronSelector &selector):
+    _chain(&selector.cuts())
+{
+    _chain->lockEventsOnUpdate();
+}
+
+LockSelectorEventCounterOnUpdate::LockSelectorEventCounterOnUpdate(
+        StaticJetSelector &selector):
+    _chain(&selector.cuts())
+{
+    _chain->lockEventsOnUpdate();
+}
+
+LockSelectorEventCounterOnUpdate::LockSelectorEventCounterOnUpdate(
+        StaticMuonSelector &selector):
+    _chain(&selector.cuts())
+{
+    _chain->lockEventsOnUpdate();
+}
+
+LockSelectorEventCounterOnUpdate::~LockSelectorEventCounterOnUpdate()
+{
+    if (_chain)
+        _chain->unlockEvents();
+}
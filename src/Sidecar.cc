@@ -0,0 +1,129 @@
+// Sidecar
+//
+// Cache file of the input kept next to it
+//
+// Copyright 2011, All rights reserved
+
+#include <sys/stat.h>
+
+#include <boost/bind.hpp>
+
+#include <google/protobuf/io/coded_stream.h>
+
+#include "interface/PersistentFile.h"
+#include "interface/Sidecar.h"
+
+using std::string;
+
+using bsm::PersistentFile;
+using bsm::Sidecar;
+
+// Sidecar file format:
+//
+//  [fixed32]   magic
+//  [fixed32]   version
+//  [fixed64]   input file size
+//  [fixed64]   input file modification time
+//  [bytes]     body
+//
+Sidecar::Sidecar(const string &filename,
+        const string &extension,
+        const uint32_t &magic,
+        const uint32_t &version):
+    _filename(filename),
+    _extension(extension),
+    _magic(magic),
+    _version(version),
+    _file_size(0),
+    _file_mtime(0)
+{
+}
+
+Sidecar::~Sidecar()
+{
+}
+
+bool Sidecar::build()
+{
+    if (load())
+        return true;
+
+    if (!scan())
+        return false;
+
+    // Sidecar is only a cache: inputs may be stored in read-only location
+    //
+    save();
+
+    return true;
+}
+
+bool Sidecar::load()
+{
+    clearBody();
+
+    if (!stat())
+        return false;
+
+    const bool result = PersistentFile(sidecar(), _magic, _version)
+        .load(boost::bind(&Sidecar::readFile, this, _1));
+
+    if (!result)
+        clearBody();
+
+    return result;
+}
+
+bool Sidecar::save() const
+{
+    // Readers of the sidecar never see partially written file
+    //
+    return PersistentFile(sidecar(), _magic, _version)
+        .save(boost::bind(&Sidecar::writeFile, this, _1));
+}
+
+string Sidecar::filename() const
+{
+    return _filename;
+}
+
+string Sidecar::sidecar() const
+{
+    return _filename + "." + _extension;
+}
+
+// Protected
+//
+bool Sidecar::stat()
+{
+    struct stat file_stat;
+    if (::stat(_filename.c_str(), &file_stat))
+        return false;
+
+    _file_size = file_stat.st_size;
+    _file_mtime = file_stat.st_mtime;
+
+    return true;
+}
+
+// Private
+//
+bool Sidecar::readFile(CodedInputStream &coded_in)
+{
+    uint64_t file_size;
+    uint64_t file_mtime;
+
+    return coded_in.ReadLittleEndian64(&file_size)
+        && _file_size == file_size
+        && coded_in.ReadLittleEndian64(&file_mtime)
+        && static_cast<uint64_t>(_file_mtime) == file_mtime
+        && readBody(coded_in);
+}
+
+void Sidecar::writeFile(CodedOutputStream &coded_out) const
+{
+    coded_out.WriteLittleEndian64(_file_size);
+    coded_out.WriteLittleEndian64(_file_mtime);
+
+    writeBody(coded_out);
+}
@@ -0,0 +1,325 @@
+// Skim Writer
+//
+// Write filtered events on a dedicated thread
+//
+// Copyright 2011, All rights reserved
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+#include <google/protobuf/io/coded_stream.h>
+
+#include "bsm_core/interface/Thread.h"
+#include "bsm_input/interface/Event.pb.h"
+#include "bsm_input/interface/Input.pb.h"
+#include "bsm_input/interface/Writer.h"
+#include "interface/SkimWriter.h"
+
+using std::cerr;
+using std::endl;
+using std::ostringstream;
+using std::setfill;
+using std::setw;
+using std::string;
+
+using google::protobuf::io::CodedOutputStream;
+
+using bsm::EventBatch;
+using bsm::EventBatchPtr;
+using bsm::EventRing;
+using bsm::SkimWriter;
+
+using bsm::core::Thread;
+
+// Batches in the ring: analyzer threads wait for the writer only if it
+// falls behind by all of them
+//
+static const uint32_t SKIM_BATCHES = 64;
+
+// Writer Thread
+//
+class SkimWriter::WriterOperation : public core::Operation
+{
+    public:
+        WriterOperation(const EventRingPtr &batches,
+                const string &prefix,
+                const uint64_t &file_size):
+            _batches(batches),
+            _prefix(prefix),
+            _file_size(file_size),
+            _files(0),
+            _events(0),
+            _dropped_events(0),
+            _bytes(0)
+        {
+        }
+
+        // Operation interface
+        //
+        virtual void run()
+        {
+            for(EventBatchPtr batch; _batches->pop(batch); )
+            {
+                write(*batch);
+            }
+
+            closeFiles();
+        }
+
+        // Cancel: queued batches are dropped
+        //
+        virtual void stop()
+        {
+            _batches->close();
+        }
+
+        virtual void onThreadInit(Thread *)
+        {
+        }
+
+        uint32_t files() const
+        {
+            return _files;
+        }
+
+        uint64_t events() const
+        {
+            return _events;
+        }
+
+        uint64_t droppedEvents() const
+        {
+            return _dropped_events;
+        }
+
+        uint64_t bytes() const
+        {
+            return _bytes;
+        }
+
+    private:
+        typedef boost::shared_ptr<Writer> WriterPtr;
+
+        struct OutputFile
+        {
+            OutputFile():
+                bytes(0)
+            {
+            }
+
+            WriterPtr writer;
+            uint64_t bytes;
+        };
+
+        // Output file is kept open for each trigger menu: batches of
+        // inputs with different menus come interleaved from all analyzer
+        // threads
+        //
+        typedef std::map<string, OutputFile> Files;
+
+        // Files are rolled between batches: batch goes into one file
+        //
+        void write(const EventBatch &batch)
+        {
+            if (batch.events.empty())
+                return;
+
+            const string info = batch.input
+                ? batch.input->info().SerializeAsString()
+                : string();
+
+            OutputFile &file = _open_files[info];
+            if (!file.writer
+                    || _file_size <= file.bytes)
+                openFile(file, batch);
+
+            if (!file.writer)
+            {
+                _dropped_events += batch.events.size();
+
+                return;
+            }
+
+            for(EventBatch::Events::const_iterator event =
+                        batch.events.begin();
+                    batch.events.end() != event;
+                    ++event)
+            {
+                const uint32_t size = (*event)->ByteSize();
+
+                file.writer->write(*event);
+
+                file.bytes += CodedOutputStream::VarintSize32(size) + size;
+            }
+
+            _events += batch.events.size();
+        }
+
+        void openFile(OutputFile &file, const EventBatch &batch)
+        {
+            closeFile(file);
+
+            ostringstream file_name;
+            file_name << _prefix << "_" << setw(4) << setfill('0') << _files
+                << ".pb";
+
+            // File number is taken even if open fails: next attempt does
+            // not overwrite file of another menu
+            //
+            ++_files;
+
+            file.writer.reset(new Writer(file_name.str()));
+            file.writer->open();
+            if (!file.writer->isOpen())
+            {
+                cerr << "failed to open skim output: " << file_name.str()
+                    << " - " << batch.events.size() << " events are dropped"
+                    << endl;
+
+                file.writer.reset();
+
+                return;
+            }
+
+            if (batch.input)
+                *file.writer->input() = *batch.input;
+        }
+
+        void closeFile(OutputFile &file)
+        {
+            if (!file.writer)
+                return;
+
+            file.writer->close();
+            file.writer.reset();
+
+            _bytes += file.bytes;
+            file.bytes = 0;
+        }
+
+        void closeFiles()
+        {
+            for(Files::iterator file = _open_files.begin();
+                    _open_files.end() != file;
+                    ++file)
+            {
+                closeFile(file->second);
+            }
+
+            _open_files.clear();
+        }
+
+        EventRingPtr _batches;
+
+        string _prefix;
+        uint64_t _file_size;
+
+        Files _open_files;
+
+        uint32_t _files;
+        uint64_t _events;
+        uint64_t _dropped_events;
+        uint64_t _bytes;
+};
+
+// Skim Writer
+//
+SkimWriter::SkimWriter(const string &prefix, const uint64_t &file_size):
+    _is_closed(false),
+    _pushes(0)
+{
+    // Single producer is the writer owner: ring is drained when writer is
+    // closed
+    //
+    _batches.reset(new EventRing(SKIM_BATCHES, 1));
+    _operation.reset(new WriterOperation(_batches, prefix, file_size));
+}
+
+SkimWriter::~SkimWriter()
+{
+    close();
+}
+
+bool SkimWriter::push(const EventBatchPtr &batch)
+{
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+
+        if (_is_closed)
+            return false;
+
+        if (!_thread)
+            start();
+
+        ++_pushes;
+    }
+
+    // Ring is thread-safe: analyzer threads wait for the free slot in
+    // parallel and not behind the writer lock
+    //
+    const bool result = _batches->push(batch);
+
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+
+        --_pushes;
+        if (!_pushes)
+            _pushed.notify_all();
+    }
+
+    return result;
+}
+
+void SkimWriter::close()
+{
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+
+        if (_is_closed)
+            return;
+
+        _is_closed = true;
+
+        // Ring is drained once producer is removed: batches being pushed
+        // should make it into the ring first
+        //
+        while(_pushes)
+            _pushed.wait(lock);
+    }
+
+    _batches->removeProducer();
+
+    if (_thread)
+        _thread->join();
+}
+
+uint32_t SkimWriter::files() const
+{
+    return _operation->files();
+}
+
+uint64_t SkimWriter::events() const
+{
+    return _operation->events();
+}
+
+uint64_t SkimWriter::droppedEvents() const
+{
+    return _operation->droppedEvents();
+}
+
+uint64_t SkimWriter::bytes() const
+{
+    return _operation->bytes();
+}
+
+// Private
+//
+void SkimWriter::start()
+{
+    _thread.reset(new Thread());
+    _thread->init(_operation);
+    _thread->start();
+}
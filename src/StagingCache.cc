@@ -0,0 +1,335 @@
+// Staging Cache
+//
+// Local copies of the remote inputs shared by all jobs on the node
+//
+// Copyright 2011, All rights reserved
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include "interface/StagingCache.h"
+
+using std::hex;
+using std::make_pair;
+using std::ostringstream;
+using std::pair;
+using std::string;
+using std::vector;
+
+using bsm::StagingCache;
+
+// Copies being written carry the suffix and the writer pid: they are
+// never evicted but count toward the cache size
+//
+static const char *TEMPORARY_SUFFIX = ".tmp.";
+
+static const uint32_t COPY_BUFFER_SIZE = 1024 * 1024;
+
+// Write the whole buffer: interrupted writes are continued
+//
+static bool writeAll(const int &fd, const char *data, const size_t &size)
+{
+    for(size_t written = 0; size > written; )
+    {
+        const ssize_t bytes = ::write(fd, data + written, size - written);
+        if (0 <= bytes)
+            written += bytes;
+        else if (EINTR != errno)
+            return false;
+    }
+
+    return true;
+}
+
+StagingCache::StagingCache(const string &directory, const uint64_t &max_bytes):
+    _directory(directory),
+    _max_bytes(max_bytes),
+    _bytes_reserved(0),
+    _hits(0),
+    _copies(0),
+    _bypasses(0),
+    _bytes_copied(0)
+{
+    // Directory is shared by jobs: it may be created by any of them
+    //
+    mkdir(_directory.c_str(), 0755);
+}
+
+string StagingCache::directory() const
+{
+    return _directory;
+}
+
+string StagingCache::stage(const string &file_name)
+{
+    // Streams are read in place
+    //
+    struct stat input_stat;
+    if (stat(file_name.c_str(), &input_stat)
+            || !S_ISREG(input_stat.st_mode))
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+
+        count(_bypasses, file_name);
+
+        return file_name;
+    }
+
+    const uint64_t size = input_stat.st_size;
+    const string cached = cacheName(file_name, size, input_stat.st_mtime);
+
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+
+        while(_copying.count(cached))
+            _condition.wait(lock);
+
+        struct stat cached_stat;
+        if (!stat(cached.c_str(), &cached_stat)
+                && size == static_cast<uint64_t>(cached_stat.st_size))
+        {
+            // Modification time of the copy is its last use
+            //
+            utime(cached.c_str(), 0);
+
+            count(_hits, file_name);
+
+            return cached;
+        }
+
+        if (!evict(size))
+        {
+            count(_bypasses, file_name);
+
+            return file_name;
+        }
+
+        _copying.insert(cached);
+        _bytes_reserved += size;
+    }
+
+    const bool is_copied = copy(file_name, cached);
+
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+
+        _copying.erase(cached);
+        _bytes_reserved -= size;
+
+        count(is_copied ? _copies : _bypasses, file_name);
+    }
+
+    _condition.notify_all();
+
+    if (!is_copied)
+        return file_name;
+
+    _bytes_copied.fetch_add(size, boost::memory_order_relaxed);
+
+    return cached;
+}
+
+uint32_t StagingCache::hits() const
+{
+    return _hits.load(boost::memory_order_relaxed);
+}
+
+uint32_t StagingCache::copies() const
+{
+    return _copies.load(boost::memory_order_relaxed);
+}
+
+uint32_t StagingCache::bypasses() const
+{
+    return _bypasses.load(boost::memory_order_relaxed);
+}
+
+uint64_t StagingCache::bytesCopied() const
+{
+    return _bytes_copied.load(boost::memory_order_relaxed);
+}
+
+// Private
+//
+string StagingCache::cacheName(const string &file_name,
+        const uint64_t &size,
+        const int64_t &mtime) const
+{
+    boost::hash<string> make_hash;
+
+    const string::size_type slash = file_name.rfind('/');
+
+    ostringstream name;
+    name << _directory << "/" << hex << make_hash(file_name) << std::dec
+        << "_" << size << "_" << mtime << "_"
+        << (string::npos == slash ? file_name : file_name.substr(slash + 1));
+
+    return name.str();
+}
+
+bool StagingCache::evict(const uint64_t &bytes)
+{
+    if (bytes > _max_bytes)
+        return false;
+
+    DIR *directory = opendir(_directory.c_str());
+    if (!directory)
+        return false;
+
+    // Copies ordered by their last use
+    //
+    typedef vector<pair<int64_t, pair<string, uint64_t> > > Copies;
+
+    Copies copies;
+    uint64_t used = 0;
+    for(struct dirent *entry = readdir(directory);
+            entry;
+            entry = readdir(directory))
+    {
+        const string name = entry->d_name;
+        if ("." == name
+                || ".." == name)
+            continue;
+
+        const string path = _directory + "/" + name;
+
+        struct stat copy_stat;
+        if (stat(path.c_str(), &copy_stat)
+                || !S_ISREG(copy_stat.st_mode))
+            continue;
+
+        const string::size_type suffix = name.find(TEMPORARY_SUFFIX);
+        if (string::npos != suffix)
+        {
+            used += temporarySize(name, suffix, copy_stat.st_size);
+
+            continue;
+        }
+
+        used += copy_stat.st_size;
+        copies.push_back(make_pair(static_cast<int64_t>(copy_stat.st_mtime),
+                    make_pair(path, static_cast<uint64_t>(copy_stat.st_size))));
+    }
+
+    closedir(directory);
+
+    std::sort(copies.begin(), copies.end());
+
+    // Copies open by other jobs stay readable until they are closed
+    //
+    for(Copies::const_iterator copy = copies.begin();
+            copies.end() != copy
+                && used + _bytes_reserved + bytes > _max_bytes;
+            ++copy)
+    {
+        if (!unlink(copy->second.first.c_str()))
+            used -= copy->second.second;
+    }
+
+    return used + _bytes_reserved + bytes <= _max_bytes;
+}
+
+uint64_t StagingCache::temporarySize(const string &name,
+        const string::size_type &suffix,
+        const uint64_t &size) const
+{
+    // Copies of this job are counted in the reserved bytes
+    //
+    const pid_t pid = atoi(name.c_str() + suffix + strlen(TEMPORARY_SUFFIX));
+    if (getpid() == pid)
+        return 0;
+
+    // Copy of the job that died is never completed
+    //
+    if (0 < pid
+            && kill(pid, 0)
+            && ESRCH == errno)
+    {
+        unlink((_directory + "/" + name).c_str());
+
+        return 0;
+    }
+
+    // Copy is still being written: it takes the input size once complete.
+    // Input size follows the path hash in the cache name
+    //
+    const string::size_type underscore = name.find('_');
+    if (string::npos == underscore
+            || underscore > suffix)
+        return size;
+
+    const uint64_t full_size =
+        strtoull(name.c_str() + underscore + 1, 0, 10);
+
+    return full_size > size ? full_size : size;
+}
+
+void StagingCache::count(boost::atomic<uint32_t> &counter,
+        const string &file_name)
+{
+    if (_staged.insert(file_name).second)
+        counter.fetch_add(1, boost::memory_order_relaxed);
+}
+
+bool StagingCache::copy(const string &from, const string &to)
+{
+    ostringstream temporary;
+    temporary << to << TEMPORARY_SUFFIX << getpid();
+
+    int in = ::open(from.c_str(), O_RDONLY);
+    if (0 > in)
+        return false;
+
+    int out = ::open(temporary.str().c_str(),
+            O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (0 > out)
+    {
+        ::close(in);
+
+        return false;
+    }
+
+    vector<char> buffer(COPY_BUFFER_SIZE);
+
+    bool result = true;
+    while(result)
+    {
+        const ssize_t size = ::read(in, &buffer[0], buffer.size());
+        if (!size)
+            break;
+
+        if (0 > size)
+            result = EINTR == errno;
+        else
+            result = writeAll(out, &buffer[0], size);
+    }
+
+    ::close(in);
+
+    result = !::close(out) && result;
+
+    if (result)
+        result = !rename(temporary.str().c_str(), to.c_str());
+
+    if (!result)
+        unlink(temporary.str().c_str());
+
+    return result;
+}
@@ -3,16 +3,54 @@
 // Created by Samvel Khalatyan, Jun 01, 2011
 // Copyright 2011, All rights reserved
 
+#include <istream>
+#include <ostream>
+
 #include <boost/pointer_cast.hpp>
 
+#include <TAxis.h>
+#include <TH1.h>
+#include <TH2.h>
+
 #include "bsm_core/interface/ID.h"
 #include "bsm_stat/interface/H1.h"
 #include "bsm_stat/interface/H2.h"
+#include "bsm_stat/interface/Utility.h"
 #include "interface/StatProxy.h"
+#include "interface/Utility.h"
 
 using bsm::H1Proxy;
 using bsm::H2Proxy;
 
+using bsm::stat::convert;
+
+using bsm::utility::read;
+using bsm::utility::write;
+
+// Checkpoint helpers: axis is written as number of bins and range. Axis
+// is read back only if it is the same
+//
+static void writeAxis(std::ostream &out, const TAxis &axis)
+{
+    write(out, static_cast<uint32_t>(axis.GetNbins()));
+    write(out, axis.GetXmin());
+    write(out, axis.GetXmax());
+}
+
+static bool readAxis(std::istream &in, const TAxis &axis)
+{
+    uint32_t bins = 0;
+    double min = 0;
+    double max = 0;
+
+    return read(in, bins)
+        && read(in, min)
+        && read(in, max)
+        && static_cast<uint32_t>(axis.GetNbins()) == bins
+        && axis.GetXmin() == min
+        && axis.GetXmax() == max;
+}
+
 H1Proxy::H1Proxy(const uint32_t &bins, const float &min, const float &max)
 {
     _histogram.reset(new stat::H1(bins, min, max));
@@ -28,6 +66,52 @@ const H1Proxy::H1Ptr H1Proxy::histogram() const
     return _histogram;
 }
 
+bool H1Proxy::save(std::ostream &out) const
+{
+    const stat::TH1Ptr histogram = convert(*_histogram);
+    const TAxis &axis = *histogram->GetXaxis();
+
+    writeAxis(out, axis);
+
+    // Underflow and overflow are saved with the bins
+    //
+    for(int bin = 0, bins = axis.GetNbins() + 1; bins >= bin; ++bin)
+    {
+        write(out, histogram->GetBinContent(bin));
+    }
+
+    return !out.fail();
+}
+
+bool H1Proxy::load(std::istream &in)
+{
+    const stat::TH1Ptr histogram = convert(*_histogram);
+    const TAxis &axis = *histogram->GetXaxis();
+
+    if (!readAxis(in, axis))
+        return false;
+
+    H1Ptr loaded(new stat::H1(axis.GetNbins(),
+                axis.GetXmin(),
+                axis.GetXmax()));
+
+    for(int bin = 0, bins = axis.GetNbins() + 1; bins >= bin; ++bin)
+    {
+        double content = 0;
+        if (!read(in, content))
+            return false;
+
+        // Bin content is restored with a single weighted fill
+        //
+        if (content)
+            loaded->fill(axis.GetBinCenter(bin), content);
+    }
+
+    _histogram = loaded;
+
+    return true;
+}
+
 uint32_t H1Proxy::id() const
 {
     return core::ID<H1Proxy>::get();
@@ -82,6 +166,64 @@ const H2Proxy::H2Ptr H2Proxy::histogram() const
     return _histogram;
 }
 
+bool H2Proxy::save(std::ostream &out) const
+{
+    const stat::TH2Ptr histogram = convert(*_histogram);
+    const TAxis &x_axis = *histogram->GetXaxis();
+    const TAxis &y_axis = *histogram->GetYaxis();
+
+    writeAxis(out, x_axis);
+    writeAxis(out, y_axis);
+
+    for(int x = 0, x_bins = x_axis.GetNbins() + 1; x_bins >= x; ++x)
+    {
+        for(int y = 0, y_bins = y_axis.GetNbins() + 1; y_bins >= y; ++y)
+        {
+            write(out, histogram->GetBinContent(x, y));
+        }
+    }
+
+    return !out.fail();
+}
+
+bool H2Proxy::load(std::istream &in)
+{
+    const stat::TH2Ptr histogram = convert(*_histogram);
+    const TAxis &x_axis = *histogram->GetXaxis();
+    const TAxis &y_axis = *histogram->GetYaxis();
+
+    if (!readAxis(in, x_axis)
+            || !readAxis(in, y_axis))
+        return false;
+
+    H2Ptr loaded(new stat::H2(x_axis.GetNbins(),
+                x_axis.GetXmin(),
+                x_axis.GetXmax(),
+
+                y_axis.GetNbins(),
+                y_axis.GetXmin(),
+                y_axis.GetXmax()));
+
+    for(int x = 0, x_bins = x_axis.GetNbins() + 1; x_bins >= x; ++x)
+    {
+        for(int y = 0, y_bins = y_axis.GetNbins() + 1; y_bins >= y; ++y)
+        {
+            double content = 0;
+            if (!read(in, content))
+                return false;
+
+            if (content)
+                loaded->fill(x_axis.GetBinCenter(x),
+                        y_axis.GetBinCenter(y),
+                        content);
+        }
+    }
+
+    _histogram = loaded;
+
+    return true;
+}
+
 uint32_t H2Proxy::id() const
 {
     return core::ID<H2Proxy>::get();
@@ -0,0 +1,192 @@
+// Stream Reader
+//
+// Read Event records from the standard input or a named pipe
+//
+// Copyright 2011, All rights reserved
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "bsm_input/interface/Input.pb.h"
+#include "interface/StreamReader.h"
+
+using std::string;
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::io::FileInputStream;
+
+using bsm::StreamReader;
+
+bool StreamReader::isStream(const string &filename)
+{
+    if ("-" == filename)
+        return true;
+
+    struct stat file_stat;
+
+    return !stat(filename.c_str(), &file_stat)
+        && S_ISFIFO(file_stat.st_mode);
+}
+
+StreamReader::StreamReader(const string &filename):
+    _filename(filename),
+    _fd(-1),
+    _position(0),
+    _had_error(false)
+{
+}
+
+StreamReader::~StreamReader()
+{
+    close();
+}
+
+void StreamReader::open()
+{
+    if (isOpen())
+        return;
+
+    _fd = "-" == _filename
+        ? STDIN_FILENO
+        : ::open(_filename.c_str(), O_RDONLY);
+    if (0 > _fd)
+        return;
+
+    _raw_in.reset(new FileInputStream(_fd));
+    _input.reset(new Input());
+    _position = 0;
+    _had_error = false;
+
+    // Stream starts with the Input: events refer to its trigger menu
+    //
+    uint32_t size = 0;
+    bool has_size;
+    bool result;
+    {
+        CodedInputStream coded_in(_raw_in.get());
+
+        string input;
+        has_size = coded_in.ReadVarint32(&size);
+        result = has_size
+            && coded_in.ReadString(&input, size)
+            && _input->ParseFromString(input);
+    }
+
+    if (!advance(has_size, result, size))
+        close();
+}
+
+void StreamReader::close()
+{
+    _raw_in.reset();
+
+    // Standard input is left to the process
+    //
+    if (isOpen()
+            && STDIN_FILENO != _fd)
+        ::close(_fd);
+
+    _fd = -1;
+
+    _input.reset();
+}
+
+bool StreamReader::isOpen() const
+{
+    return 0 <= _fd;
+}
+
+string StreamReader::filename() const
+{
+    return _filename;
+}
+
+StreamReader::InputPtr StreamReader::input() const
+{
+    return _input;
+}
+
+uint64_t StreamReader::tell() const
+{
+    return _position;
+}
+
+void StreamReader::use(const EventFields &fields)
+{
+    _fields = fields;
+}
+
+bool StreamReader::read(EventPtr &event)
+{
+    if (!_raw_in)
+        return false;
+
+    // Coded stream returns unused bytes to the raw one when destroyed.
+    // Record is parsed straight from the stream: only used fields are
+    // copied
+    //
+    uint32_t size = 0;
+    bool has_size;
+    bool result;
+    {
+        CodedInputStream coded_in(_raw_in.get());
+
+        has_size = coded_in.ReadVarint32(&size);
+        result = has_size
+            && _fields.parse(coded_in, size, *event, _buffer);
+    }
+
+    return advance(has_size, result, size);
+}
+
+bool StreamReader::read(string &record)
+{
+    if (!_raw_in)
+        return false;
+
+    uint32_t size = 0;
+    bool has_size;
+    bool result;
+    {
+        CodedInputStream coded_in(_raw_in.get());
+
+        has_size = coded_in.ReadVarint32(&size);
+        result = has_size
+            && coded_in.ReadString(&record, size);
+    }
+
+    return advance(has_size, result, size);
+}
+
+bool StreamReader::hadError() const
+{
+    return _had_error;
+}
+
+// Private
+//
+bool StreamReader::advance(const bool &has_size,
+        const bool &is_read,
+        const uint32_t &size)
+{
+    // Stream can not be rewound: reader stops at the end of stream or
+    // the first bad record. Stream ends between the records
+    //
+    if (!is_read)
+    {
+        _raw_in.reset();
+        _had_error = has_size;
+
+        return false;
+    }
+
+    _position += CodedOutputStream::VarintSize32(size) + size;
+
+    return true;
+}
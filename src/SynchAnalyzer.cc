@@ -26,6 +26,7 @@
 #include "interface/Monitor.h"
 #include "interface/Selector.h"
 #include "interface/SynchAnalyzer.h"
+#include "interface/Utility.h"
 
 using namespace std;
 
@@ -34,6 +35,11 @@ using boost::dynamic_pointer_cast;
 using bsm::SynchJuly2011Analyzer;
 using bsm::SynchJECJuly2011Analyzer;
 
+using bsm::utility::read;
+using bsm::utility::write;
+
+typedef std::vector<bsm::Event::Extra> PassedEvents;
+
 int processevts = 0;
 int passevts = 0;
 int passtrig1 = 0;
@@ -53,6 +59,39 @@ int passtrig14 = 0;
 int passtrig15 = 0;
 int passtrig16 = 0;
 
+// Checkpoint helpers: passed events are written as serialized messages
+//
+static void savePassedEvents(std::ostream &out, const PassedEvents &events)
+{
+    write(out, static_cast<uint32_t>(events.size()));
+    for(PassedEvents::const_iterator extra = events.begin();
+            events.end() != extra;
+            ++extra)
+    {
+        write(out, extra->SerializeAsString());
+    }
+}
+
+static bool loadPassedEvents(std::istream &in, PassedEvents &events)
+{
+    uint32_t size = 0;
+    if (!read(in, size))
+        return false;
+
+    events.clear();
+    for(string message; size; --size)
+    {
+        bsm::Event::Extra extra;
+        if (!read(in, message)
+                || !extra.ParseFromString(message))
+            return false;
+
+        events.push_back(extra);
+    }
+
+    return true;
+}
+
 
 SynchJuly2011Analyzer::SynchJuly2011Analyzer(const LeptonMode &mode):
   _lepton_mode(mode)
@@ -348,6 +387,47 @@ void SynchJuly2011Analyzer::process(const Event *event)
   _passed_events.push_back(event->extra());
 }
 
+bool SynchJuly2011Analyzer::save(std::ostream &out) const
+{
+  if (!_cutflow->save(out)
+      || !_primary_vertex_selector->save(out)
+      || !_jet_selector->save(out)
+      || !_electron_selector->save(out)
+      || !_electron_veto_selector->save(out)
+      || !_muon_selector->save(out)
+      || !_muon_veto_selector->save(out))
+    return false;
+  
+  savePassedEvents(out, _passed_events);
+  
+  return _leading_jet->save(out)
+    && _electron_before_veto->save(out)
+    && _muon_to_veto->save(out)
+    && _electron_after_veto->save(out)
+    && _muon_before_veto->save(out)
+    && _electron_to_veto->save(out)
+    && _muon_after_veto->save(out);
+}
+
+bool SynchJuly2011Analyzer::load(std::istream &in)
+{
+  return _cutflow->load(in)
+    && _primary_vertex_selector->load(in)
+    && _jet_selector->load(in)
+    && _electron_selector->load(in)
+    && _electron_veto_selector->load(in)
+    && _muon_selector->load(in)
+    && _muon_veto_selector->load(in)
+    && loadPassedEvents(in, _passed_events)
+    && _leading_jet->load(in)
+    && _electron_before_veto->load(in)
+    && _muon_to_veto->load(in)
+    && _electron_after_veto->load(in)
+    && _muon_before_veto->load(in)
+    && _electron_to_veto->load(in)
+    && _muon_after_veto->load(in);
+}
+
 uint32_t SynchJuly2011Analyzer::id() const
 {
   return core::ID<SynchJuly2011Analyzer>::get();
@@ -972,6 +1052,62 @@ void SynchJECJuly2011Analyzer::process(const Event *event)
     _passed_events.push_back(event->extra());
 }
 
+bool SynchJECJuly2011Analyzer::save(std::ostream &out) const
+{
+    if (!_cutflow->save(out)
+            || !_primary_vertex_selector->save(out)
+            || !_jet_selector->save(out)
+            || !_electron_selector->save(out)
+            || !_electron_veto_selector->save(out)
+            || !_muon_selector->save(out)
+            || !_muon_veto_selector->save(out))
+        return false;
+
+    savePassedEvents(out, _passed_events);
+
+    if (!_leading_jet->save(out)
+            || !_electron_before_veto->save(out)
+            || !_muon_to_veto->save(out)
+            || !_electron_after_veto->save(out)
+            || !_muon_before_veto->save(out)
+            || !_electron_to_veto->save(out)
+            || !_muon_after_veto->save(out))
+        return false;
+
+    write(out, _out.str());
+
+    return !out.fail();
+}
+
+bool SynchJECJuly2011Analyzer::load(std::istream &in)
+{
+    string text;
+    if (!_cutflow->load(in)
+            || !_primary_vertex_selector->load(in)
+            || !_jet_selector->load(in)
+            || !_electron_selector->load(in)
+            || !_electron_veto_selector->load(in)
+            || !_muon_selector->load(in)
+            || !_muon_veto_selector->load(in)
+            || !loadPassedEvents(in, _passed_events)
+            || !_leading_jet->load(in)
+            || !_electron_before_veto->load(in)
+            || !_muon_to_veto->load(in)
+            || !_electron_after_veto->load(in)
+            || !_muon_before_veto->load(in)
+            || !_electron_to_veto->load(in)
+            || !_muon_after_veto->load(in)
+            || !read(in, text))
+        return false;
+
+    // Events are appended to the loaded text
+    //
+    _out.str("");
+    _out << text;
+
+    return true;
+}
+
 uint32_t SynchJECJuly2011Analyzer::id() const
 {
     return core::ID<SynchJECJuly2011Analyzer>::get();
@@ -5,32 +5,407 @@
 // Created by Samvel Khalatyan, Apr 30, 2011
 // Copyright 2011, All rights reserved
 
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <boost/bind.hpp>
 #include <boost/pointer_cast.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <boost/thread/thread.hpp>
 
 #include "bsm_input/interface/Event.pb.h"
 #include "bsm_input/interface/Reader.h"
 #include "bsm_core/interface/Keyboard.h"
 
 #include "interface/Analyzer.h"
+#include "interface/Checkpoint.h"
+#include "interface/DatasetManifest.h"
+#include "interface/MappedReader.h"
+#include "interface/RecordIndex.h"
+#include "interface/RecordReader.h"
+#include "interface/RuntimeHistory.h"
+#include "interface/StagingCache.h"
+#include "interface/StreamReader.h"
 #include "interface/Thread.h"
+#include "interface/Utility.h"
 
 using namespace std;
 
 using boost::shared_ptr;
 
 using bsm::AnalyzerPtr;
+using bsm::Checkpoint;
+using bsm::DatasetManifest;
+using bsm::EventBatch;
+using bsm::EventBatchPtr;
+using bsm::EventFields;
+using bsm::EventRing;
+using bsm::InputChunk;
+using bsm::JobStats;
 using bsm::KeyboardOperation;
+using bsm::MappedReader;
+using bsm::Reader;
+using bsm::StatsOperation;
+using bsm::ReaderOperation;
+using bsm::ReadaheadOperation;
+using bsm::RuntimeHistory;
+using bsm::StagingCache;
+using bsm::StagingCachePtr;
+using bsm::StreamReader;
 using bsm::AnalyzerOperation;
 using bsm::ThreadController;
+using bsm::ThreadStats;
 
 using bsm::core::Lock;
 using bsm::core::Thread;
 
 typedef boost::shared_ptr<AnalyzerOperation> AnalyzerOperationPtr;
 typedef boost::shared_ptr<KeyboardOperation> KeyboardOperationPtr;
+typedef boost::shared_ptr<ReaderOperation> ReaderOperationPtr;
+typedef boost::shared_ptr<StatsOperation> StatsOperationPtr;
+typedef boost::shared_ptr<ReadaheadOperation> ReadaheadOperationPtr;
+
+// Pipelined mode: number of events passed through the ring at once and
+// number of batches in the ring per analyzer thread
+//
+static const uint32_t EVENTS_PER_BATCH = 64;
+static const uint32_t BATCHES_PER_ANALYZER = 4;
+
+// Readahead: pause between the checks of the workers' next tasks and
+// buffer used to read inputs if system readahead is not supported
+//
+static const uint32_t READAHEAD_INTERVAL = 20; // milliseconds
+static const uint32_t READAHEAD_BUFFER_SIZE = 1024 * 1024;
+
+// Multi-process mode: shared memory slot of the worker process. Results
+// are written by the analyzer right after the header. Slot is reserved
+// but memory is only allocated when touched
+//
+static const uint64_t PROCESS_SLOT_SIZE = 256 * 1024 * 1024;
+
+// Share of the failed worker is sent to another one: inputs that fail
+// every time are given up
+//
+static const uint32_t SHARE_ATTEMPTS = 2;
+
+struct ProcessSlot
+{
+    uint64_t events_processed;
+    uint64_t events_size;
+    uint32_t inputs_processed;
+    uint32_t inputs_loaded;
+    uint64_t bytes_loaded;
+    uint32_t event_resets;
+    uint64_t peak_event_bytes;
+    uint32_t staging_hits;
+    uint32_t staging_copies;
+    uint32_t staging_bypasses;
+    uint64_t staging_bytes;
+    uint64_t results_size;
+    uint32_t is_done;
+};
+
+static char *processResults(ProcessSlot *slot)
+{
+    return reinterpret_cast<char *>(slot) + sizeof(ProcessSlot);
+}
+
+static uint64_t processResultsCapacity()
+{
+    return PROCESS_SLOT_SIZE - sizeof(ProcessSlot);
+}
+
+static ProcessSlot *processSlot(void *memory, const uint32_t &slot)
+{
+    return reinterpret_cast<ProcessSlot *>(
+            static_cast<char *>(memory) + slot * PROCESS_SLOT_SIZE);
+}
+
+// Pipes between the controller and worker processes. False is returned if
+// the other end is closed or on error
+//
+static bool writeAll(const int &fd, const char *data, uint64_t size)
+{
+    while(size)
+    {
+        const ssize_t written = ::write(fd, data, size);
+        if (0 > written)
+        {
+            if (EINTR == errno)
+                continue;
+
+            return false;
+        }
+
+        data += written;
+        size -= written;
+    }
+
+    return true;
+}
+
+static bool readAll(const int &fd, char *data, uint64_t size)
+{
+    while(size)
+    {
+        const ssize_t bytes = ::read(fd, data, size);
+        if (0 > bytes)
+        {
+            if (EINTR == errno)
+                continue;
+
+            return false;
+        }
+
+        if (!bytes)
+            return false;
+
+        data += bytes;
+        size -= bytes;
+    }
+
+    return true;
+}
+
+// Round inputs are sent as a single message prefixed with its size
+//
+static bool writeInputs(const int &fd, std::queue<InputChunk> inputs)
+{
+    using bsm::utility::write;
+
+    std::ostringstream out;
+    write(out, static_cast<uint32_t>(inputs.size()));
+    for(; !inputs.empty(); inputs.pop())
+    {
+        const InputChunk &input = inputs.front();
+
+        write(out, input.file_name);
+        write(out, input.begin);
+        write(out, input.end);
+        write(out, input.cost);
+    }
+
+    const std::string message = out.str();
+    const uint64_t size = message.size();
+
+    return writeAll(fd, reinterpret_cast<const char *>(&size), sizeof(size))
+        && writeAll(fd, message.data(), size);
+}
+
+static bool readInputs(const int &fd, std::queue<InputChunk> &inputs)
+{
+    using bsm::utility::read;
+
+    while(!inputs.empty())
+    {
+        inputs.pop();
+    }
+
+    uint64_t size;
+    if (!readAll(fd, reinterpret_cast<char *>(&size), sizeof(size)))
+        return false;
+
+    std::string message(size, 0);
+    if (size
+            && !readAll(fd, &message[0], size))
+        return false;
+
+    std::istringstream in(message);
+    uint32_t count;
+    if (!read(in, count))
+        return false;
+
+    for(InputChunk input; count; --count)
+    {
+        if (!read(in, input.file_name)
+                || !read(in, input.begin)
+                || !read(in, input.end)
+                || !read(in, input.cost))
+            return false;
+
+        inputs.push(input);
+    }
+
+    return true;
+}
+
+static void waitForProcess(const pid_t &pid)
+{
+    int status;
+    while(0 > waitpid(pid, &status, 0)
+            && EINTR == errno)
+    {
+    }
+}
+
+// Number of bytes in the input: chunk size or the whole file size. Bytes
+// are counted per input to keep the event loop free of extra work
+//
+static uint64_t inputSize(const InputChunk &input)
+{
+    if (!input.isWholeFile())
+        return input.end - input.begin;
+
+    struct stat file_stat;
+    if (stat(input.file_name.c_str(), &file_stat))
+        return 0;
+
+    return file_stat.st_size;
+}
+
+static bool isMoreExpensive(const InputChunk &left, const InputChunk &right)
+{
+    return left.cost > right.cost;
+}
+
+// Quote string for JSON output
+//
+static string jsonString(const string &value)
+{
+    ostringstream out;
+    out << '"';
+    for(string::const_iterator c = value.begin(); value.end() != c; ++c)
+    {
+        switch(*c)
+        {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+
+            default:
+                if (0x20 > static_cast<unsigned char>(*c))
+                    out << "\\u" << hex << setw(4) << setfill('0')
+                        << static_cast<int>(*c) << dec << setfill(' ');
+                else
+                    out << *c;
+        }
+    }
+    out << '"';
+
+    return out.str();
+}
+
+// Pre-scan of the inputs: threads take the next input until all of them
+// are indexed. Index is left empty for chunks, streams and inputs without
+// records
+//
+typedef boost::shared_ptr<bsm::RecordIndex> RecordIndexPtr;
+typedef std::vector<RecordIndexPtr> RecordIndices;
+
+static void indexInputs(const std::vector<InputChunk> &inputs,
+        RecordIndices &indices,
+        boost::atomic<uint32_t> &next)
+{
+    for(uint32_t input = next.fetch_add(1, boost::memory_order_relaxed);
+            inputs.size() > input;
+            input = next.fetch_add(1, boost::memory_order_relaxed))
+    {
+        if (!inputs[input].isWholeFile()
+                || StreamReader::isStream(inputs[input].file_name))
+            continue;
+
+        RecordIndexPtr index(new bsm::RecordIndex(inputs[input].file_name));
+        if (index->build()
+                && index->size())
+            indices[input] = index;
+    }
+}
+
+// Test if analyzer results can be passed to the checkpoint or between
+// processes
+//
+static bool canSave(const bsm::Analyzer &analyzer)
+{
+    std::ostringstream out;
+
+    return analyzer.save(out);
+}
+
+// CPUs the process is allowed to run on. Affinity is only supported on
+// Linux: empty list is returned otherwise
+//
+static std::vector<int> allowedCPUs()
+{
+    std::vector<int> cpus;
+
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    if (!sched_getaffinity(0, sizeof(cpu_set), &cpu_set))
+    {
+        for(int cpu = 0; CPU_SETSIZE > cpu; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &cpu_set))
+                cpus.push_back(cpu);
+        }
+    }
+#endif
+
+    return cpus;
+}
+
+// Input Chunk
+//
+InputChunk::InputChunk(const std::string &file_name,
+        const uint64_t &begin,
+        const uint64_t &end):
+    file_name(file_name),
+    begin(begin),
+    end(end),
+    cost(0)
+{
+}
+
+bool InputChunk::isWholeFile() const
+{
+    return !end;
+}
+
+
+
+// Stats
+//
+ThreadStats::ThreadStats():
+    id(0),
+    events(0),
+    bytes(0)
+{
+}
+
+JobStats::JobStats():
+    elapsed(0),
+    events(0),
+    bytes(0),
+    events_expected(0),
+    inputs_processed(0),
+    inputs_left(0),
+    batches(0),
+    batches_capacity(0),
+    processes(0)
+{
+}
+
+
 
 // Keyboard Thread
 //
@@ -70,9 +445,7 @@ void KeyboardOperation::run()
 
 void KeyboardOperation::stop()
 {
-    Lock lock(_thread->condition());
-
-    _continue = false;
+    _continue.store(false, boost::memory_order_release);
 }
 
 void KeyboardOperation::onThreadInit(Thread *thread)
@@ -84,444 +457,3204 @@ void KeyboardOperation::onThreadInit(Thread *thread)
 //
 bool KeyboardOperation::isContinue() const
 {
-    Lock lock(_thread->condition());
-
-    return _continue;
+    return _continue.load(boost::memory_order_acquire);
 }
 
 
 
-// Analyzer Thread
+// Stats Thread
 //
-AnalyzerOperation::AnalyzerOperation():
-    _continue(true),
-    _events_processed(0),
-    _total_events_size(0)
+StatsOperation::StatsOperation():
+    _interval(1),
+    _continue(true)
 {
     _thread = 0;
-    _controller = 0;
+    _thread_controller = 0;
 }
 
-AnalyzerOperation::~AnalyzerOperation()
+void StatsOperation::init(ThreadController *thread_controller,
+        const std::string &file_name,
+        const uint32_t &interval)
 {
-    // Check if thread is still working
+    _thread_controller = thread_controller;
+    _file_name = file_name;
+    _interval = interval ? interval : 1;
 }
 
-void AnalyzerOperation::use(ThreadController *controller)
+void StatsOperation::run()
 {
-    if (isRunning())
+    if (!_thread
+            || !_thread_controller
+            || _file_name.empty())
         return;
 
-    _controller = controller;
+    for(; wait(); )
+    {
+        write(_thread_controller->stats());
+    }
+
+    // Final state of the job
+    //
+    write(_thread_controller->stats());
 }
 
-void AnalyzerOperation::use(const AnalyzerPtr &analyzer)
+void StatsOperation::stop()
 {
-    if (isRunning())
-        return;
+    {
+        boost::mutex::scoped_lock lock(_mutex);
 
-    _analyzer = analyzer;
+        _continue = false;
+    }
+
+    _condition.notify_all();
 }
 
-AnalyzerPtr AnalyzerOperation::analyzer() const
+void StatsOperation::onThreadInit(Thread *thread)
 {
-    return _analyzer;
+    _thread = thread;
 }
 
-bool AnalyzerOperation::init(const std::string &file_name)
+// Private
+//
+bool StatsOperation::wait()
 {
-    if (file_name.empty())
-        return false;
+    boost::mutex::scoped_lock lock(_mutex);
 
-    if (thread())
-    {
-        if (!isFileEmpty())
-            return false;
+    const boost::system_time deadline = boost::get_system_time()
+        + boost::posix_time::seconds(_interval);
 
-        Lock lock(thread()->condition());
-        _file_name = file_name;
-    }
-    else
+    while(_continue
+            && _condition.timed_wait(lock, deadline))
     {
-        if (!_file_name.empty())
-            return false;
-
-        _file_name = file_name;
     }
 
-    return true;
+    return _continue;
 }
 
-void AnalyzerOperation::run()
+void StatsOperation::write(const JobStats &stats)
 {
-    if (!thread()
-            || !hasAnalyzer()
-            || !hasController())
-        return;
+    const double period = stats.elapsed > _previous.elapsed
+        ? stats.elapsed - _previous.elapsed
+        : 0;
+
+    // Counters are reset when threads start the next round
+    //
+    uint64_t events = stats.events >= _previous.events
+        ? stats.events - _previous.events
+        : stats.events;
+    uint64_t bytes = stats.bytes >= _previous.bytes
+        ? stats.bytes - _previous.bytes
+        : stats.bytes;
+
+    ostringstream out;
+    out << fixed << setprecision(1);
+
+    out << "{" << endl;
+    out << "  \"elapsed\": " << stats.elapsed << "," << endl;
+    out << "  \"events\": " << stats.events << "," << endl;
+    out << "  \"events_per_second\": "
+        << (period ? events / period : 0) << "," << endl;
+    out << "  \"mb_per_second\": "
+        << (period ? bytes / period / 1024 / 1024 : 0) << "," << endl;
+    out << "  \"inputs_processed\": " << stats.inputs_processed << ","
+        << endl;
+    out << "  \"inputs_left\": " << stats.inputs_left << "," << endl;
+    out << "  \"events_expected\": " << stats.events_expected << ","
+        << endl;
+
+    // Events left are known with manifest: inputs differ in size
+    //
+    out << "  \"eta\": ";
+    if (!stats.inputs_left)
+        out << 0;
+    else if (stats.events_expected
+            && stats.events)
+        out << (stats.events_expected > stats.events
+                ? stats.elapsed * (stats.events_expected - stats.events)
+                    / stats.events
+                : 0);
+    else if (stats.inputs_processed)
+        out << stats.elapsed * stats.inputs_left / stats.inputs_processed;
+    else
+        out << "null";
+    out << "," << endl;
 
-    for(; isContinue();)
+    out << "  \"queue_depth\": " << stats.batches << "," << endl;
+    out << "  \"queue_capacity\": " << stats.batches_capacity << ","
+        << endl;
+    out << "  \"processes\": " << stats.processes << "," << endl;
+
+    out << "  \"threads\": [";
+    for(JobStats::Threads::const_iterator thread = stats.threads.begin();
+            stats.threads.end() != thread;
+            ++thread)
     {
-        // Process file
-        //
-        processFile();
+        events = thread->events;
+        bytes = thread->bytes;
+        for(JobStats::Threads::const_iterator previous =
+                    _previous.threads.begin();
+                _previous.threads.end() != previous;
+                ++previous)
+        {
+            if (previous->type != thread->type
+                    || previous->id != thread->id)
+                continue;
 
-        // Start run loop
-        //
-        _thread->runLoop()->run();
+            if (thread->events >= previous->events)
+                events -= previous->events;
 
-        // Wait for instructions
-        //
-        waitForInstructions();
+            if (thread->bytes >= previous->bytes)
+                bytes -= previous->bytes;
+
+            break;
+        }
+
+        out << (stats.threads.begin() == thread ? "" : ",") << endl;
+        out << "    {\"type\": " << jsonString(thread->type)
+            << ", \"id\": " << thread->id
+            << ", \"events\": " << thread->events
+            << ", \"events_per_second\": " << (period ? events / period : 0)
+            << ", \"mb_per_second\": "
+            << (period ? bytes / period / 1024 / 1024 : 0)
+            << ", \"input\": " << jsonString(thread->input) << "}";
+    }
+    out << endl << "  ]" << endl;
+    out << "}" << endl;
+
+    _previous = stats;
+
+    // Readers never see partially written file
+    //
+    const string temporary = _file_name + ".tmp";
+    {
+        ofstream file(temporary.c_str());
+        file << out.str();
+        if (!file.good())
+            return;
     }
+
+    rename(temporary.c_str(), _file_name.c_str());
 }
 
-void AnalyzerOperation::stop()
-{
-    Lock lock(thread()->condition());
 
-    _continue = false;
+
+// Readahead Thread
+//
+ReadaheadOperation::ReadaheadOperation():
+    _inputs(0),
+    _max_bytes(0),
+    _continue(true),
+    _inputs_loaded(0),
+    _bytes_loaded(0)
+{
+    _thread = 0;
 }
 
-void AnalyzerOperation::onThreadInit(Thread *thread)
+void ReadaheadOperation::use(const InputTasksPtr &tasks,
+        const uint32_t &inputs,
+        const uint64_t &bytes)
 {
-    _thread = thread;
+    if (isRunning())
+        return;
+
+    _tasks = tasks;
+    _inputs = inputs;
+    _max_bytes = bytes;
 }
 
-Thread *AnalyzerOperation::thread() const
+void ReadaheadOperation::run()
 {
-    return _thread;
+    if (!_thread
+            || !_tasks)
+        return;
+
+    for(; wait(); )
+    {
+        process();
+    }
 }
 
-void AnalyzerOperation::onRunLoopCommand(const uint32_t &command)
+void ReadaheadOperation::stop()
 {
-    switch(command)
     {
-        case KeyboardOperation::QUIT: _thread->stop();
-                   break;
+        boost::mutex::scoped_lock lock(_mutex);
 
-        default: break;
+        _continue = false;
     }
+
+    _condition.notify_all();
 }
 
-uint32_t AnalyzerOperation::eventsProcessed() const
+void ReadaheadOperation::onThreadInit(Thread *thread)
 {
-    return _events_processed;
+    _thread = thread;
 }
 
-uint32_t AnalyzerOperation::totalEventsSize() const
+uint32_t ReadaheadOperation::inputsLoaded() const
 {
-    return _total_events_size;
+    return _inputs_loaded.load(boost::memory_order_relaxed);
 }
 
-// Privates
-//
-bool AnalyzerOperation::isRunning() const
+uint64_t ReadaheadOperation::bytesLoaded() const
 {
-    return thread()
-        && thread()->isRunning();
+    return _bytes_loaded.load(boost::memory_order_relaxed);
 }
 
-bool AnalyzerOperation::isContinue() const
+// Private
+//
+bool ReadaheadOperation::isRunning() const
 {
-    Lock lock(thread()->condition());
-    
-    return _continue;
+    return _thread
+        && _thread->isRunning();
 }
 
-bool AnalyzerOperation::isFileEmpty() const
+bool ReadaheadOperation::isContinue() const
 {
-    Lock lock(thread()->condition());
+    boost::mutex::scoped_lock lock(_mutex);
 
-    return _file_name.empty();
+    return _continue;
 }
 
-bool AnalyzerOperation::hasAnalyzer() const
+bool ReadaheadOperation::wait()
 {
-    Lock lock(thread()->condition());
+    boost::mutex::scoped_lock lock(_mutex);
 
-    return _analyzer;
+    const boost::system_time deadline = boost::get_system_time()
+        + boost::posix_time::milliseconds(READAHEAD_INTERVAL);
+
+    while(_continue
+            && _condition.timed_wait(lock, deadline))
+    {
+    }
+
+    return _continue;
 }
 
-bool AnalyzerOperation::hasController() const
+void ReadaheadOperation::process()
 {
+    // Window of the next tasks: the nearest tasks of all workers go first
+    //
+    std::vector<std::vector<InputChunk> > next(_tasks->workers());
+    for(uint32_t worker = 0; next.size() > worker; ++worker)
+    {
+        _tasks->peek(worker, _inputs, next[worker]);
+    }
+
+    std::vector<InputChunk> window;
+    for(uint32_t position = 0; _inputs > position; ++position)
+    {
+        for(uint32_t worker = 0; next.size() > worker; ++worker)
+        {
+            if (next[worker].size() > position)
+                window.push_back(next[worker][position]);
+        }
+    }
+
+    // Inputs taken by the workers leave the window and free the budget
+    //
+    Inputs loaded;
+    uint64_t bytes = 0;
+    for(std::vector<InputChunk>::const_iterator input = window.begin();
+            window.end() != input;
+            ++input)
+    {
+        Inputs::const_iterator previous = _loaded.find(key(*input));
+        if (_loaded.end() == previous)
+            continue;
+
+        loaded.insert(*previous);
+        bytes += previous->second;
+    }
+
+    _loaded.swap(loaded);
+
+    for(std::vector<InputChunk>::const_iterator input = window.begin();
+            window.end() != input
+                && isContinue();
+            ++input)
+    {
+        if (_loaded.end() != _loaded.find(key(*input))
+                || StreamReader::isStream(input->file_name))
+            continue;
+
+        const uint64_t size = inputSize(*input);
+        if (bytes + size > _max_bytes)
+            break;
+
+        load(*input, size);
+
+        _loaded[key(*input)] = size;
+        bytes += size;
+
+        _inputs_loaded.fetch_add(1, boost::memory_order_relaxed);
+        _bytes_loaded.fetch_add(size, boost::memory_order_relaxed);
+    }
+}
+
+void ReadaheadOperation::load(const InputChunk &input, const uint64_t &bytes)
+{
+    int fd = ::open(input.file_name.c_str(), O_RDONLY);
+    if (0 > fd)
+        return;
+
+    const uint64_t offset = input.isWholeFile() ? 0 : input.begin;
+
+#if defined(POSIX_FADV_WILLNEED)
+    // Pages are read asynchronously by the system
+    //
+    if (!posix_fadvise(fd, offset, bytes, POSIX_FADV_WILLNEED))
+    {
+        ::close(fd);
+
+        return;
+    }
+#endif
+
+    // Read input: pages stay in the cache
+    //
+    std::vector<char> buffer(READAHEAD_BUFFER_SIZE);
+    if (offset == static_cast<uint64_t>(lseek(fd, offset, SEEK_SET)))
+    {
+        for(uint64_t left = bytes; left && isContinue(); )
+        {
+            const ssize_t result = ::read(fd, &buffer[0],
+                    left < buffer.size() ? left : buffer.size());
+            if (0 >= result)
+                break;
+
+            left -= result;
+        }
+    }
+
+    ::close(fd);
+}
+
+ReadaheadOperation::Input
+    ReadaheadOperation::key(const InputChunk &input) const
+{
+    return make_pair(input.file_name, make_pair(input.begin, input.end));
+}
+
+
+
+// Reader Thread
+//
+ReaderOperation::ReaderOperation():
+    _continue(true),
+    _worker(0),
+    _use_mapped_reader(false),
+    _use_uring_reader(false),
+    _events_read(0),
+    _bytes_read(0),
+    _inputs_processed(0)
+{
+    _thread = 0;
+}
+
+void ReaderOperation::use(const InputTasksPtr &tasks, const uint32_t &worker)
+{
+    if (isRunning())
+        return;
+
+    _tasks = tasks;
+    _worker = worker;
+}
+
+void ReaderOperation::use(const EventRingPtr &events)
+{
+    if (isRunning())
+        return;
+
+    _events = events;
+}
+
+void ReaderOperation::use(const EventFields &fields)
+{
+    if (isRunning())
+        return;
+
+    _fields = fields;
+}
+
+void ReaderOperation::useMappedReader(const bool &use)
+{
+    if (isRunning())
+        return;
+
+    _use_mapped_reader = use;
+}
+
+void ReaderOperation::useUringReader(const bool &use)
+{
+    if (isRunning())
+        return;
+
+    _use_uring_reader = use;
+}
+
+void ReaderOperation::use(const StagingCachePtr &staging)
+{
+    if (isRunning())
+        return;
+
+    _staging = staging;
+}
+
+void ReaderOperation::run()
+{
+    if (!thread()
+            || !_events)
+        return;
+
+    if (_tasks)
+    {
+        for(InputChunk input;
+                isContinue()
+                    && _tasks->pop(_worker, input);
+                )
+        {
+            process(input);
+        }
+    }
+
+    // Let analyzers drain the ring
+    //
+    _events->removeProducer();
+}
+
+void ReaderOperation::stop()
+{
+    _continue.store(false, boost::memory_order_release);
+}
+
+void ReaderOperation::onThreadInit(Thread *thread)
+{
+    _thread = thread;
+}
+
+uint32_t ReaderOperation::worker() const
+{
+    return _worker;
+}
+
+uint32_t ReaderOperation::eventsRead() const
+{
+    return _events_read.load(boost::memory_order_relaxed);
+}
+
+uint64_t ReaderOperation::bytesRead() const
+{
+    return _bytes_read.load(boost::memory_order_relaxed);
+}
+
+uint32_t ReaderOperation::inputsProcessed() const
+{
+    return _inputs_processed.load(boost::memory_order_relaxed);
+}
+
+std::string ReaderOperation::currentInput() const
+{
+    boost::mutex::scoped_lock lock(_input_mutex);
+
+    return _input;
+}
+
+// Privates
+//
+Thread *ReaderOperation::thread() const
+{
+    return _thread;
+}
+
+bool ReaderOperation::isRunning() const
+{
+    return thread()
+        && thread()->isRunning();
+}
+
+bool ReaderOperation::isContinue() const
+{
+    return _continue.load(boost::memory_order_acquire);
+}
+
+void ReaderOperation::process(const InputChunk &chunk)
+{
+    {
+        boost::mutex::scoped_lock lock(_input_mutex);
+
+        _input = chunk.file_name;
+    }
+
+    EventBatchPtr batch(new EventBatch());
+    batch->file_name = chunk.file_name;
+
+    // Batches carry the original file name
+    //
+    const string file_name = _staging
+        ? _staging->stage(chunk.file_name)
+        : chunk.file_name;
+
+    // Staged copy may be evicted by another job before it is opened
+    //
+    if (!process(chunk, file_name, batch)
+            && file_name != chunk.file_name)
+        process(chunk, chunk.file_name, batch);
+
+    _bytes_read.fetch_add(inputSize(chunk), boost::memory_order_relaxed);
+    _inputs_processed.fetch_add(1, boost::memory_order_relaxed);
+}
+
+bool ReaderOperation::process(const InputChunk &chunk,
+        const string &file_name,
+        const EventBatchPtr &batch)
+{
+    if (StreamReader::isStream(chunk.file_name))
+    {
+        StreamReader reader(chunk.file_name);
+        reader.open();
+        if (!reader.isOpen())
+            return false;
+
+        batch->input = reader.input();
+
+        reader.use(_fields);
+        read(reader, batch);
+
+        _bytes_read.fetch_add(reader.tell(), boost::memory_order_relaxed);
+    }
+    else if (_use_mapped_reader)
+    {
+        MappedReader reader(file_name);
+        reader.open();
+        if (!reader.isOpen()
+                || !(chunk.isWholeFile()
+                    || reader.seek(chunk.begin, chunk.end)))
+            return false;
+
+        batch->input = reader.input();
+
+        reader.use(_fields);
+        read(reader, batch);
+    }
+    else if (chunk.isWholeFile()
+            && _fields.isAll()
+            && !_use_uring_reader)
+    {
+        Reader reader(file_name);
+        reader.open();
+        if (!reader.isOpen())
+            return false;
+
+        batch->input = reader.input();
+
+        read(reader, batch);
+    }
+    else
+    {
+        // bsm_input Reader parses all fields: RecordReader skips fields
+        // that are not used
+        //
+        RecordReader reader(file_name);
+        reader.useUring(_use_uring_reader);
+        reader.open();
+        if (!reader.isOpen()
+                || !(chunk.isWholeFile()
+                    || reader.seek(chunk.begin, chunk.end)))
+            return false;
+
+        batch->input = reader.input();
+
+        reader.use(_fields);
+        read(reader, batch);
+    }
+
+    return true;
+}
+
+// Read error is not the end of input: events after it are lost
+//
+template<class T>
+    static void reportReadError(const T &reader, const string &file_name)
+{
+    if (reader.hadError())
+        cerr << "failed to read input: " << file_name
+            << " at offset " << reader.tell() << endl;
+}
+
+// bsm_input Reader does not tell read errors from the end of file
+//
+static void reportReadError(const Reader &, const string &)
+{
+}
+
+template<class T>
+    void ReaderOperation::read(T &reader, EventBatchPtr batch)
+{
+    batch->events.reserve(EVENTS_PER_BATCH);
+
+    for(EventBatch::EventPtr event(new Event());
+            isContinue()
+                && reader.read(event);
+            event.reset(new Event()))
+    {
+        batch->events.push_back(event);
+
+        _events_read.fetch_add(1, boost::memory_order_relaxed);
+
+        if (EVENTS_PER_BATCH > batch->events.size())
+            continue;
+
+        // Ring is closed on cancellation
+        //
+        if (!_events->push(batch))
+            return;
+
+        EventBatchPtr next(new EventBatch());
+        next->file_name = batch->file_name;
+        next->input = batch->input;
+        next->events.reserve(EVENTS_PER_BATCH);
+
+        batch = next;
+    }
+
+    reportReadError(reader, batch->file_name);
+
+    // Analyzer is notified about the file even if there are no events
+    // left in it
+    //
+    _events->push(batch);
+}
+
+
+
+// Analyzer Thread
+//
+AnalyzerOperation::AnalyzerOperation():
+    _continue(true),
+    _has_job(false),
+    _shutdown(false),
+    _is_clone_reused(false),
+    _worker(0),
+    _use_mapped_reader(false),
+    _use_uring_reader(false),
+    _events_processed(0),
+    _total_events_size(0),
+    _inputs_processed(0),
+    _snapshot_generation(0)
+{
+    _thread = 0;
+    _controller = 0;
+}
+
+AnalyzerOperation::~AnalyzerOperation()
+{
+    // Check if thread is still working
+}
+
+void AnalyzerOperation::use(ThreadController *controller)
+{
+    if (!isIdle())
+        return;
+
+    _controller = controller;
+}
+
+void AnalyzerOperation::use(const AnalyzerPtr &master,
+        const AnalyzerPtr &prototype)
+{
+    if (!isIdle())
+        return;
+
+    _master = master;
+    _prototype = prototype;
+}
+
+void AnalyzerOperation::use(const InputTasksPtr &tasks, const uint32_t &worker)
+{
+    if (!isIdle())
+        return;
+
+    _tasks = tasks;
+    _worker = worker;
+}
+
+void AnalyzerOperation::use(const EventRingPtr &events)
+{
+    if (!isIdle())
+        return;
+
+    _events = events;
+}
+
+void AnalyzerOperation::useMappedReader(const bool &use)
+{
+    if (!isIdle())
+        return;
+
+    _use_mapped_reader = use;
+}
+
+void AnalyzerOperation::useUringReader(const bool &use)
+{
+    if (!isIdle())
+        return;
+
+    _use_uring_reader = use;
+}
+
+void AnalyzerOperation::use(const StagingCachePtr &staging)
+{
+    if (!isIdle())
+        return;
+
+    _staging = staging;
+}
+
+void AnalyzerOperation::setEventReset(const uint32_t &events)
+{
+    if (!isIdle())
+        return;
+
+    _recycler.setResetEvents(events);
+}
+
+void AnalyzerOperation::pin(const std::vector<int> &cpus)
+{
+    if (!isIdle())
+        return;
+
+    _cpus = cpus;
+}
+
+void AnalyzerOperation::startJob()
+{
+    {
+        Lock lock(thread()->condition());
+
+        if (_has_job)
+            return;
+
+        _continue.store(true, boost::memory_order_release);
+
+        _events_processed.store(0, boost::memory_order_relaxed);
+        _inputs_processed.store(0, boost::memory_order_relaxed);
+        _total_events_size.store(0, boost::memory_order_relaxed);
+
+        _has_job = true;
+    }
+
+    thread()->condition()->variable()->notify_all();
+}
+
+void AnalyzerOperation::shutdown()
+{
+    {
+        Lock lock(thread()->condition());
+
+        _continue.store(false, boost::memory_order_release);
+        _shutdown = true;
+    }
+
+    thread()->condition()->variable()->notify_all();
+}
+
+bool AnalyzerOperation::isIdle() const
+{
+    if (!thread())
+        return true;
+
     Lock lock(thread()->condition());
 
-    return _controller;
+    return !_has_job;
+}
+
+bool AnalyzerOperation::isCloneReused() const
+{
+    return _is_clone_reused;
+}
+
+AnalyzerPtr AnalyzerOperation::analyzer() const
+{
+    return _analyzer;
+}
+
+void AnalyzerOperation::run()
+{
+    if (!thread()
+            || !hasController())
+        return;
+
+    for(; waitForJob(); finishJob())
+    {
+        pinThread();
+        prepareAnalyzer();
+
+        if (!hasAnalyzer())
+            continue;
+
+        _recycler.resetCounters();
+
+        if (hasEvents())
+        {
+            processEvents();
+        }
+        else if (hasTasks())
+        {
+            const bool has_snapshots = _controller->hasSnapshots();
+
+            _processed_inputs.clear();
+            _snapshot_generation = 0;
+
+            for(InputChunk input;
+                    isContinue()
+                        && _tasks->pop(_worker, input);
+                    )
+            {
+                // Process file
+                //
+                process(input);
+
+                if (has_snapshots
+                        && isContinue())
+                {
+                    _processed_inputs.push_back(input);
+                    _controller->addProcessedInput();
+                }
+
+                // Start run loop
+                //
+                _thread->runLoop()->run();
+
+                // Results are consistent between inputs only
+                //
+                if (has_snapshots
+                        && _snapshot_generation
+                            != _controller->snapshotGeneration())
+                    publishSnapshot(false);
+            }
+
+            if (has_snapshots
+                    && isContinue())
+                publishSnapshot(true);
+        }
+
+        // Idle thread does not hold memory of the decoded events
+        //
+        _recycler.reset();
+
+        reduce();
+    }
+}
+
+// Stop running job: thread stays in the pool
+//
+void AnalyzerOperation::stop()
+{
+    _continue.store(false, boost::memory_order_release);
+}
+
+void AnalyzerOperation::onThreadInit(Thread *thread)
+{
+    _thread = thread;
+}
+
+Thread *AnalyzerOperation::thread() const
+{
+    return _thread;
+}
+
+void AnalyzerOperation::onRunLoopCommand(const uint32_t &command)
+{
+    switch(command)
+    {
+        case KeyboardOperation::QUIT: _thread->stop();
+                   break;
+
+        default: break;
+    }
+}
+
+uint32_t AnalyzerOperation::eventsProcessed() const
+{
+    return _events_processed.load(boost::memory_order_relaxed);
+}
+
+uint64_t AnalyzerOperation::totalEventsSize() const
+{
+    return _total_events_size.load(boost::memory_order_relaxed);
+}
+
+uint32_t AnalyzerOperation::inputsProcessed() const
+{
+    return _inputs_processed.load(boost::memory_order_relaxed);
+}
+
+uint32_t AnalyzerOperation::eventResets() const
+{
+    return _recycler.resets();
+}
+
+uint64_t AnalyzerOperation::peakEventBytes() const
+{
+    return _recycler.peakBytes();
+}
+
+std::string AnalyzerOperation::currentInput() const
+{
+    boost::mutex::scoped_lock lock(_input_mutex);
+
+    return _input;
+}
+
+// Privates
+//
+bool AnalyzerOperation::isContinue() const
+{
+    return _continue.load(boost::memory_order_acquire);
+}
+
+bool AnalyzerOperation::hasAnalyzer() const
+{
+    Lock lock(thread()->condition());
+
+    return _analyzer;
+}
+
+bool AnalyzerOperation::hasController() const
+{
+    Lock lock(thread()->condition());
+
+    return _controller;
+}
+
+bool AnalyzerOperation::hasTasks() const
+{
+    Lock lock(thread()->condition());
+
+    return _tasks;
+}
+
+bool AnalyzerOperation::hasEvents() const
+{
+    Lock lock(thread()->condition());
+
+    return _events;
+}
+
+bool AnalyzerOperation::waitForJob()
+{
+    Lock lock(thread()->condition());
+
+    while(!_has_job
+            && !_shutdown)
+    {
+        thread()->condition()->variable()->wait(lock());
+    }
+
+    return !_shutdown;
+}
+
+void AnalyzerOperation::finishJob()
+{
+    {
+        Lock lock(thread()->condition());
+
+        _master.reset();
+        _prototype.reset();
+        _tasks.reset();
+        _events.reset();
+
+        _has_job = false;
+    }
+
+    {
+        boost::mutex::scoped_lock lock(_input_mutex);
+
+        _input.clear();
+    }
+
+    notifyController();
+}
+
+void AnalyzerOperation::pinThread()
+{
+    if (_cpus.empty())
+        return;
+
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for(std::vector<int>::const_iterator cpu = _cpus.begin();
+            _cpus.end() != cpu;
+            ++cpu)
+    {
+        CPU_SET(*cpu, &cpu_set);
+    }
+
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+#endif
+}
+
+void AnalyzerOperation::prepareAnalyzer()
+{
+    _is_clone_reused = false;
+
+    if (!_master
+            || !_prototype)
+    {
+        Lock lock(thread()->condition());
+
+        _analyzer.reset();
+
+        return;
+    }
+
+    // Clones of the previous job are not in use any more: all of them
+    // were reduced and merged into the master
+    //
+    if (_analyzer
+            && _master == _cloned_from.lock()
+            && _analyzer->reset())
+    {
+        _is_clone_reused = true;
+
+        return;
+    }
+
+    // Prototype is never modified: it is safe to clone it from several
+    // threads at once
+    //
+    AnalyzerPtr analyzer =
+        boost::dynamic_pointer_cast<Analyzer>(_prototype->clone());
+
+    Lock lock(thread()->condition());
+
+    _analyzer = analyzer;
+    _cloned_from = _master;
+}
+
+AnalyzerOperation::ReaderPtr
+    AnalyzerOperation::createReader(const InputChunk &input)
+{
+    // Thread lock is not held while input is opened: analyzer is only
+    // replaced by the thread itself and stats are read meanwhile
+    //
+    ReaderPtr reader(new Reader(input.file_name));
+
+    reader->open();
+    if (reader->isOpen())
+        _analyzer->onFileOpen(currentInput(), reader->input().get());
+    else
+        reader.reset();
+
+    return reader;
+}
+
+AnalyzerOperation::RecordReaderPtr
+    AnalyzerOperation::createRecordReader(const InputChunk &chunk)
+{
+    RecordReaderPtr reader(new RecordReader(chunk.file_name));
+
+    reader->useUring(_use_uring_reader);
+    reader->open();
+    if (reader->isOpen()
+            && (chunk.isWholeFile()
+                || reader->seek(chunk.begin, chunk.end)))
+    {
+        reader->use(_analyzer->fields());
+
+        _analyzer->onFileOpen(currentInput(), reader->input().get());
+    }
+    else
+        reader.reset();
+
+    return reader;
+}
+
+AnalyzerOperation::MappedReaderPtr
+    AnalyzerOperation::createMappedReader(const InputChunk &chunk)
+{
+    MappedReaderPtr reader(new MappedReader(chunk.file_name));
+
+    reader->open();
+    if (reader->isOpen()
+            && (chunk.isWholeFile()
+                || reader->seek(chunk.begin, chunk.end)))
+    {
+        reader->use(_analyzer->fields());
+
+        _analyzer->onFileOpen(currentInput(), reader->input().get());
+    }
+    else
+        reader.reset();
+
+    return reader;
+}
+
+void AnalyzerOperation::process(const InputChunk &input)
+{
+    using boost::posix_time::microsec_clock;
+
+    {
+        boost::mutex::scoped_lock lock(_input_mutex);
+
+        _input = input.file_name;
+    }
+
+    // Readers open the local copy of the input. Copy time is not part of
+    // the input processing time
+    //
+    InputChunk local = input;
+    if (_staging)
+        local.file_name = _staging->stage(input.file_name);
+
+    const boost::posix_time::ptime start = microsec_clock::universal_time();
+
+    // Staged copy may be evicted by another job before it is opened:
+    // original input is read instead
+    //
+    if (!processInput(local)
+            && local.file_name != input.file_name)
+        processInput(input);
+
+    const uint64_t bytes = inputSize(input);
+
+    // Interrupted input does not give its processing time
+    //
+    if (isContinue())
+        _controller->addRuntime(input, bytes,
+                (microsec_clock::universal_time() - start)
+                    .total_microseconds() / 1e6);
+
+    _total_events_size.fetch_add(bytes, boost::memory_order_relaxed);
+    _inputs_processed.fetch_add(1, boost::memory_order_relaxed);
+}
+
+bool AnalyzerOperation::processInput(const InputChunk &input)
+{
+    // bsm_input Reader parses all fields: whole files are read with
+    // RecordReader if analyzer uses only some of them or io_uring is used
+    //
+    if (_use_mapped_reader)
+        return processReader(createMappedReader(input));
+
+    if (input.isWholeFile()
+            && _analyzer->fields().isAll()
+            && !_use_uring_reader)
+        return processReader(createReader(input));
+
+    return processReader(createRecordReader(input));
+}
+
+template<class T>
+    bool AnalyzerOperation::processReader(
+            const boost::shared_ptr<T> &reader)
+{
+    if (!reader)
+        return false;
+
+    for(; isContinue()
+                && reader->read(_recycler.event());
+            _recycler.recycle())
+    {
+        _analyzer->process(_recycler.event().get());
+
+        _events_processed.fetch_add(1, boost::memory_order_relaxed);
+    }
+
+    reportReadError(*reader, currentInput());
+
+    return true;
+}
+
+void AnalyzerOperation::processEvents()
+{
+    // Keep track of the current file: batches of the same input come in
+    // a row from one reader but are interleaved with other readers' ones
+    //
+    EventBatch current;
+    bool is_file_open = false;
+
+    for(EventBatchPtr batch;
+            isContinue()
+                && _events->pop(batch);
+            )
+    {
+        if (!is_file_open
+                || current.input != batch->input
+                || current.file_name != batch->file_name)
+        {
+            current.file_name = batch->file_name;
+            current.input = batch->input;
+            is_file_open = true;
+
+            {
+                boost::mutex::scoped_lock lock(_input_mutex);
+
+                _input = current.file_name;
+            }
+
+            _analyzer->onFileOpen(current.file_name, current.input.get());
+        }
+
+        for(EventBatch::Events::const_iterator event = batch->events.begin();
+                isContinue()
+                    && batch->events.end() != event;
+                ++event)
+        {
+            _analyzer->process(event->get());
+
+            _events_processed.fetch_add(1, boost::memory_order_relaxed);
+        }
+
+        // Start run loop
+        //
+        _thread->runLoop()->run();
+    }
+}
+
+void AnalyzerOperation::publishSnapshot(const bool &is_done)
+{
+    _snapshot_generation = _controller->snapshotGeneration();
+
+    // Clone is owned by the controller: thread goes on with own analyzer
+    //
+    _controller->addSnapshot(_worker,
+            boost::dynamic_pointer_cast<Analyzer>(_analyzer->clone()),
+            _processed_inputs,
+            is_done);
+}
+
+void AnalyzerOperation::reduce()
+{
+    // Reduction is done even if thread is stopped: results of the
+    // processed events are kept
+    //
+    for(AnalyzerPtr partner;
+            _controller->reduce(_analyzer, partner);
+            partner.reset())
+    {
+        _analyzer->merge(partner);
+    }
+}
+
+void AnalyzerOperation::notifyController()
+{
+    // Thread lock should not be held here: Controller locks its own mutex
+    // first and only then locks threads, e.g. on quit
+    //
+    Lock lock(_controller->condition());
+
+    _controller->threadIsWaiting(thread());
+    _controller->condition()->variable()->notify_all();
+}
+
+
+
+// Thread Controller summary
+//
+class ThreadController::Summary
+{
+    public:
+        Summary():
+            _events_processed(0),
+            _files_processed(0),
+            _total_events_size(0),
+            _clones_reused(0),
+            _inputs_stolen(0),
+            _inputs_resumed(0),
+            _inputs_failed(0),
+            _analyzer_threads(0),
+            _reader_threads(0),
+            _worker_processes(0),
+            _inputs_loaded(0),
+            _bytes_loaded(0),
+            _event_resets(0),
+            _peak_event_bytes(0),
+            _staging_hits(0),
+            _staging_copies(0),
+            _staging_bypasses(0),
+            _staging_bytes(0),
+            _start(boost::posix_time::microsec_clock::universal_time())
+        {
+        }
+
+        // Seconds since the job start
+        //
+        double elapsed() const
+        {
+            return (boost::posix_time::microsec_clock::universal_time()
+                    - _start).total_milliseconds() / 1000.;
+        }
+
+        uint64_t eventsProcessed() const
+        {
+            return _events_processed;
+        }
+
+        uint32_t filesProcessed() const
+        {
+            return _files_processed;
+        }
+
+        uint64_t totalEventsSize() const
+        {
+            return _total_events_size;
+        }
+
+        uint32_t clonesReused() const
+        {
+            return _clones_reused;
+        }
+
+        uint32_t inputsStolen() const
+        {
+            return _inputs_stolen;
+        }
+
+        uint32_t inputsResumed() const
+        {
+            return _inputs_resumed;
+        }
+
+        uint32_t inputsFailed() const
+        {
+            return _inputs_failed;
+        }
+
+        // Maximum number of threads used by any round
+        //
+        uint32_t analyzerThreads() const
+        {
+            return _analyzer_threads;
+        }
+
+        uint32_t readerThreads() const
+        {
+            return _reader_threads;
+        }
+
+        uint32_t workerProcesses() const
+        {
+            return _worker_processes;
+        }
+
+        uint32_t inputsLoaded() const
+        {
+            return _inputs_loaded;
+        }
+
+        uint64_t bytesLoaded() const
+        {
+            return _bytes_loaded;
+        }
+
+        uint32_t eventResets() const
+        {
+            return _event_resets;
+        }
+
+        // Largest memory held by the decoded Event in any thread
+        //
+        uint64_t peakEventBytes() const
+        {
+            return _peak_event_bytes;
+        }
+
+        uint32_t stagingHits() const
+        {
+            return _staging_hits;
+        }
+
+        uint32_t stagingCopies() const
+        {
+            return _staging_copies;
+        }
+
+        uint32_t stagingBypasses() const
+        {
+            return _staging_bypasses;
+        }
+
+        uint64_t stagingBytes() const
+        {
+            return _staging_bytes;
+        }
+
+        // Fraction of the staged inputs found in the cache
+        //
+        double stagingHitRate() const
+        {
+            const uint32_t staged = _staging_hits + _staging_copies
+                + _staging_bypasses;
+
+            return staged ? 1. * _staging_hits / staged : 0;
+        }
+
+        uint32_t averageEventSize() const
+        {
+            return eventsProcessed()
+                ? (_total_events_size / eventsProcessed())
+                : 0;
+        }
+
+        void addEventsProcessed(const uint64_t &events)
+        {
+            _events_processed += events;
+        }
+
+        void addFilesProcessed(const uint32_t &files)
+        {
+            _files_processed += files;
+        }
+
+        void addEventsSize(const uint64_t &size)
+        {
+            _total_events_size += size;
+        }
+
+        void addClonesReused(const uint32_t &clones)
+        {
+            _clones_reused += clones;
+        }
+
+        void addInputsStolen(const uint32_t &inputs)
+        {
+            _inputs_stolen += inputs;
+        }
+
+        void addInputsResumed(const uint32_t &inputs)
+        {
+            _inputs_resumed += inputs;
+        }
+
+        void addInputsFailed(const uint32_t &inputs)
+        {
+            _inputs_failed += inputs;
+        }
+
+        void useThreads(const uint32_t &analyzers, const uint32_t &readers)
+        {
+            if (analyzers > _analyzer_threads)
+                _analyzer_threads = analyzers;
+
+            if (readers > _reader_threads)
+                _reader_threads = readers;
+        }
+
+        void addInputsLoaded(const uint32_t &inputs, const uint64_t &bytes)
+        {
+            _inputs_loaded += inputs;
+            _bytes_loaded += bytes;
+        }
+
+        void useProcesses(const uint32_t &processes)
+        {
+            if (processes > _worker_processes)
+                _worker_processes = processes;
+        }
+
+        void addEventRecycler(const uint32_t &resets, const uint64_t &bytes)
+        {
+            _event_resets += resets;
+
+            if (bytes > _peak_event_bytes)
+                _peak_event_bytes = bytes;
+        }
+
+        void addStaging(const uint32_t &hits,
+                const uint32_t &copies,
+                const uint32_t &bypasses,
+                const uint64_t &bytes)
+        {
+            _staging_hits += hits;
+            _staging_copies += copies;
+            _staging_bypasses += bypasses;
+            _staging_bytes += bytes;
+        }
+
+    private:
+        uint64_t _events_processed;
+        uint32_t _files_processed;
+        uint64_t _total_events_size;
+        uint32_t _clones_reused;
+        uint32_t _inputs_stolen;
+        uint32_t _inputs_resumed;
+        uint32_t _inputs_failed;
+        uint32_t _analyzer_threads;
+        uint32_t _reader_threads;
+        uint32_t _worker_processes;
+        uint32_t _inputs_loaded;
+        uint64_t _bytes_loaded;
+        uint32_t _event_resets;
+        uint64_t _peak_event_bytes;
+        uint32_t _staging_hits;
+        uint32_t _staging_copies;
+        uint32_t _staging_bypasses;
+        uint64_t _staging_bytes;
+
+        boost::posix_time::ptime _start;
+};
+
+// Thread controller
+//
+ThreadController::Snapshot::Snapshot():
+    generation(0),
+    is_done(false)
+{
+}
+
+ThreadController::ThreadController():
+    _max_threads(boost::thread::hardware_concurrency()),
+    _events_per_chunk(0),
+    _reader_threads(0),
+    _processes(0),
+    _stats_interval(0),
+    _events_expected(0),
+    _readahead_inputs(0),
+    _readahead_bytes(0),
+    _use_mapped_reader(false),
+    _use_uring_reader(false),
+    _event_reset(0),
+    _staging_bytes(0),
+    _checkpoint_inputs(0),
+    _resume(false),
+    _snapshot_generation(0),
+    _snapshot_written(0),
+    _inputs_unsaved(0),
+    _is_snapshot_ready(false),
+    _process_memory(0),
+    _process_slots(0),
+    _is_cancelled(false),
+    _use_processes(false)
+{
+    _allowed_cpus = allowedCPUs();
+
+    _condition.reset(new core::Condition());
+    _input_files.reset(new InputFiles());
+    _pending_files.reset(new InputFiles());
+
+    _threads_waiting.reset(new ThreadsFIFO());
+}
+
+ThreadController::~ThreadController()
+{
+    stopProcesses();
+    stopPool();
+}
+
+void ThreadController::stopPool()
+{
+    // Pool threads wait for the next job: let them quit
+    //
+    for(ThreadPool::iterator thread = _pool.begin();
+            _pool.end() != thread;
+            ++thread)
+    {
+        AnalyzerOperationPtr operation =
+            boost::dynamic_pointer_cast<AnalyzerOperation>(
+                    (*thread)->operation());
+
+        if (operation)
+            operation->shutdown();
+    }
+
+    for(ThreadPool::iterator thread = _pool.begin();
+            _pool.end() != thread;
+            ++thread)
+    {
+        (*thread)->join();
+    }
+
+    _pool.clear();
+}
+
+bsm::core::ConditionPtr ThreadController::condition() const
+{
+    return _condition;
+}
+
+void ThreadController::use(const AnalyzerPtr &analyzer)
+{
+    _analyzer = analyzer;
+}
+
+void ThreadController::push(const std::string &file_name)
+{
+    Lock lock(condition());
+
+    _input_files->push(InputChunk(file_name));
+}
+
+void ThreadController::setMaxThreads(const uint32_t &threads)
+{
+    Lock lock(condition());
+
+    _max_threads = threads
+        ? threads
+        : boost::thread::hardware_concurrency();
+}
+
+void ThreadController::setPinThreads(const bool &pin)
+{
+    Lock lock(condition());
+
+    if (pin)
+        _cpus = _allowed_cpus;
+    else
+        _cpus.clear();
+}
+
+void ThreadController::setEventsPerChunk(const uint32_t &events)
+{
+    Lock lock(condition());
+
+    _events_per_chunk = events;
+}
+
+void ThreadController::setReaderThreads(const uint32_t &readers)
+{
+    Lock lock(condition());
+
+    _reader_threads = readers;
+}
+
+void ThreadController::setCheckpoint(const std::string &file_name,
+        const uint32_t &inputs)
+{
+    Lock lock(condition());
+
+    _checkpoint_file = file_name;
+    _checkpoint_inputs = inputs;
+}
+
+void ThreadController::setResume(const bool &resume)
+{
+    Lock lock(condition());
+
+    _resume = resume;
+}
+
+void ThreadController::setProcesses(const uint32_t &processes)
+{
+    Lock lock(condition());
+
+    _processes = processes;
+}
+
+void ThreadController::setStats(const std::string &file_name,
+        const uint32_t &interval)
+{
+    Lock lock(condition());
+
+    _stats_file = file_name;
+    _stats_interval = interval;
+}
+
+void ThreadController::setHistory(const std::string &file_name)
+{
+    Lock lock(condition());
+
+    _history_file = file_name;
+}
+
+void ThreadController::setManifest(const std::string &file_name)
+{
+    Lock lock(condition());
+
+    _manifest_file = file_name;
+}
+
+void ThreadController::setReadahead(const uint32_t &inputs,
+        const uint32_t &megabytes)
+{
+    Lock lock(condition());
+
+    _readahead_inputs = inputs;
+    _readahead_bytes = static_cast<uint64_t>(megabytes) * 1024 * 1024;
+}
+
+void ThreadController::setMappedReader(const bool &use)
+{
+    Lock lock(condition());
+
+    _use_mapped_reader = use;
+}
+
+void ThreadController::setUringReader(const bool &use)
+{
+    Lock lock(condition());
+
+    _use_uring_reader = use;
+}
+
+void ThreadController::setEventReset(const uint32_t &events)
+{
+    Lock lock(condition());
+
+    _event_reset = events;
+}
+
+void ThreadController::setStaging(const std::string &directory,
+        const uint32_t &megabytes)
+{
+    Lock lock(condition());
+
+    _staging_directory = directory;
+    _staging_bytes = static_cast<uint64_t>(megabytes) * 1024 * 1024;
+}
+
+void ThreadController::start()
+{
+    if (!hasInputFiles()
+            || !hasAnalyzer())
+        return;
+
+    {
+        Lock lock(condition());
+
+        _summary.reset(new Summary());
+        _is_cancelled = false;
+    }
+
+    splitInputs();
+
+    // Workers start from the analyzer state at the job start: master
+    // accumulates results of the rounds
+    //
+    _prototype = boost::dynamic_pointer_cast<Analyzer>(_analyzer->clone());
+
+    _use_processes = _processes;
+    if (_use_processes
+            && !canSave(*_prototype))
+    {
+        cerr << "analyzer results can not be passed between processes: "
+            << "analyzer does not support save/load" << endl;
+    }
+    else if (openCheckpoint())
+    {
+        {
+            Lock lock(condition());
+
+            if (!_history_file.empty())
+            {
+                _history.reset(new RuntimeHistory(_history_file));
+                _history->load();
+            }
+
+            if (!_manifest_file.empty())
+            {
+                _manifest.reset(new DatasetManifest(_manifest_file));
+                if (!_manifest->load())
+                {
+                    cerr << "failed to load dataset manifest: "
+                        << _manifest_file << endl;
+
+                    _manifest.reset();
+                }
+            }
+
+            if (!_staging_directory.empty())
+                _staging.reset(new StagingCache(_staging_directory,
+                            _staging_bytes));
+        }
+
+        sortInputs();
+
+        {
+            Lock lock(condition());
+
+            _pending_files->swap(*_input_files);
+        }
+
+        // Worker processes are forked before any thread is started:
+        // child inherits only the forking thread
+        //
+        const bool has_workers = !_use_processes
+            || startProcesses();
+        if (!has_workers)
+            cerr << "failed to start worker processes" << endl;
+
+        startKeyboardThread();
+        startStatsThread();
+
+        for(InputFiles round; has_workers && nextRound(round); )
+        {
+            InputFiles merged;
+            processRound(merged);
+            saveCheckpoint(merged);
+        }
+
+        stopStatsThread();
+        stopKeyboardThread();
+
+        stopProcesses();
+
+        if (_staging)
+        {
+            Lock lock(condition());
+
+            _summary->addStaging(_staging->hits(),
+                    _staging->copies(),
+                    _staging->bypasses(),
+                    _staging->bytesCopied());
+        }
+
+        cout << "Job Summary" << endl;
+        cout << "  Processed Events: " << _summary->eventsProcessed()
+            << endl;
+        cout << "  Processed Inputs: " << _summary->filesProcessed()
+            << endl;
+        if (_checkpoint)
+            cout << "   Resumed  Inputs: " << _summary->inputsResumed()
+                << endl;
+        cout << "    Stolen  Inputs: " << _summary->inputsStolen() << endl;
+        if (_summary->inputsFailed())
+            cout << "    Failed  Inputs: " << _summary->inputsFailed()
+                << endl;
+        if (_use_processes)
+        {
+            cout << "  Worker Processes: " << _summary->workerProcesses()
+                << endl;
+        }
+        else
+        {
+            cout << " Analyzer  Threads: " << _summary->analyzerThreads()
+                << (_cpus.empty() ? "" : " (pinned)") << endl;
+            cout << "   Reader  Threads: " << _summary->readerThreads()
+                << endl;
+        }
+        cout << "    Reused  Clones: " << _summary->clonesReused() << endl;
+        if (_readahead_inputs)
+            cout << "  Readahead Inputs: " << _summary->inputsLoaded()
+                << " (" << _summary->bytesLoaded() / 1024 / 1024 << " MB)"
+                << endl;
+        if (_staging)
+        {
+            // Analyzers print results after the summary: output format
+            // is not changed
+            //
+            std::ostringstream hit_rate;
+            hit_rate << fixed << setprecision(1)
+                << 100 * _summary->stagingHitRate();
+
+            cout << "    Staged  Inputs: " << _summary->stagingHits()
+                << " hits, " << _summary->stagingCopies() << " copies, "
+                << _summary->stagingBypasses() << " bypassed ("
+                << hit_rate.str() << "% hit rate, "
+                << _summary->stagingBytes() / 1024 / 1024 << " MB copied)"
+                << endl;
+        }
+        // Pipelined analyzers take events from the readers: recycler is
+        // not used
+        //
+        if (_event_reset
+                && !_summary->readerThreads())
+            cout << "   Event  Recycler: " << _summary->eventResets()
+                << " resets (peak " << _summary->peakEventBytes() / 1024
+                << " KB)" << endl;
+        cout << "Average Event Size: " << _summary->averageEventSize()
+            << endl;
+        cout << endl;
+    }
+
+    Lock lock(condition());
+
+    if (_history
+            && !_history->save())
+        cerr << "failed to save runtime history: " << _history->filename()
+            << endl;
+
+    while(!_input_files->empty())
+    {
+        _input_files->pop();
+    }
+
+    _history.reset();
+    _summary.reset();
+    _checkpoint.reset();
+    _prototype.reset();
+}
+
+void 
+ThreadController::threadIsWaiting(Thread *thread)
+{
+    _threads_waiting->push(thread);
+}
+
+bool ThreadController::reduce(const AnalyzerPtr &analyzer,
+        AnalyzerPtr &partner)
+{
+    Lock lock(condition());
+
+    if (!_reduced_analyzer)
+    {
+        _reduced_analyzer = analyzer;
+
+        return false;
+    }
+
+    partner = _reduced_analyzer;
+    _reduced_analyzer.reset();
+
+    return true;
+}
+
+bool ThreadController::hasSnapshots() const
+{
+    Lock lock(condition());
+
+    return !_snapshots.empty();
+}
+
+uint32_t ThreadController::snapshotGeneration() const
+{
+    return _snapshot_generation.load(boost::memory_order_acquire);
+}
+
+void ThreadController::addProcessedInput()
+{
+    Lock lock(condition());
+
+    if (_snapshots.empty()
+            || _checkpoint_inputs > ++_inputs_unsaved)
+        return;
+
+    _inputs_unsaved = 0;
+    _snapshot_generation.fetch_add(1, boost::memory_order_release);
+}
+
+void ThreadController::addSnapshot(const uint32_t &worker,
+        const AnalyzerPtr &results,
+        const std::vector<InputChunk> &inputs,
+        const bool &is_done)
+{
+    Lock lock(condition());
+
+    if (worker >= _snapshots.size())
+        return;
+
+    const uint32_t generation =
+        _snapshot_generation.load(boost::memory_order_acquire);
+
+    Snapshot &snapshot = _snapshots[worker];
+    snapshot.results = results;
+    snapshot.inputs = inputs;
+    snapshot.generation = generation;
+    snapshot.is_done = is_done;
+
+    // Generation is written once all threads either published it or ran
+    // out of inputs
+    //
+    if (_snapshot_written == generation)
+        return;
+
+    for(Snapshots::const_iterator published = _snapshots.begin();
+            _snapshots.end() != published;
+            ++published)
+    {
+        if (!published->is_done
+                && generation != published->generation)
+            return;
+    }
+
+    _snapshot_written = generation;
+    _is_snapshot_ready = true;
+
+    condition()->variable()->notify_all();
+}
+
+void ThreadController::addRuntime(const InputChunk &input,
+        const uint64_t &bytes,
+        const double &seconds)
+{
+    Lock lock(condition());
+
+    if (_history)
+        _history->add(input, bytes, seconds);
+}
+
+void ThreadController::quit()
+{
+    Lock lock(condition());
+
+    if (_keyboard_thread)
+        _keyboard_thread->stop();
+
+    _is_cancelled = true;
+
+    while(!_input_files->empty())
+    {
+        _input_files->pop();
+    }
+
+    while(!_pending_files->empty())
+    {
+        _pending_files->pop();
+    }
+
+    if (_tasks)
+        _tasks->clear();
+
+    // Wake up readers waiting for space and analyzers waiting for events
+    //
+    if (_events)
+        _events->close();
+
+    for(Threads::iterator thread = _readers.begin();
+            _readers.end() != thread;
+            ++thread)
+    {
+        thread->first->stop();
+    }
+
+    for(Threads::iterator thread = _threads.begin();
+            _threads.end() != thread;
+            ++thread)
+    {
+        thread->first->stop();
+    }
+
+    for(Processes::const_iterator child = _children.begin();
+            _children.end() != child;
+            ++child)
+    {
+        kill(child->pid, SIGTERM);
+    }
 }
 
-AnalyzerOperation::ReaderPtr AnalyzerOperation::createReader()
+void ThreadController::info()
 {
-    Lock lock(thread()->condition());
+    const JobStats job = stats();
 
-    ReaderPtr reader(new Reader(_file_name));
-    _file_name.clear();
+    cout << "INFO" << endl;
+    cout << "Inputs p: " << job.inputs_processed << " l: "
+        << job.inputs_left << endl;
+    cout << "Events p: " << job.events;
+    if (job.events_expected)
+        cout << " of " << job.events_expected;
+    cout << endl;
+    if (job.batches_capacity)
+        cout << "Events q: " << job.batches << " batches of "
+            << job.batches_capacity << endl;
+    if (job.processes)
+        cout << "Processes: " << job.processes << endl;
+    cout << endl;
+}
 
-    reader->open();
-    if (reader->isOpen())
-        _analyzer->onFileOpen(reader->filename(), reader->input().get());
-    else
-        reader.reset();
+JobStats ThreadController::stats() const
+{
+    Lock lock(condition());
 
-    return reader;
+    JobStats stats;
+    if (!_summary)
+        return stats;
+
+    stats.elapsed = _summary->elapsed();
+    stats.events = _summary->eventsProcessed();
+    stats.bytes = _summary->totalEventsSize();
+    stats.events_expected = _events_expected;
+    stats.inputs_processed = _summary->filesProcessed();
+    stats.inputs_left = _pending_files->size()
+        + _input_files->size()
+        + (_tasks ? _tasks->size() : 0);
+
+    if (_events)
+    {
+        stats.batches = _events->size();
+        stats.batches_capacity = _events->capacity();
+    }
+
+    stats.processes = _children.size();
+
+    // Counters are atomic and current input has own lock: no thread lock
+    // is taken under the controller one and workers are not blocked while
+    // progress is read
+    //
+    for(uint32_t worker = 0; _pool.size() > worker; ++worker)
+    {
+        if (_threads.end() == _threads.find(_pool[worker].get()))
+            continue;
+
+        AnalyzerOperationPtr operation =
+            boost::dynamic_pointer_cast<AnalyzerOperation>(
+                    _pool[worker]->operation());
+
+        if (!operation)
+            continue;
+
+        ThreadStats thread;
+        thread.type = "analyzer";
+        thread.id = worker;
+        thread.events = operation->eventsProcessed();
+        thread.bytes = operation->totalEventsSize();
+        thread.input = operation->currentInput();
+
+        stats.events += thread.events;
+        stats.bytes += thread.bytes;
+        stats.inputs_processed += operation->inputsProcessed();
+        stats.threads.push_back(thread);
+    }
+
+    for(Threads::const_iterator reader = _readers.begin();
+            _readers.end() != reader;
+            ++reader)
+    {
+        ReaderOperationPtr operation =
+            boost::dynamic_pointer_cast<ReaderOperation>(
+                    reader->first->operation());
+
+        if (!operation)
+            continue;
+
+        ThreadStats thread;
+        thread.type = "reader";
+        thread.id = operation->worker();
+        thread.events = operation->eventsRead();
+        thread.bytes = operation->bytesRead();
+        thread.input = operation->currentInput();
+
+        stats.bytes += thread.bytes;
+        stats.inputs_processed += operation->inputsProcessed();
+        stats.threads.push_back(thread);
+    }
+
+    return stats;
 }
 
-void AnalyzerOperation::processFile()
+// Private
+//
+bool ThreadController::hasInputFiles() const
 {
-    if (isFileEmpty())
-        return;
+    Lock lock(condition());
 
-    ReaderPtr reader = createReader();
-    if (!reader)
+    return !_input_files->empty();
+}
+
+bool ThreadController::hasAnalyzer() const
+{
+    Lock lock(condition());
+
+    return _analyzer;
+}
+
+bool ThreadController::isCancelled() const
+{
+    Lock lock(condition());
+
+    return _is_cancelled;
+}
+
+bool ThreadController::openCheckpoint()
+{
+    Lock lock(condition());
+
+    if (_checkpoint_file.empty())
+        return true;
+
+    // Checkpoint is useless if analyzer can not save results
+    //
+    if (!canSave(*_prototype))
+    {
+        cerr << "analyzer does not support checkpoints: "
+            << "checkpoint is turned off" << endl;
+
+        return true;
+    }
+
+    _checkpoint.reset(new Checkpoint(_checkpoint_file));
+
+    if (!_resume)
+    {
+        _checkpoint->setEventsPerChunk(_events_per_chunk);
+
+        return true;
+    }
+
+    // Start from scratch if there is nothing to resume
+    //
+    if (access(_checkpoint_file.c_str(), F_OK))
+    {
+        _checkpoint->setEventsPerChunk(_events_per_chunk);
+
+        return true;
+    }
+
+    AnalyzerPtr results =
+        boost::dynamic_pointer_cast<Analyzer>(_prototype->clone());
+    if (!_checkpoint->load(*results))
+    {
+        cerr << "failed to load checkpoint: " << _checkpoint_file << endl;
+
+        return false;
+    }
+
+    // Chunks are identified by byte offsets: inputs should be split the
+    // same way
+    //
+    if (_events_per_chunk != _checkpoint->eventsPerChunk())
+    {
+        cerr << "checkpoint was written with "
+            << _checkpoint->eventsPerChunk()
+            << " events per chunk: use the same chunk size to resume"
+            << endl;
+
+        return false;
+    }
+
+    InputFiles inputs;
+    for(; !_input_files->empty(); _input_files->pop())
+    {
+        if (_checkpoint->isProcessed(_input_files->front()))
+            _summary->addInputsResumed(1);
+        else
+            inputs.push(_input_files->front());
+    }
+
+    _input_files->swap(inputs);
+
+    _analyzer->merge(results);
+
+    return true;
+}
+
+void ThreadController::saveCheckpoint(const InputFiles &merged)
+{
+    Lock lock(condition());
+
+    // Cancelled round is incomplete: checkpoint of the previous round
+    // is kept
+    //
+    if (!_checkpoint
+            || _is_cancelled)
         return;
 
-    for(shared_ptr<Event> event(new Event());
-            isContinue()
-                && reader->read(event);
-            event->Clear())
+    for(InputFiles inputs = merged; !inputs.empty(); inputs.pop())
     {
-        Lock lock(thread()->condition());
+        _checkpoint->addInput(inputs.front());
+    }
+
+    if (!_checkpoint->save(*_analyzer))
+        cerr << "failed to save checkpoint: " << _checkpoint->filename()
+            << endl;
+}
+
+bool ThreadController::nextRound(InputFiles &round)
+{
+    Lock lock(condition());
 
-        _analyzer->process(event.get());
+    // Inputs are processed in a single round unless checkpoint is written
+    // by worker processes or pipelined readers: analyzer threads publish
+    // snapshots instead
+    //
+    const uint32_t inputs = _checkpoint
+            && (_use_processes
+                || _reader_threads)
+        ? _checkpoint_inputs
+        : 0;
+
+    while(!_input_files->empty())
+    {
+        _input_files->pop();
+    }
 
-        ++_events_processed;
+    for(; !_pending_files->empty()
+            && (!inputs
+                || inputs > _input_files->size());
+            _pending_files->pop())
+    {
+        _input_files->push(_pending_files->front());
     }
+
+    round = *_input_files;
+
+    return !_input_files->empty();
 }
 
-void AnalyzerOperation::waitForInstructions()
+void ThreadController::processRound(InputFiles &merged)
 {
-    Lock lock(thread()->condition());
+    if (_use_processes)
+    {
+        processRoundInWorkers(merged);
 
-    // Inform the Controller that thread finished analyzing the  input file 
+        return;
+    }
+
+    // Results of all inputs are merged into the master unless the round
+    // is cancelled
     //
-    _controller->threadIsWaiting(thread());
-    _controller->condition()->variable()->notify_all();
+    {
+        Lock lock(condition());
+
+        merged = *_input_files;
+    }
 
-    // isContinue() and isFileEmpty() methods can not be used. Otherwise
-    // interlock will occure. Controller will try to accquire mutex and then
-    // notify this thread. Notification should come only after wait on
-    // lock (lines below) is issued
+    // Pipelined mode: inputs are split among readers and any analyzer
+    // may process events of any input
     //
-    while(_file_name.empty()
-            && _continue)
+    const uint32_t readers = countReaderThreads();
+    const uint32_t workers = readers ? _max_threads : countMaxThreads();
+    scheduleTasks(readers ? readers : workers);
+
     {
-        thread()->condition()->variable()->wait(lock());
+        Lock lock(condition());
+
+        if (readers)
+            _events.reset(new EventRing(BATCHES_PER_ANALYZER * workers,
+                        readers));
+
+        // Analyzer threads own their inputs in task mode: checkpoint is
+        // written from their snapshots while the round goes on
+        //
+        if (_checkpoint
+                && _checkpoint_inputs
+                && !readers)
+            _snapshots.assign(workers, Snapshot());
+
+        _snapshot_generation.store(0, boost::memory_order_release);
+        _snapshot_written = 0;
+        _inputs_unsaved = 0;
+        _is_snapshot_ready = false;
+
+        _summary->useThreads(workers, readers);
+    }
+
+    for(uint32_t reader = 0; readers > reader; ++reader)
+    {
+        addReaderThread(reader);
+    }
+
+    for(uint32_t worker = 0; workers > worker; ++worker)
+    {
+        addThread(worker);
+    }
+
+    startReadaheadThread();
+
+    run();
+
+    stopReadaheadThread();
+    stopReaderThreads();
+
+    // Cancelled job keeps results of the inputs processed completely:
+    // the latest snapshots are saved before partial results are merged
+    //
+    if (isCancelled())
+        writeSnapshot(true);
+
+    // Single merge into the master: the rest is done by the workers
+    //
+    if (_reduced_analyzer)
+    {
+        _analyzer->merge(_reduced_analyzer);
+        _reduced_analyzer.reset();
     }
+
+    Lock lock(condition());
+
+    _summary->addInputsStolen(_tasks->steals());
+
+    _tasks.reset();
+    _events.reset();
+    _snapshots.clear();
 }
 
+void ThreadController::writeSnapshot(const bool &force)
+{
+    Snapshots snapshots;
+    boost::shared_ptr<Checkpoint> checkpoint;
+    {
+        Lock lock(condition());
+
+        if (!_checkpoint
+                || !(_is_snapshot_ready || force))
+            return;
 
+        _is_snapshot_ready = false;
 
-// Thread Controller summary
-//
-class ThreadController::Summary
+        snapshots = _snapshots;
+        checkpoint.reset(new Checkpoint(*_checkpoint));
+    }
+
+    // Master holds results of the previous rounds and is not modified
+    // until the round is over
+    //
+    AnalyzerPtr results;
+    for(Snapshots::const_iterator snapshot = snapshots.begin();
+            snapshots.end() != snapshot;
+            ++snapshot)
+    {
+        if (!snapshot->results)
+            continue;
+
+        if (!results)
+            results = boost::dynamic_pointer_cast<Analyzer>(
+                    _analyzer->clone());
+
+        results->merge(snapshot->results);
+
+        for(std::vector<InputChunk>::const_iterator input =
+                    snapshot->inputs.begin();
+                snapshot->inputs.end() != input;
+                ++input)
+        {
+            checkpoint->addInput(*input);
+        }
+    }
+
+    if (!results)
+        return;
+
+    if (!checkpoint->save(*results))
+        cerr << "failed to save checkpoint: " << checkpoint->filename()
+            << endl;
+}
+
+bool ThreadController::startProcesses()
 {
-    public:
-        Summary():
-            _events_processed(0),
-            _files_processed(0),
-            _total_events_size(0)
+    uint32_t processes;
+    {
+        Lock lock(condition());
+
+        processes = _processes > _pending_files->size()
+            ? _pending_files->size()
+            : _processes;
+    }
+
+    if (!processes)
+        return true;
+
+    // Child inherits only the forking thread: idle analyzer threads of
+    // the previous jobs are stopped
+    //
+    stopPool();
+
+    // Anonymous shared memory is inherited by the children
+    //
+    void *memory = mmap(0, PROCESS_SLOT_SIZE * processes,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_ANONYMOUS | MAP_NORESERVE,
+            -1, 0);
+    if (MAP_FAILED == memory)
+    {
+        cerr << "failed to allocate shared memory for worker processes"
+            << endl;
+
+        return false;
+    }
+
+    _process_memory = memory;
+    _process_slots = processes;
+
+    // Buffered output would be written by each child otherwise
+    //
+    cout.flush();
+    cerr.flush();
+
+    for(uint32_t worker = 0; processes > worker; ++worker)
+    {
+        int commands[2];
+        int results[2];
+        if (pipe(commands))
         {
+            cerr << "failed to create pipe for worker process" << endl;
+
+            break;
         }
 
-        uint64_t eventsProcessed() const
+        if (pipe(results))
         {
-            return _events_processed;
+            close(commands[0]);
+            close(commands[1]);
+
+            cerr << "failed to create pipe for worker process" << endl;
+
+            break;
         }
 
-        uint32_t filesProcessed() const
+        pid_t pid = fork();
+        if (!pid)
         {
-            return _files_processed;
+            // Child: worker leaves once own command pipe is closed. Pipes
+            // of the other workers are not held open
+            //
+            close(commands[1]);
+            close(results[0]);
+
+            for(Processes::const_iterator child = _children.begin();
+                    _children.end() != child;
+                    ++child)
+            {
+                close(child->commands);
+                close(child->results);
+            }
+
+            // Leave without running destructors and exit handlers of the
+            // parent objects
+            //
+            const bool result = runWorker(commands[0], results[1],
+                    processSlot(memory, worker));
+
+            cout.flush();
+            cerr.flush();
+
+            _exit(result ? 0 : 1);
         }
 
-        uint32_t averageEventSize() const
+        close(commands[0]);
+        close(results[1]);
+
+        if (0 > pid)
         {
-            return eventsProcessed()
-                ? (_total_events_size / eventsProcessed())
-                : 0;
+            close(commands[1]);
+            close(results[0]);
+
+            cerr << "failed to fork worker process" << endl;
+
+            break;
+        }
+
+        WorkerProcess child;
+        child.pid = pid;
+        child.slot = worker;
+        child.commands = commands[1];
+        child.results = results[0];
+
+        Lock lock(condition());
+        _children.push_back(child);
+    }
+
+    Lock lock(condition());
+
+    _summary->useProcesses(_children.size());
+
+    return !_children.empty();
+}
+
+void ThreadController::stopProcesses()
+{
+    Processes children;
+    {
+        Lock lock(condition());
+
+        children.swap(_children);
+    }
+
+    // Workers leave once command pipe is closed
+    //
+    for(Processes::const_iterator child = children.begin();
+            children.end() != child;
+            ++child)
+    {
+        close(child->commands);
+        close(child->results);
+    }
+
+    for(Processes::const_iterator child = children.begin();
+            children.end() != child;
+            ++child)
+    {
+        waitForProcess(child->pid);
+    }
+
+    if (_process_memory)
+    {
+        munmap(_process_memory, PROCESS_SLOT_SIZE * _process_slots);
+
+        _process_memory = 0;
+        _process_slots = 0;
+    }
+}
+
+void ThreadController::processRoundInWorkers(InputFiles &merged)
+{
+    namespace io = boost::iostreams;
+
+    typedef std::vector<std::pair<InputFiles, uint32_t> > PendingShares;
+
+    // Each process gets own share of the inputs. Shares of the failed
+    // workers are sent again to the remaining ones
+    //
+    PendingShares pending;
+    {
+        uint32_t workers;
+        {
+            Lock lock(condition());
+
+            workers = _children.size();
+        }
+
+        const InputShares shares = balanceInputs(workers);
+        for(InputShares::const_iterator share = shares.begin();
+                shares.end() != share;
+                ++share)
+        {
+            if (!share->empty())
+                pending.push_back(std::make_pair(*share, 0));
+        }
+    }
+
+    while(!pending.empty()
+            && !isCancelled())
+    {
+        Processes children;
+        {
+            Lock lock(condition());
+
+            children = _children;
         }
 
-        void addEventsProcessed(const uint32_t &events)
+        if (children.empty())
+            break;
+
+        // One share per worker at a time
+        //
+        const uint32_t sent_shares = std::min(children.size(),
+                pending.size());
+
+        PendingShares shares(pending.begin(), pending.begin() + sent_shares);
+        pending.erase(pending.begin(), pending.begin() + sent_shares);
+
+        std::vector<bool> is_sent(shares.size(), false);
+        for(uint32_t share = 0; shares.size() > share; ++share)
         {
-            _events_processed += events;
+            ProcessSlot *slot = processSlot(_process_memory,
+                    children[share].slot);
+            *slot = ProcessSlot();
+
+            ++shares[share].second;
+            is_sent[share] = writeInputs(children[share].commands,
+                    shares[share].first);
         }
 
-        void addFilesProcessed()
+        // Slots of the killed or failed processes are incomplete
+        //
+        Processes failed;
+        for(uint32_t share = 0; shares.size() > share; ++share)
         {
-            ++_files_processed;
+            char is_done = 0;
+            if (!is_sent[share]
+                    || !readAll(children[share].results,
+                        &is_done, sizeof(is_done)))
+            {
+                // Worker is gone: it does not get inputs any more
+                //
+                failed.push_back(children[share]);
+
+                if (!isCancelled())
+                    cerr << "worker process " << children[share].pid
+                        << " failed" << endl;
+
+                if (SHARE_ATTEMPTS > shares[share].second)
+                    pending.push_back(shares[share]);
+                else
+                    failShare(shares[share].first);
+
+                continue;
+            }
+
+            ProcessSlot *slot = processSlot(_process_memory,
+                    children[share].slot);
+
+            AnalyzerPtr results =
+                boost::dynamic_pointer_cast<Analyzer>(_prototype->clone());
+
+            io::stream<io::array_source> in(processResults(slot),
+                    slot->results_size);
+            if (!is_done
+                    || !slot->is_done
+                    || !results->load(in))
+            {
+                if (!isCancelled())
+                    cerr << "failed to read results of worker process "
+                        << children[share].pid << endl;
+
+                if (SHARE_ATTEMPTS > shares[share].second)
+                    pending.push_back(shares[share]);
+                else
+                    failShare(shares[share].first);
+
+                continue;
+            }
+
+            _analyzer->merge(results);
+
+            for(InputFiles inputs = shares[share].first;
+                    !inputs.empty();
+                    inputs.pop())
+            {
+                merged.push(inputs.front());
+            }
+
+            Lock lock(condition());
+            _summary->addEventsProcessed(slot->events_processed);
+            _summary->addEventsSize(slot->events_size);
+            _summary->addFilesProcessed(slot->inputs_processed);
+            _summary->addInputsLoaded(slot->inputs_loaded,
+                    slot->bytes_loaded);
+            _summary->addEventRecycler(slot->event_resets,
+                    slot->peak_event_bytes);
+            _summary->addStaging(slot->staging_hits,
+                    slot->staging_copies,
+                    slot->staging_bypasses,
+                    slot->staging_bytes);
         }
 
-        void addEventsSize(const uint32_t &size)
+        for(Processes::const_iterator child = failed.begin();
+                failed.end() != child;
+                ++child)
         {
-            _total_events_size += size;
+            {
+                Lock lock(condition());
+
+                for(Processes::iterator running = _children.begin();
+                        _children.end() != running;
+                        ++running)
+                {
+                    if (running->pid != child->pid)
+                        continue;
+
+                    _children.erase(running);
+
+                    break;
+                }
+            }
+
+            close(child->commands);
+            close(child->results);
+
+            waitForProcess(child->pid);
         }
+    }
 
-    private:
-        uint64_t _events_processed;
-        uint32_t _files_processed;
-        uint64_t _total_events_size;
-};
+    // Inputs left are not merged: they are neither counted as processed
+    // nor written to the checkpoint
+    //
+    if (isCancelled())
+        return;
 
-// Thread controller
-//
-ThreadController::ThreadController():
-    _max_threads(boost::thread::hardware_concurrency())
+    for(PendingShares::const_iterator share = pending.begin();
+            pending.end() != share;
+            ++share)
+    {
+        failShare(share->first);
+    }
+}
+
+void ThreadController::failShare(const InputFiles &inputs)
 {
-    _condition.reset(new core::Condition());
-    _input_files.reset(new InputFiles());
+    for(InputFiles share = inputs; !share.empty(); share.pop())
+    {
+        cerr << "input is not processed: " << share.front().file_name
+            << endl;
+    }
 
-    _threads_waiting.reset(new ThreadsFIFO());
+    Lock lock(condition());
+
+    _summary->addInputsFailed(inputs.size());
 }
 
-ThreadController::~ThreadController()
+bool ThreadController::runWorker(const int &commands,
+        const int &results,
+        void *slot)
 {
-    // Check if any threads are still running and let them finish
-    // before quit application
+    for(InputFiles inputs; readInputs(commands, inputs); )
+    {
+        const char is_done = runProcess(inputs, slot);
+        if (!writeAll(results, &is_done, sizeof(is_done)))
+            return false;
+    }
+
+    return true;
 }
 
-bsm::core::ConditionPtr ThreadController::condition() const
+bool ThreadController::runProcess(const InputFiles &inputs, void *memory)
 {
-    return _condition;
+    namespace io = boost::iostreams;
+
+    ProcessSlot *slot = static_cast<ProcessSlot *>(memory);
+
+    // Only the forking thread exists in the child: parent threads and
+    // locks are not touched. Inputs are processed by the new controller
+    //
+    ThreadController controller;
+    controller._max_threads = 1;
+    controller._readahead_inputs = _readahead_inputs;
+    controller._readahead_bytes = _readahead_bytes;
+    controller._use_mapped_reader = _use_mapped_reader;
+    controller._use_uring_reader = _use_uring_reader;
+    controller._event_reset = _event_reset;
+    if (_staging)
+        controller._staging.reset(new StagingCache(_staging_directory,
+                    _staging_bytes));
+    controller._summary.reset(new Summary());
+    controller._prototype = _prototype;
+    controller._analyzer =
+        boost::dynamic_pointer_cast<Analyzer>(_prototype->clone());
+    *controller._input_files = inputs;
+
+    InputFiles merged;
+    controller.processRound(merged);
+
+    io::stream<io::array_sink> out(processResults(slot),
+            processResultsCapacity());
+    if (!controller._analyzer->save(out)
+            || !out.flush())
+    {
+        cerr << "analyzer results do not fit shared memory" << endl;
+
+        return false;
+    }
+
+    slot->events_processed = controller._summary->eventsProcessed();
+    slot->events_size = controller._summary->totalEventsSize();
+    slot->inputs_processed = controller._summary->filesProcessed();
+    slot->inputs_loaded = controller._summary->inputsLoaded();
+    slot->bytes_loaded = controller._summary->bytesLoaded();
+    slot->event_resets = controller._summary->eventResets();
+    slot->peak_event_bytes = controller._summary->peakEventBytes();
+    if (controller._staging)
+    {
+        slot->staging_hits = controller._staging->hits();
+        slot->staging_copies = controller._staging->copies();
+        slot->staging_bypasses = controller._staging->bypasses();
+        slot->staging_bytes = controller._staging->bytesCopied();
+    }
+    slot->results_size = out.tellp();
+    slot->is_done = 1;
+
+    return true;
 }
 
-void ThreadController::use(const AnalyzerPtr &analyzer)
+uint32_t ThreadController::countMaxThreads()
 {
-    _analyzer = analyzer;
+    Lock lock(condition());
+
+    if (_max_threads > _input_files->size())
+        return _input_files->size();
+
+    return _max_threads;
 }
 
-void ThreadController::push(const std::string &file_name)
+uint32_t ThreadController::countReaderThreads()
 {
     Lock lock(condition());
 
-    _input_files->push(file_name);
+    if (_reader_threads > _input_files->size())
+        return _input_files->size();
+
+    // Streams are read by the reader thread: events are passed to the
+    // analyzers through the ring
+    //
+    if (!_reader_threads)
+    {
+        for(InputFiles inputs = *_input_files; !inputs.empty(); inputs.pop())
+        {
+            if (StreamReader::isStream(inputs.front().file_name))
+                return 1;
+        }
+    }
+
+    return _reader_threads;
 }
 
-void ThreadController::start()
+void ThreadController::splitInputs()
 {
-    if (!hasInputFiles()
-            || !hasAnalyzer())
-        return;
+    uint32_t events_per_chunk;
+    uint32_t max_threads;
+    std::vector<InputChunk> inputs;
+    {
+        Lock lock(condition());
+
+        if (!_events_per_chunk)
+            return;
 
-    _summary.reset(new Summary());
+        events_per_chunk = _events_per_chunk;
+        max_threads = _max_threads;
 
-    startKeyboardThread();
+        for(; !_input_files->empty(); _input_files->pop())
+        {
+            inputs.push_back(_input_files->front());
+        }
+    }
 
-    for(uint32_t threads_to_create = countMaxThreads();
-            threads_to_create;
-            --threads_to_create)
+    // Inputs are scanned in parallel and without controller lock: stats
+    // and keyboard are not blocked by the pre-scan
+    //
+    RecordIndices indices(inputs.size());
+    boost::atomic<uint32_t> next(0);
+
+    boost::thread_group scanners;
+    for(uint32_t scanner = 0;
+            max_threads > scanner
+                && inputs.size() > scanner;
+            ++scanner)
     {
-        addThread();
+        scanners.create_thread(boost::bind(indexInputs,
+                    boost::cref(inputs),
+                    boost::ref(indices),
+                    boost::ref(next)));
     }
+    scanners.join_all();
 
-    run();
+    InputFiles chunks;
+    for(uint32_t input = 0; inputs.size() > input; ++input)
+    {
+        // Fall back to the whole file if records can not be found: Reader
+        // will report the problem when file is processed
+        //
+        const RecordIndexPtr &index = indices[input];
+        if (!index)
+        {
+            chunks.push(inputs[input]);
 
-    stopKeyboardThread();
+            continue;
+        }
 
-    cout << "Job Summary" << endl;
-    cout << "  Processed Events: " << _summary->eventsProcessed() << endl;
-    cout << "  Processed  Files: " << _summary->filesProcessed() << endl;
-    cout << "Average Event Size: " << _summary->averageEventSize() << endl;
-    cout << endl;
+        for(uint32_t record = 0;
+                index->size() > record;
+                record += events_per_chunk)
+        {
+            chunks.push(InputChunk(inputs[input].file_name,
+                        index->offset(record),
+                        index->offset(record + events_per_chunk)));
+        }
+    }
 
-    _summary.reset();
-}
+    Lock lock(condition());
 
-void 
-ThreadController::threadIsWaiting(Thread *thread)
-{
-    _threads_waiting->push(thread);
+    *_input_files = chunks;
 }
 
-void ThreadController::quit()
+void ThreadController::sortInputs()
 {
     Lock lock(condition());
 
-    _keyboard_thread->stop();
+    std::vector<InputChunk> inputs;
+    inputs.reserve(_input_files->size());
 
-    while(!_input_files->empty())
+    // Inputs without history are measured in processing time of the
+    // average byte. Number of events is the cost if there is no history
+    // at all: inputs missing in the manifest are counted in events of the
+    // average size. Size is used without manifest
+    //
+    const double rate = _history ? _history->rate() : 0;
+    const double event_size = _manifest && _manifest->events()
+        ? 1. * _manifest->bytes() / _manifest->events()
+        : 0;
+
+    double events_expected = 0;
+    for(; !_input_files->empty(); _input_files->pop())
     {
-        _input_files->pop();
+        InputChunk input = _input_files->front();
+
+        const uint64_t bytes = inputSize(input);
+
+        double events = 0;
+        if (_manifest)
+        {
+            DatasetManifest::Entry entry;
+            if (_manifest->find(input.file_name, entry))
+            {
+                // Chunk carries its share of the file events
+                //
+                events = input.isWholeFile()
+                    ? entry.events
+                    : (entry.size
+                        ? 1. * entry.events * bytes / entry.size
+                        : 0);
+            }
+            else if (event_size)
+                events = bytes / event_size;
+        }
+
+        events_expected += events;
+
+        if (!_history
+                || !_history->runtime(input, bytes, input.cost))
+        {
+            if (rate)
+                input.cost = rate * bytes;
+            else if (event_size)
+                input.cost = events;
+            else
+                input.cost = bytes;
+        }
+
+        inputs.push_back(input);
     }
 
-    for(Threads::iterator thread = _threads.begin();
-            _threads.end() != thread;
-            ++thread)
+    _events_expected = static_cast<uint64_t>(events_expected + .5);
+
+    std::stable_sort(inputs.begin(), inputs.end(), isMoreExpensive);
+
+    for(std::vector<InputChunk>::const_iterator input = inputs.begin();
+            inputs.end() != input;
+            ++input)
     {
-        thread->first->stop();
+        _input_files->push(*input);
     }
 }
 
-void ThreadController::info()
+ThreadController::InputShares
+    ThreadController::balanceInputs(const uint32_t &workers)
 {
     Lock lock(condition());
 
-    cout << "INFO" << endl;
-    cout << "Inputs p: " << _summary->filesProcessed() << " l: "
-        << _input_files->size() << endl;
-    cout << endl;
-}
+    InputShares shares(workers ? workers : 1);
+    std::vector<double> loads(shares.size(), 0);
 
-// Private
-//
-bool ThreadController::hasInputFiles() const
-{
-    Lock lock(condition());
+    // Inputs are sorted: the most expensive ones are placed first and the
+    // cheap ones fill the gaps
+    //
+    for(; !_input_files->empty(); _input_files->pop())
+    {
+        const uint32_t share =
+            std::min_element(loads.begin(), loads.end()) - loads.begin();
 
-    return !_input_files->empty();
+        shares[share].push(_input_files->front());
+        loads[share] += _input_files->front().cost;
+    }
+
+    return shares;
 }
 
-bool ThreadController::hasAnalyzer() const
+void ThreadController::scheduleTasks(const uint32_t &workers)
 {
+    InputShares shares = balanceInputs(workers);
+
     Lock lock(condition());
 
-    return _analyzer;
+    _tasks.reset(new InputTasks(shares.size()));
+
+    // Worker takes own tasks from the back of the deque: the most
+    // expensive ones first. Thieves take the cheap ones from the front
+    //
+    for(uint32_t worker = 0; shares.size() > worker; ++worker)
+    {
+        std::vector<InputChunk> tasks;
+        for(; !shares[worker].empty(); shares[worker].pop())
+        {
+            tasks.push_back(shares[worker].front());
+        }
+
+        for(std::vector<InputChunk>::const_reverse_iterator task =
+                    tasks.rbegin();
+                tasks.rend() != task;
+                ++task)
+        {
+            _tasks->push(worker, *task);
+        }
+    }
 }
 
-uint32_t ThreadController::countMaxThreads()
+void ThreadController::addThread(const uint32_t &worker)
 {
-    Lock lock(condition());
+    // Pool only grows: extra threads stay idle
+    //
+    for(; worker >= _pool.size(); )
+    {
+        ThreadPtr thread(new Thread());
+        AnalyzerOperationPtr operation(new AnalyzerOperation());
+        thread->init(operation);
 
-    if (_max_threads > _input_files->size())
-        return _input_files->size();
+        operation->use(this);
 
-    return _max_threads;
+        thread->start();
+
+        _pool.push_back(thread);
+    }
+
+    ThreadPtr thread = _pool[worker];
+    AnalyzerOperationPtr operation =
+        boost::dynamic_pointer_cast<AnalyzerOperation>(thread->operation());
+
+    {
+        Lock lock(condition());
+        if (_events)
+            operation->use(_events);
+        else
+            operation->use(_tasks, worker);
+
+        operation->use(_analyzer, _prototype);
+        operation->useMappedReader(_use_mapped_reader);
+        operation->useUringReader(_use_uring_reader);
+        operation->setEventReset(_event_reset);
+        operation->use(_staging);
+        operation->pin(_cpus.empty()
+                ? _allowed_cpus
+                : CPUs(1, _cpus[worker % _cpus.size()]));
+
+        _threads[thread.get()] = thread;
+    }
+
+    operation->startJob();
 }
 
-void ThreadController::addThread()
+void ThreadController::addReaderThread(const uint32_t &worker)
 {
     ThreadPtr thread(new Thread());
-    AnalyzerOperationPtr operation(new AnalyzerOperation());
+    ReaderOperationPtr operation(new ReaderOperation());
     thread->init(operation);
 
-    operation->use(this);
-
-    instruct(operation.get());
-
     {
         Lock lock(condition());
-        operation->use(boost::dynamic_pointer_cast<Analyzer>(_analyzer->clone()));
-        _threads[thread.get()] = thread;
+        operation->use(_tasks, worker);
+        operation->use(_events);
+        operation->use(_prototype->fields());
+        operation->use(_staging);
+        operation->useMappedReader(_use_mapped_reader);
+        operation->useUringReader(_use_uring_reader);
+        _readers[thread.get()] = thread;
     }
 
     thread->start();
 }
 
-void ThreadController::instruct(AnalyzerOperation *operation)
+void ThreadController::stopReaderThreads()
 {
-    Lock lock(condition());
+    // Analyzers are done: readers have either finished or are cancelled
+    //
+    Threads readers;
+    {
+        Lock lock(condition());
+
+        readers.swap(_readers);
 
-    const std::string input_file(_input_files->front());
-    _input_files->pop();
+        if (_events)
+            _events->close();
+    }
+
+    for(Threads::iterator thread = readers.begin();
+            readers.end() != thread;
+            ++thread)
+    {
+        thread->first->stop();
+        thread->first->join();
+
+        ReaderOperationPtr operation =
+            boost::dynamic_pointer_cast<ReaderOperation>(
+                    thread->first->operation());
 
-    operation->init(input_file);
+        if (!operation)
+            continue;
+
+        Lock lock(condition());
+        _summary->addEventsSize(operation->bytesRead());
+        _summary->addFilesProcessed(operation->inputsProcessed());
+    }
 }
 
 void ThreadController::run()
 {
     for(; isRunning();)
     {
-        // Wait for any thread to finish
+        // Wait for any thread to finish or checkpoint snapshot
         //
         wait();
 
+        writeSnapshot();
+
         // Process waiting threads
         //
         onThreadWait();
@@ -532,7 +3665,8 @@ void ThreadController::wait()
 {
     Lock lock(condition());
 
-    while(_threads_waiting->empty())
+    while(_threads_waiting->empty()
+            && !_is_snapshot_ready)
     {
         condition()->variable()->wait(lock());
     }
@@ -549,56 +3683,42 @@ void ThreadController::onThreadWait()
 {
     using boost::dynamic_pointer_cast;
 
-    _summary->addFilesProcessed();
-
-    if (hasInputFiles())
-    {
-        // More input files left
-        //
-        Thread *thread = waitingThread();
-        AnalyzerOperationPtr operation = 
-            dynamic_pointer_cast<AnalyzerOperation>(thread->operation());
-        
-        if (operation)
-            instruct(operation.get());
-
-        thread->condition()->variable()->notify_all();
-    }
-    else
-    {
-        // Stop thread
-        //
-        Thread *thread = waitingThread();
-
-        thread->stop();
-        thread->condition()->variable()->notify_all();
-
-        // Let thread finish
-        //
-        thread->join();
-
-        AnalyzerOperationPtr operation =
-            dynamic_pointer_cast<AnalyzerOperation>(thread->operation());
+    // Thread ran out of tasks: there is nothing left to steal. Thread is
+    // idle and stays in the pool
+    //
+    Thread *thread = waitingThread();
+    if (!thread)
+        return;
 
-        if (operation)
-        {
-            _analyzer->merge(operation->analyzer());
+    AnalyzerOperationPtr operation =
+        dynamic_pointer_cast<AnalyzerOperation>(thread->operation());
 
-            Lock lock(condition());
-            _summary->addEventsProcessed(operation->eventsProcessed());
-            _summary->addEventsSize(operation->totalEventsSize());
-        }
+    // Analyzer was already reduced by the worker. Counters are moved to
+    // the summary and thread is removed from the list of running threads
+    // at once: stats never count thread twice
+    //
+    Lock lock(condition());
 
-        // Remove thread form the list of running threads
-        //
-        Lock lock(condition());
-        _threads.erase(thread);
+    if (operation)
+    {
+        _summary->addEventsProcessed(operation->eventsProcessed());
+        _summary->addEventsSize(operation->totalEventsSize());
+        _summary->addFilesProcessed(operation->inputsProcessed());
+        _summary->addClonesReused(operation->isCloneReused());
+        _summary->addEventRecycler(operation->eventResets(),
+                operation->peakEventBytes());
     }
+
+    _threads.erase(thread);
 }
 
 Thread *ThreadController::waitingThread()
 {
     Lock lock(condition());
+
+    if (_threads_waiting->empty())
+        return 0;
+
     Thread *thread = _threads_waiting->front();
     _threads_waiting->pop();
     
@@ -607,6 +3727,11 @@ Thread *ThreadController::waitingThread()
 
 void ThreadController::startKeyboardThread()
 {
+    // Batch jobs have no terminal to watch
+    //
+    if (!isatty(STDIN_FILENO))
+        return;
+
     Lock lock(condition());
 
     _keyboard_thread.reset(new Thread());
@@ -619,6 +3744,78 @@ void ThreadController::startKeyboardThread()
 
 void ThreadController::stopKeyboardThread()
 {
+    if (!_keyboard_thread)
+        return;
+
     _keyboard_thread->stop();
     _keyboard_thread->join();
+
+    Lock lock(condition());
+
+    _keyboard_thread.reset();
+}
+
+void ThreadController::startStatsThread()
+{
+    Lock lock(condition());
+
+    if (_stats_file.empty())
+        return;
+
+    _stats_thread.reset(new Thread());
+    StatsOperationPtr operation(new StatsOperation());
+    _stats_thread->init(operation);
+
+    operation->init(this, _stats_file, _stats_interval);
+    _stats_thread->start();
+}
+
+void ThreadController::startReadaheadThread()
+{
+    Lock lock(condition());
+
+    if (!_readahead_inputs
+            || !_readahead_bytes)
+        return;
+
+    _readahead_thread.reset(new Thread());
+    ReadaheadOperationPtr operation(new ReadaheadOperation());
+    _readahead_thread->init(operation);
+
+    operation->use(_tasks, _readahead_inputs, _readahead_bytes);
+    _readahead_thread->start();
+}
+
+void ThreadController::stopReadaheadThread()
+{
+    if (!_readahead_thread)
+        return;
+
+    _readahead_thread->stop();
+    _readahead_thread->join();
+
+    ReadaheadOperationPtr operation =
+        boost::dynamic_pointer_cast<ReadaheadOperation>(
+                _readahead_thread->operation());
+
+    Lock lock(condition());
+
+    if (operation)
+        _summary->addInputsLoaded(operation->inputsLoaded(),
+                operation->bytesLoaded());
+
+    _readahead_thread.reset();
+}
+
+void ThreadController::stopStatsThread()
+{
+    if (!_stats_thread)
+        return;
+
+    _stats_thread->stop();
+    _stats_thread->join();
+
+    Lock lock(condition());
+
+    _stats_thread.reset();
 }
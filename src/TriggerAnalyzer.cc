@@ -16,13 +16,18 @@
 #include "bsm_input/interface/Input.pb.h"
 #include "bsm_input/interface/Trigger.pb.h"
 #include "interface/TriggerAnalyzer.h"
+#include "interface/Utility.h"
 
 using namespace std;
 
 using boost::dynamic_pointer_cast;
 
+using bsm::EventFields;
 using bsm::TriggerAnalyzer;
 
+using bsm::utility::read;
+using bsm::utility::write;
+
 TriggerAnalyzer::TriggerAnalyzer()
 {
 }
@@ -67,6 +72,82 @@ void TriggerAnalyzer::process(const Event *event)
     }
 }
 
+bool TriggerAnalyzer::reset()
+{
+    _hlt_map.clear();
+    _hlt_cutflow.clear();
+
+    return true;
+}
+
+bool TriggerAnalyzer::save(std::ostream &out) const
+{
+    write(out, static_cast<uint32_t>(_hlt_map.size()));
+    for(HLTMap::const_iterator hlt = _hlt_map.begin();
+            _hlt_map.end() != hlt;
+            ++hlt)
+    {
+        write(out, static_cast<uint64_t>(hlt->first));
+        write(out, hlt->second);
+    }
+
+    write(out, static_cast<uint32_t>(_hlt_cutflow.size()));
+    for(HLTCutflow::const_iterator hlt = _hlt_cutflow.begin();
+            _hlt_cutflow.end() != hlt;
+            ++hlt)
+    {
+        write(out, hlt->first.SerializeAsString());
+        write(out, hlt->second);
+    }
+
+    return !out.fail();
+}
+
+bool TriggerAnalyzer::load(std::istream &in)
+{
+    reset();
+
+    uint32_t names = 0;
+    if (!read(in, names))
+        return false;
+
+    for(uint64_t hash; names; --names)
+    {
+        string name;
+        if (!read(in, hash)
+                || !read(in, name))
+            return false;
+
+        _hlt_map[hash] = name;
+    }
+
+    uint32_t triggers = 0;
+    if (!read(in, triggers))
+        return false;
+
+    for(uint32_t events; triggers; --triggers)
+    {
+        string message;
+        Trigger trigger;
+        if (!read(in, message)
+                || !trigger.ParseFromString(message)
+                || !read(in, events))
+            return false;
+
+        _hlt_cutflow[trigger] = events;
+    }
+
+    return true;
+}
+
+EventFields TriggerAnalyzer::fields() const
+{
+    EventFields fields = EventFields::none();
+    fields.add(Event::kHltsFieldNumber);
+
+    return fields;
+}
+
 uint32_t TriggerAnalyzer::id() const
 {
     return core::ID<TriggerAnalyzer>::get();
@@ -0,0 +1,502 @@
+// Uring Input Stream
+//
+// Read part of the file with asynchronous io_uring reads
+//
+// Copyright 2011, All rights reserved
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Ring is set up with raw system calls: kernel headers are the only
+// requirement. IORING_OP_READ and the opcode probe are enum values: they
+// come with the 5.6 headers, the first to define IORING_FEAT_RW_CUR_POS
+//
+#if defined(__linux__) \
+    && defined(__NR_io_uring_setup) \
+    && defined(__NR_io_uring_enter) \
+    && defined(__NR_io_uring_register)
+#include <linux/io_uring.h>
+#if defined(IORING_FEAT_SINGLE_MMAP) && defined(IORING_FEAT_RW_CUR_POS)
+#define BSM_USE_URING
+#endif
+#endif
+
+#include "interface/UringInputStream.h"
+
+using bsm::UringInputStream;
+
+// Buffers are aligned to the page: reads do not straddle pages and the
+// file could be opened with O_DIRECT
+//
+static const uint32_t BUFFER_ALIGNMENT = 4096;
+
+enum BufferState
+{
+    BUFFER_IDLE = 0,
+    BUFFER_BUSY,
+    BUFFER_READY
+};
+
+UringInputStream::Buffer::Buffer():
+    data(0),
+    capacity(0),
+    offset(0),
+    requested(0),
+    result(0),
+    state(BUFFER_IDLE)
+{
+}
+
+UringInputStream::UringInputStream(const int &fd,
+        const uint64_t &offset,
+        const uint64_t &limit,
+        const uint32_t &buffers,
+        const uint32_t &buffer_size):
+    _fd(fd),
+    _offset(offset),
+    _limit(limit),
+    _next(0),
+    _in_flight(0),
+    _is_current(false),
+    _backed_up(0),
+    _byte_count(0),
+    _had_error(false),
+    _ring_fd(-1),
+    _sq_ring(MAP_FAILED),
+    _cq_ring(MAP_FAILED),
+    _sqes(MAP_FAILED),
+    _sq_ring_size(0),
+    _cq_ring_size(0),
+    _sqes_size(0),
+    _sq_tail(0),
+    _sq_mask(0),
+    _sq_array(0),
+    _cq_head(0),
+    _cq_tail(0),
+    _cq_mask(0),
+    _cqes(0)
+{
+    if (!_limit)
+    {
+        struct stat file_stat;
+        if (fstat(_fd, &file_stat))
+        {
+            _had_error = true;
+
+            return;
+        }
+
+        _limit = file_stat.st_size;
+    }
+
+    if (!buffers
+            || !buffer_size
+            || !setup(buffers))
+    {
+        _had_error = true;
+
+        return;
+    }
+
+    _buffers.resize(buffers);
+    for(Buffers::iterator buffer = _buffers.begin();
+            _buffers.end() != buffer;
+            ++buffer)
+    {
+        void *data = 0;
+        if (posix_memalign(&data, BUFFER_ALIGNMENT, buffer_size))
+        {
+            _had_error = true;
+
+            return;
+        }
+
+        buffer->data = static_cast<char *>(data);
+        buffer->capacity = buffer_size;
+    }
+
+    // Buffers are filled in order: file is read sequentially
+    //
+    for(Buffers::iterator buffer = _buffers.begin();
+            _buffers.end() != buffer
+                && !_had_error;
+            ++buffer)
+    {
+        if (!submit(*buffer))
+            _had_error = true;
+    }
+}
+
+UringInputStream::~UringInputStream()
+{
+    // Kernel writes into the buffers until reads are complete
+    //
+    while(_in_flight)
+    {
+        if (!complete())
+        {
+            // Buffers may still be written: leak them
+            //
+            _buffers.clear();
+
+            break;
+        }
+    }
+
+    release();
+}
+
+bool UringInputStream::isSupported()
+{
+#if defined(BSM_USE_URING)
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    const int ring_fd = syscall(__NR_io_uring_setup, 1, &params);
+    if (0 > ring_fd)
+        return false;
+
+    // Ring is available since 5.1 but reads are only supported since 5.6:
+    // kernel is asked for the opcode. Older kernels fail the probe
+    //
+    const size_t probe_size = sizeof(struct io_uring_probe)
+        + (IORING_OP_READ + 1) * sizeof(struct io_uring_probe_op);
+
+    struct io_uring_probe *probe =
+        static_cast<struct io_uring_probe *>(calloc(1, probe_size));
+
+    const bool result = probe
+        && !syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_PROBE,
+                probe, IORING_OP_READ + 1)
+        && IORING_OP_READ <= probe->last_op
+        && (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED);
+
+    free(probe);
+    close(ring_fd);
+
+    return result;
+#else
+    return false;
+#endif
+}
+
+bool UringInputStream::hadError() const
+{
+    return _had_error;
+}
+
+bool UringInputStream::Next(const void **data, int *size)
+{
+    if (_had_error)
+        return false;
+
+    const uint32_t buffers = _buffers.size();
+
+    if (_is_current)
+    {
+        Buffer &current = _buffers[(_next + buffers - 1) % buffers];
+
+        if (_backed_up)
+        {
+            *data = current.data + current.result - _backed_up;
+            *size = _backed_up;
+
+            _byte_count += _backed_up;
+            _backed_up = 0;
+
+            return true;
+        }
+
+        // Caller is done with the buffer: read the next part of the file
+        //
+        _is_current = false;
+        if (!submit(current))
+        {
+            _had_error = true;
+
+            return false;
+        }
+    }
+
+    Buffer &buffer = _buffers[_next];
+    while(BUFFER_BUSY == buffer.state)
+    {
+        if (!complete())
+        {
+            _had_error = true;
+
+            return false;
+        }
+    }
+
+    // Nothing left to read
+    //
+    if (BUFFER_IDLE == buffer.state)
+        return false;
+
+    buffer.state = BUFFER_IDLE;
+
+    if (!finish(buffer))
+    {
+        _had_error = true;
+
+        return false;
+    }
+
+    if (!buffer.result)
+        return false;
+
+    *data = buffer.data;
+    *size = buffer.result;
+
+    _byte_count += buffer.result;
+    _next = (_next + 1) % buffers;
+    _is_current = true;
+
+    return true;
+}
+
+void UringInputStream::BackUp(int count)
+{
+    _backed_up = count;
+    _byte_count -= count;
+}
+
+bool UringInputStream::Skip(int count)
+{
+    const void *data;
+    int size;
+    while(0 < count)
+    {
+        if (!Next(&data, &size))
+            return false;
+
+        if (size > count)
+        {
+            BackUp(size - count);
+
+            return true;
+        }
+
+        count -= size;
+    }
+
+    return true;
+}
+
+google::protobuf::int64 UringInputStream::ByteCount() const
+{
+    return _byte_count;
+}
+
+// Private
+//
+bool UringInputStream::setup(const uint32_t &entries)
+{
+#if defined(BSM_USE_URING)
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    _ring_fd = syscall(__NR_io_uring_setup, entries, &params);
+    if (0 > _ring_fd)
+        return false;
+
+    _sq_ring_size = params.sq_off.array
+        + params.sq_entries * sizeof(unsigned);
+    _cq_ring_size = params.cq_off.cqes
+        + params.cq_entries * sizeof(struct io_uring_cqe);
+
+    // Both rings share the mapping in the newer kernels
+    //
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        if (_cq_ring_size > _sq_ring_size)
+            _sq_ring_size = _cq_ring_size;
+
+        _cq_ring_size = 0;
+    }
+
+    _sq_ring = mmap(0, _sq_ring_size, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_SQ_RING);
+    if (MAP_FAILED == _sq_ring)
+        return false;
+
+    if (_cq_ring_size)
+    {
+        _cq_ring = mmap(0, _cq_ring_size, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_CQ_RING);
+        if (MAP_FAILED == _cq_ring)
+            return false;
+    }
+
+    _sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    _sqes = mmap(0, _sqes_size, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_SQES);
+    if (MAP_FAILED == _sqes)
+        return false;
+
+    char *sq = static_cast<char *>(_sq_ring);
+    char *cq = static_cast<char *>(_cq_ring_size ? _cq_ring : _sq_ring);
+
+    _sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    _sq_mask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    _sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+
+    _cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    _cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    _cq_mask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    _cqes = cq + params.cq_off.cqes;
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+void UringInputStream::release()
+{
+    for(Buffers::iterator buffer = _buffers.begin();
+            _buffers.end() != buffer;
+            ++buffer)
+    {
+        free(buffer->data);
+    }
+
+    _buffers.clear();
+
+    if (MAP_FAILED != _sqes)
+        munmap(_sqes, _sqes_size);
+
+    if (MAP_FAILED != _cq_ring)
+        munmap(_cq_ring, _cq_ring_size);
+
+    if (MAP_FAILED != _sq_ring)
+        munmap(_sq_ring, _sq_ring_size);
+
+    if (0 <= _ring_fd)
+        close(_ring_fd);
+}
+
+bool UringInputStream::submit(Buffer &buffer)
+{
+#if defined(BSM_USE_URING)
+    if (_offset >= _limit)
+    {
+        buffer.state = BUFFER_IDLE;
+
+        return true;
+    }
+
+    buffer.offset = _offset;
+    buffer.requested = _limit - _offset < buffer.capacity
+        ? _limit - _offset
+        : buffer.capacity;
+    buffer.result = 0;
+
+    const unsigned tail = *_sq_tail;
+    const unsigned index = tail & *_sq_mask;
+
+    struct io_uring_sqe *sqe =
+        static_cast<struct io_uring_sqe *>(_sqes) + index;
+    memset(sqe, 0, sizeof(*sqe));
+
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = _fd;
+    sqe->off = buffer.offset;
+    sqe->addr = reinterpret_cast<uint64_t>(buffer.data);
+    sqe->len = buffer.requested;
+    sqe->user_data = &buffer - &_buffers[0];
+
+    _sq_array[index] = index;
+    __atomic_store_n(_sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+    int result;
+    while(0 > (result = syscall(__NR_io_uring_enter, _ring_fd, 1, 0, 0, 0, 0))
+            && EINTR == errno)
+    {
+    }
+
+    if (1 != result)
+        return false;
+
+    _offset += buffer.requested;
+    buffer.state = BUFFER_BUSY;
+    ++_in_flight;
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool UringInputStream::complete()
+{
+#if defined(BSM_USE_URING)
+    unsigned head = *_cq_head;
+    while(head == __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE))
+    {
+        if (0 > syscall(__NR_io_uring_enter, _ring_fd, 0, 1,
+                    IORING_ENTER_GETEVENTS, 0, 0)
+                && EINTR != errno)
+            return false;
+    }
+
+    for(; head != __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE); ++head)
+    {
+        const struct io_uring_cqe *cqe =
+            static_cast<const struct io_uring_cqe *>(_cqes)
+                + (head & *_cq_mask);
+
+        Buffer &buffer = _buffers[cqe->user_data];
+        buffer.result = cqe->res;
+        buffer.state = BUFFER_READY;
+
+        --_in_flight;
+    }
+
+    __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool UringInputStream::finish(Buffer &buffer)
+{
+    // Failed read is repeated synchronously: pread reports the error if
+    // it is not specific to io_uring
+    //
+    if (0 > buffer.result)
+        buffer.result = 0;
+
+    while(buffer.requested > static_cast<uint32_t>(buffer.result))
+    {
+        const ssize_t bytes = pread(_fd,
+                buffer.data + buffer.result,
+                buffer.requested - buffer.result,
+                buffer.offset + buffer.result);
+
+        if (0 > bytes)
+        {
+            if (EINTR == errno)
+                continue;
+
+            return false;
+        }
+
+        // File was truncated
+        //
+        if (!bytes)
+            break;
+
+        buffer.result += bytes;
+    }
+
+    return true;
+}
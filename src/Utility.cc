@@ -30,3 +30,23 @@ void bsm::utility::set(TLorentzVector *root_p4, const LorentzVector *bsm_p4)
 {
     root_p4->SetPxPyPzE(bsm_p4->px(), bsm_p4->py(), bsm_p4->pz(), bsm_p4->e());
 }
+
+void bsm::utility::write(std::ostream &out, const std::string &value)
+{
+    const uint32_t size = value.size();
+
+    write(out, size);
+    out.write(value.data(), size);
+}
+
+bool bsm::utility::read(std::istream &in, std::string &value)
+{
+    uint32_t size = 0;
+    if (!read(in, size))
+        return false;
+
+    value.resize(size);
+
+    return !size
+        || !in.read(&value[0], size).fail();
+}
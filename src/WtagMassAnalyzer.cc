@@ -138,6 +138,32 @@ void WtagMassAnalyzer::process(const Event *event)
     electrons(event);
 }
 
+bool WtagMassAnalyzer::save(std::ostream &out) const
+{
+    return _el_selector->save(out)
+        && _el_multiplicity->save(out)
+        && _mu_selector->save(out)
+        && _mu_multiplicity->save(out)
+        && _leptonic_multiplicity->save(out)
+        && _hadronic_multiplicity->save(out)
+        && _wjet_selector->save(out)
+        && _met_solutions->save(out)
+        && _mttbar->save(out);
+}
+
+bool WtagMassAnalyzer::load(std::istream &in)
+{
+    return _el_selector->load(in)
+        && _el_multiplicity->load(in)
+        && _mu_selector->load(in)
+        && _mu_multiplicity->load(in)
+        && _leptonic_multiplicity->load(in)
+        && _hadronic_multiplicity->load(in)
+        && _wjet_selector->load(in)
+        && _met_solutions->load(in)
+        && _mttbar->load(in);
+}
+
 uint32_t WtagMassAnalyzer::id() const
 {
     return core::ID<WtagMassAnalyzer>::get();
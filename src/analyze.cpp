@@ -0,0 +1,242 @@
+// Run several analyses at once
+//
+// Read inputs once and pass events to all requested analyzers. Each
+// analysis produces the same output as its own program: canvases are
+// drawn and files are saved once all inputs are processed
+//
+// Copyright 2011, All rights reserved
+
+#include <iostream>
+
+#include <boost/pointer_cast.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/program_options.hpp>
+
+#include <TRint.h>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "interface/AnalyzerOutput.h"
+#include "interface/CompositeAnalyzer.h"
+#include "interface/ControllerOptions.h"
+#include "interface/CutflowAnalyzer.h"
+#include "interface/MonitorAnalyzer.h"
+#include "interface/MttbarAnalyzer.h"
+#include "interface/Thread.h"
+#include "interface/TriggerAnalyzer.h"
+#include "interface/WtagMassAnalyzer.h"
+
+using namespace std;
+
+using boost::dynamic_pointer_cast;
+using boost::shared_ptr;
+
+namespace po = boost::program_options;
+
+using bsm::AnalyzerOutput;
+using bsm::AnalyzerPtr;
+using bsm::CompositeAnalyzer;
+using bsm::ControllerOptions;
+using bsm::ThreadController;
+
+typedef shared_ptr<CompositeAnalyzer> CompositeAnalyzerPtr;
+typedef shared_ptr<ThreadController> ControllerPtr;
+typedef CompositeAnalyzer::Analyzers Analyzers;
+
+AnalyzerPtr createAnalyzer(const string &name);
+
+void run(const po::variables_map &, ControllerPtr &, char *[]);
+void plot(const Analyzers &, char *[]);
+
+int main(int argc, char *argv[])
+{
+    if (2 > argc)
+    {
+        cerr << "Usage: " << argv[0] << " -a analysis [-a analysis] input.pb"
+            << endl;
+
+        return 0;
+    }
+
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    int result = 0;
+    try
+    {
+        // Prepare options
+        //
+        po::options_description generic_options("Allowed Options");
+        generic_options.add_options()
+            ("help,h",
+             "Help message")
+
+            ("analysis,a",
+             po::value<vector<string> >(),
+             "analysis to run [repeatable]: "
+             "cutflow, monitor, mttbar, trigger, wtagmass")
+        ;
+
+        po::options_description hidden_options("Hidden Options");
+        hidden_options.add_options()
+            ("input,i",
+             po::value<vector<string> >(),
+             "input file(s)")
+        ;
+
+        generic_options.add(ControllerOptions().description());
+
+        po::options_description cmdline_options;
+        cmdline_options.add(generic_options).add(hidden_options);
+
+        po::positional_options_description positional_options;
+        positional_options.add("input", -1);
+
+        po::variables_map arguments;
+        po::store(po::command_line_parser(argc, argv).
+                options(cmdline_options).
+                positional(positional_options).
+                run(),
+                arguments);
+        po::notify(arguments);
+
+        // Use options
+        //
+        if (arguments.count("help"))
+            cout << generic_options << endl;
+        else if (!arguments.count("analysis"))
+            cout << "Analyses are not specified" << endl;
+        else if (!arguments.count("input"))
+            cout << "Input file(s) are not specified" << endl;
+        else
+        {
+            ControllerPtr controller(new ThreadController());
+
+            const vector<string> &inputs = arguments["input"].as<vector<string> >();
+            for(vector<string>::const_iterator input = inputs.begin();
+                    inputs.end() != input;
+                    ++input)
+            {
+                controller->push(*input);
+            }
+
+            ControllerOptions().apply(arguments, *controller);
+
+            run(arguments, controller, argv);
+        }
+    }
+    catch(...)
+    {
+        cerr << "Unknown error" << endl;
+
+        result = 1;
+    }
+
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    return result;
+}
+
+AnalyzerPtr createAnalyzer(const string &name)
+{
+    AnalyzerPtr analyzer;
+
+    if ("cutflow" == name)
+        analyzer.reset(new bsm::CutflowAnalyzer());
+    else if ("monitor" == name)
+        analyzer.reset(new bsm::MonitorAnalyzer());
+    else if ("mttbar" == name)
+        analyzer.reset(new bsm::MttbarAnalyzer());
+    else if ("trigger" == name)
+        analyzer.reset(new bsm::TriggerAnalyzer());
+    else if ("wtagmass" == name)
+        analyzer.reset(new bsm::WtagMassAnalyzer());
+
+    return analyzer;
+}
+
+void run(const po::variables_map &arguments,
+        ControllerPtr &controller,
+        char *argv[])
+try
+{
+    // Prepare Analysis
+    //
+    CompositeAnalyzerPtr analyzer(new CompositeAnalyzer());
+
+    const vector<string> &names = arguments["analysis"].as<vector<string> >();
+    for(vector<string>::const_iterator name = names.begin();
+            names.end() != name;
+            ++name)
+    {
+        AnalyzerPtr child = createAnalyzer(*name);
+        if (!child)
+        {
+            cerr << "unknown analysis: " << *name << endl;
+
+            return;
+        }
+
+        analyzer->add(child);
+    }
+
+    // Process inputs
+    //
+    controller->use(analyzer);
+    controller->start();
+
+    cout << *analyzer << endl;
+
+    plot(analyzer->analyzers(), argv);
+}
+catch(...)
+{
+}
+
+void plot(const Analyzers &analyzers, char *argv[])
+{
+    typedef shared_ptr<bsm::MonitorAnalyzer> MonitorAnalyzerPtr;
+    typedef shared_ptr<bsm::MttbarAnalyzer> MttbarAnalyzerPtr;
+    typedef shared_ptr<bsm::WtagMassAnalyzer> WtagMassAnalyzerPtr;
+
+    // Cutflow and trigger tables are printed: ROOT application is only
+    // started if there is something to draw
+    //
+    bool has_plots = false;
+    for(Analyzers::const_iterator analyzer = analyzers.begin();
+            analyzers.end() != analyzer
+                && !has_plots;
+            ++analyzer)
+    {
+        has_plots = dynamic_pointer_cast<bsm::MonitorAnalyzer>(*analyzer)
+            || dynamic_pointer_cast<bsm::MttbarAnalyzer>(*analyzer)
+            || dynamic_pointer_cast<bsm::WtagMassAnalyzer>(*analyzer);
+    }
+
+    if (!has_plots)
+        return;
+
+    // Cheat ROOT with empty args
+    //
+    int empty_argc = 1;
+    char *empty_argv[] = { argv[0] };
+    shared_ptr<TRint> app(new TRint("app", &empty_argc, empty_argv));
+
+    AnalyzerOutput output;
+    for(Analyzers::const_iterator analyzer = analyzers.begin();
+            analyzers.end() != analyzer;
+            ++analyzer)
+    {
+        if (MonitorAnalyzerPtr monitor =
+                dynamic_pointer_cast<bsm::MonitorAnalyzer>(*analyzer))
+            output.draw(*monitor);
+        else if (MttbarAnalyzerPtr mttbar =
+                dynamic_pointer_cast<bsm::MttbarAnalyzer>(*analyzer))
+            output.draw(*mttbar);
+        else if (WtagMassAnalyzerPtr wtagmass =
+                dynamic_pointer_cast<bsm::WtagMassAnalyzer>(*analyzer))
+            output.draw(*wtagmass);
+    }
+
+    app->Run();
+}
@@ -8,6 +8,7 @@
 #include <iostream>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/program_options.hpp>
 
 #include <TCanvas.h>
 #include <TH1.h>
@@ -23,16 +24,22 @@
 #include "interface/ClosestJetAnalyzer.h"
 #include "interface/Monitor.h"
 #include "interface/MonitorCanvas.h"
+#include "interface/ControllerOptions.h"
 #include "interface/Thread.h"
 
 using std::cerr;
 using std::cout;
 using std::endl;
+using std::string;
+using std::vector;
 
 using boost::shared_ptr;
 
+namespace po = boost::program_options;
+
 using bsm::ClosestJetAnalyzer;
 using bsm::DeltaCanvas;
+using bsm::ControllerOptions;
 using bsm::ThreadController;
 using bsm::stat::convert;
 using bsm::stat::TH1Ptr;
@@ -59,11 +66,59 @@ int main(int argc, char *argv[])
     int result = 0;
     try
     {
-        ControllerPtr controller(new ThreadController());
-        for(int i = 1; argc > i; ++i)
-            controller->push(argv[i]);
-
-        run(controller);
+        // Prepare options
+        //
+        po::options_description generic_options("Allowed Options");
+        generic_options.add_options()
+            ("help,h",
+             "Help message")
+        ;
+
+        po::options_description hidden_options("Hidden Options");
+        hidden_options.add_options()
+            ("input,i",
+             po::value<vector<string> >(),
+             "input file(s)")
+        ;
+
+        generic_options.add(ControllerOptions().description());
+
+        po::options_description cmdline_options;
+        cmdline_options.add(generic_options).add(hidden_options);
+
+        po::positional_options_description positional_options;
+        positional_options.add("input", -1);
+
+        po::variables_map arguments;
+        po::store(po::command_line_parser(argc, argv).
+                options(cmdline_options).
+                positional(positional_options).
+                run(),
+                arguments);
+        po::notify(arguments);
+
+        // Use options
+        //
+        if (arguments.count("help"))
+            cout << generic_options << endl;
+        else if (!arguments.count("input"))
+            cout << "Input file(s) are not specified" << endl;
+        else
+        {
+            ControllerPtr controller(new ThreadController());
+
+            const vector<string> &inputs = arguments["input"].as<vector<string> >();
+            for(vector<string>::const_iterator input = inputs.begin();
+                    inputs.end() != input;
+                    ++input)
+            {
+                controller->push(*input);
+            }
+
+            ControllerOptions().apply(arguments, *controller);
+
+            run(controller);
+        }
     }
     catch(...)
     {
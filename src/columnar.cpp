@@ -0,0 +1,157 @@
+// Convert bsm_input files into the columnar cache
+//
+// Copyright 2011, All rights reserved
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "bsm_input/interface/Reader.h"
+#include "interface/ColumnarFile.h"
+
+using namespace std;
+
+using boost::shared_ptr;
+
+namespace po = boost::program_options;
+
+using bsm::ColumnarWriter;
+using bsm::Event;
+using bsm::Reader;
+
+bool convert(const po::variables_map &);
+
+int main(int argc, char *argv[])
+{
+    if (2 > argc)
+    {
+        cerr << "Usage: " << argv[0] << " -o output.col input.pb" << endl;
+
+        return 0;
+    }
+
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    int result = 0;
+    try
+    {
+        // Prepare options
+        //
+        po::options_description generic_options("Allowed Options");
+        generic_options.add_options()
+            ("help,h",
+             "Help message")
+
+            ("output,o",
+             po::value<string>(),
+             "output columnar file")
+
+            ("block",
+             po::value<uint32_t>()->default_value(4096),
+             "number of events per block (blocks are limited to 32 MB)")
+        ;
+
+        po::options_description hidden_options("Hidden Options");
+        hidden_options.add_options()
+            ("input,i",
+             po::value<vector<string> >(),
+             "input file(s)")
+        ;
+
+        po::options_description cmdline_options;
+        cmdline_options.add(generic_options).add(hidden_options);
+
+        po::positional_options_description positional_options;
+        positional_options.add("input", -1);
+
+        po::variables_map arguments;
+        po::store(po::command_line_parser(argc, argv).
+                options(cmdline_options).
+                positional(positional_options).
+                run(),
+                arguments);
+        po::notify(arguments);
+
+        // Use options
+        //
+        if (arguments.count("help"))
+            cout << generic_options << endl;
+        else if (!arguments.count("input"))
+            cout << "Input file(s) are not specified" << endl;
+        else if (!arguments.count("output"))
+            cout << "Output file is not specified" << endl;
+        else if (!convert(arguments))
+            result = 1;
+    }
+    catch(...)
+    {
+        cerr << "Unknown error" << endl;
+
+        result = 1;
+    }
+
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    return result;
+}
+
+bool convert(const po::variables_map &arguments)
+{
+    ColumnarWriter writer(arguments["output"].as<string>(),
+            arguments["block"].as<uint32_t>());
+
+    writer.open();
+    if (!writer.isOpen())
+    {
+        cerr << "failed to open output: " << writer.filename() << endl;
+
+        return false;
+    }
+
+    const vector<string> &inputs = arguments["input"].as<vector<string> >();
+    for(vector<string>::const_iterator input = inputs.begin();
+            inputs.end() != input;
+            ++input)
+    {
+        cout << *input << endl;
+
+        shared_ptr<Reader> reader(new Reader(*input));
+        reader->open();
+        if (!reader->isOpen())
+        {
+            cerr << "failed to open input: " << *input << endl;
+
+            continue;
+        }
+
+        for(shared_ptr<Event> event(new Event());
+                reader->read(event);
+                event->Clear())
+        {
+            if (!writer.write(*event))
+            {
+                cerr << "failed to write: " << writer.filename() << endl;
+
+                return false;
+            }
+        }
+    }
+
+    if (!writer.close())
+    {
+        cerr << "failed to write: " << writer.filename() << endl;
+
+        return false;
+    }
+
+    cout << writer.events() << " events in " << writer.blocks()
+        << " block(s) written to " << writer.filename() << endl;
+
+    return true;
+}
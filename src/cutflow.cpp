@@ -8,16 +8,21 @@
 #include <iostream>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/program_options.hpp>
 
 #include "bsm_input/interface/Event.pb.h"
 #include "interface/CutflowAnalyzer.h"
+#include "interface/ControllerOptions.h"
 #include "interface/Thread.h"
 
 using namespace std;
 
 using boost::shared_ptr;
 
+namespace po = boost::program_options;
+
 using bsm::CutflowAnalyzer;
+using bsm::ControllerOptions;
 using bsm::ThreadController;
 
 typedef shared_ptr<CutflowAnalyzer> CutflowAnalyzerPtr;
@@ -39,11 +44,59 @@ int main(int argc, char *argv[])
     int result = 0;
     try
     {
-        ControllerPtr controller(new ThreadController());
-        for(int i = 1; argc > i; ++i)
-            controller->push(argv[i]);
-
-        run(controller);
+        // Prepare options
+        //
+        po::options_description generic_options("Allowed Options");
+        generic_options.add_options()
+            ("help,h",
+             "Help message")
+        ;
+
+        po::options_description hidden_options("Hidden Options");
+        hidden_options.add_options()
+            ("input,i",
+             po::value<vector<string> >(),
+             "input file(s)")
+        ;
+
+        generic_options.add(ControllerOptions().description());
+
+        po::options_description cmdline_options;
+        cmdline_options.add(generic_options).add(hidden_options);
+
+        po::positional_options_description positional_options;
+        positional_options.add("input", -1);
+
+        po::variables_map arguments;
+        po::store(po::command_line_parser(argc, argv).
+                options(cmdline_options).
+                positional(positional_options).
+                run(),
+                arguments);
+        po::notify(arguments);
+
+        // Use options
+        //
+        if (arguments.count("help"))
+            cout << generic_options << endl;
+        else if (!arguments.count("input"))
+            cout << "Input file(s) are not specified" << endl;
+        else
+        {
+            ControllerPtr controller(new ThreadController());
+
+            const vector<string> &inputs = arguments["input"].as<vector<string> >();
+            for(vector<string>::const_iterator input = inputs.begin();
+                    inputs.end() != input;
+                    ++input)
+            {
+                controller->push(*input);
+            }
+
+            ControllerOptions().apply(arguments, *controller);
+
+            run(controller);
+        }
     }
     catch(...)
     {
@@ -1,20 +1,29 @@
 // Dump Event content given the run/lumi and event numbers
-// (multi-threads)
+// (multi-threads). Selected events are read directly with the event index
+// (see EventIndex): indices are built in parallel and inputs are scanned
+// only if index can not be built
 //
 // Created by Samvel Khalatyan, Jul 07, 2011
 // Copyright 2011, All rights reserved
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <vector>
 
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/program_options.hpp>
 #include <boost/regex.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
 
 #include "bsm_input/interface/Event.pb.h"
 #include "interface/DumpEventAnalyzer.h"
+#include "interface/ControllerOptions.h"
+#include "interface/EventIndex.h"
+#include "interface/RecordReader.h"
 #include "interface/Thread.h"
 
 using namespace std;
@@ -27,12 +36,41 @@ using boost::smatch;
 namespace po = boost::program_options;
 
 using bsm::DumpEventAnalyzer;
+using bsm::ControllerOptions;
+using bsm::Event;
+using bsm::EventIndex;
+using bsm::RecordReader;
 using bsm::ThreadController;
 
 typedef shared_ptr<DumpEventAnalyzer> DumpEventAnalyzerPtr;
 typedef shared_ptr<ThreadController> ControllerPtr;
 
-void run(const po::variables_map &, ControllerPtr &);
+struct EventID
+{
+    uint32_t id;
+    uint32_t lumi;
+    uint32_t run;
+};
+
+typedef vector<EventID> EventIDs;
+typedef vector<string> Inputs;
+
+typedef shared_ptr<EventIndex> EventIndexPtr;
+typedef vector<EventIndexPtr> EventIndices;
+
+void run(const po::variables_map &, const Inputs &);
+
+// Build indices of the inputs in parallel: threads take the next input
+// until all of them are indexed. Index is left empty if input can not be
+// indexed
+//
+void buildIndices(const Inputs &, EventIndices &);
+void indexInputs(const Inputs &, EventIndices &, boost::atomic<uint32_t> &);
+
+// Dump events found in the index. False is returned if input can not be
+// read
+//
+bool dumpIndexed(const EventIndex &, const EventIDs &, DumpEventAnalyzerPtr &);
 
 int main(int argc, char *argv[])
 {
@@ -58,6 +96,9 @@ int main(int argc, char *argv[])
             ("event,e",
              po::value<vector<string> >(),
              "event selection [repeatable]. Format: event[:lumi[:run]]")
+
+            ("scan",
+             "read all events instead of using the event index")
         ;
 
         po::options_description hidden_options("Hidden Options");
@@ -67,6 +108,8 @@ int main(int argc, char *argv[])
              "input file(s)")
         ;
 
+        generic_options.add(ControllerOptions().description());
+
         po::options_description cmdline_options;
         cmdline_options.add(generic_options).add(hidden_options);
 
@@ -88,20 +131,7 @@ int main(int argc, char *argv[])
         else if (!arguments.count("input"))
             cout << "Input file(s) are not specified" << endl;
         else
-        {
-            ControllerPtr controller(new ThreadController());
-
-            const vector<string> &inputs = arguments["input"].as<vector<string> >();
-            for(vector<string>::const_iterator input = inputs.begin();
-                    inputs.end() != input;
-                    ++input)
-            {
-                cout << *input << endl;
-                controller->push(*input);
-            }
-
-            run(arguments, controller);
-        }
+            run(arguments, arguments["input"].as<Inputs>());
     }
     catch(...)
     {
@@ -117,13 +147,14 @@ int main(int argc, char *argv[])
     return result;
 }
 
-void run(const po::variables_map &arguments, ControllerPtr &controller)
+void run(const po::variables_map &arguments, const Inputs &inputs)
 try
 {
     // Prepare Analysis
     //
     DumpEventAnalyzerPtr analyzer(new DumpEventAnalyzer());
 
+    EventIDs event_ids;
     if (arguments.count("event"))
     {
         const vector<string> &events = arguments["event"].as<vector<string> >();
@@ -141,26 +172,138 @@ try
                 continue;
             }
 
-            uint32_t id = lexical_cast<uint32_t>(matches[1]);
-            uint32_t lumi = matches[2].matched
+            EventID event_id;
+            event_id.id = lexical_cast<uint32_t>(matches[1]);
+            event_id.lumi = matches[2].matched
                 ? lexical_cast<uint32_t>(matches[2])
                 : 0;
 
-            uint32_t run = matches[3].matched
+            event_id.run = matches[3].matched
                 ? lexical_cast<uint32_t>(matches[3])
                 : 0;
 
-            analyzer->addEvent(id, lumi, run);
+            analyzer->addEvent(event_id.id, event_id.lumi, event_id.run);
+
+            event_ids.push_back(event_id);
         }
     }
 
-    // Process inputs
+    // All events are dumped if none is selected: there is nothing to look
+    // up in the index
     //
-    controller->use(analyzer);
-    controller->start();
+    const bool use_index = !event_ids.empty() && !arguments.count("scan");
+
+    EventIndices indices(inputs.size());
+    if (use_index)
+        buildIndices(inputs, indices);
+
+    ControllerPtr controller(new ThreadController());
+
+    uint32_t scanned_inputs = 0;
+    for(uint32_t input = 0; inputs.size() > input; ++input)
+    {
+        cout << inputs[input] << endl;
+
+        if (indices[input]
+                && dumpIndexed(*indices[input], event_ids, analyzer))
+            continue;
+
+        controller->push(inputs[input]);
+        ++scanned_inputs;
+    }
+
+    // Process inputs that could not be indexed
+    //
+    if (scanned_inputs)
+    {
+        ControllerOptions().apply(arguments, *controller);
+
+        controller->use(analyzer);
+        controller->start();
+    }
 
     cout << *analyzer << endl;
 }
 catch(...)
 {
 }
+
+void buildIndices(const Inputs &inputs, EventIndices &indices)
+{
+    boost::atomic<uint32_t> next(0);
+
+    boost::thread_group builders;
+    for(uint32_t builder = 0;
+            boost::thread::hardware_concurrency() > builder
+                && inputs.size() > builder;
+            ++builder)
+    {
+        builders.create_thread(boost::bind(indexInputs,
+                    boost::cref(inputs),
+                    boost::ref(indices),
+                    boost::ref(next)));
+    }
+    builders.join_all();
+}
+
+void indexInputs(const Inputs &inputs,
+        EventIndices &indices,
+        boost::atomic<uint32_t> &next)
+{
+    for(uint32_t input = next.fetch_add(1, boost::memory_order_relaxed);
+            inputs.size() > input;
+            input = next.fetch_add(1, boost::memory_order_relaxed))
+    {
+        EventIndexPtr index(new EventIndex(inputs[input]));
+        if (index->build())
+            indices[input] = index;
+    }
+}
+
+bool dumpIndexed(const EventIndex &index,
+        const EventIDs &event_ids,
+        DumpEventAnalyzerPtr &analyzer)
+{
+    const string input = index.filename();
+
+    EventIndex::Offsets offsets;
+    for(EventIDs::const_iterator event_id = event_ids.begin();
+            event_ids.end() != event_id;
+            ++event_id)
+    {
+        index.find(event_id->id, event_id->lumi, event_id->run, offsets);
+    }
+
+    // Read records in the file order
+    //
+    sort(offsets.begin(), offsets.end());
+    offsets.erase(unique(offsets.begin(), offsets.end()), offsets.end());
+
+    RecordReader reader(input);
+    reader.open();
+    if (!reader.isOpen())
+        return false;
+
+    analyzer->onFileOpen(input, reader.input().get());
+
+    shared_ptr<Event> event(new Event());
+    for(EventIndex::Offsets::const_iterator offset = offsets.begin();
+            offsets.end() != offset;
+            ++offset)
+    {
+        event->Clear();
+
+        if (!reader.seek(*offset)
+                || !reader.read(event))
+        {
+            cerr << "failed to read event at " << *offset
+                << " in " << input << endl;
+
+            continue;
+        }
+
+        analyzer->process(event.get());
+    }
+
+    return true;
+}
@@ -0,0 +1,126 @@
+// Build run/lumi/event index sidecars of the bsm_input files
+//
+// Copyright 2011, All rights reserved
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "interface/EventIndex.h"
+
+using namespace std;
+
+namespace po = boost::program_options;
+
+using bsm::EventIndex;
+
+bool index(const po::variables_map &);
+
+int main(int argc, char *argv[])
+{
+    if (2 > argc)
+    {
+        cerr << "Usage: " << argv[0] << " input.pb" << endl;
+
+        return 0;
+    }
+
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    int result = 0;
+    try
+    {
+        // Prepare options
+        //
+        po::options_description generic_options("Allowed Options");
+        generic_options.add_options()
+            ("help,h",
+             "Help message")
+
+            ("force,f",
+             "rebuild sidecars even if they are up to date")
+        ;
+
+        po::options_description hidden_options("Hidden Options");
+        hidden_options.add_options()
+            ("input,i",
+             po::value<vector<string> >(),
+             "input file(s)")
+        ;
+
+        po::options_description cmdline_options;
+        cmdline_options.add(generic_options).add(hidden_options);
+
+        po::positional_options_description positional_options;
+        positional_options.add("input", -1);
+
+        po::variables_map arguments;
+        po::store(po::command_line_parser(argc, argv).
+                options(cmdline_options).
+                positional(positional_options).
+                run(),
+                arguments);
+        po::notify(arguments);
+
+        // Use options
+        //
+        if (arguments.count("help"))
+            cout << generic_options << endl;
+        else if (!arguments.count("input"))
+            cout << "Input file(s) are not specified" << endl;
+        else if (!index(arguments))
+            result = 1;
+    }
+    catch(...)
+    {
+        cerr << "Unknown error" << endl;
+
+        result = 1;
+    }
+
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    return result;
+}
+
+bool index(const po::variables_map &arguments)
+{
+    const bool force = arguments.count("force");
+
+    bool result = true;
+
+    const vector<string> &inputs = arguments["input"].as<vector<string> >();
+    for(vector<string>::const_iterator input = inputs.begin();
+            inputs.end() != input;
+            ++input)
+    {
+        EventIndex index(*input);
+
+        bool is_indexed = false;
+        if (!force
+                && index.load())
+            is_indexed = true;
+        else if (!index.scan())
+            cerr << "failed to index: " << *input << endl;
+        else if (!index.save())
+            cerr << "failed to save: " << index.sidecar() << endl;
+        else
+            is_indexed = true;
+
+        if (!is_indexed)
+        {
+            result = false;
+
+            continue;
+        }
+
+        cout << index.sidecar() << ": " << index.size() << " events" << endl;
+    }
+
+    return result;
+}
@@ -8,24 +8,27 @@
 #include <iostream>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/program_options.hpp>
 
 #include "bsm_input/interface/Event.pb.h"
+#include "interface/ControllerOptions.h"
 #include "interface/FilterAnalyzer.h"
 #include "interface/Thread.h"
 
-using std::cerr;
-using std::cout;
-using std::endl;
+using namespace std;
 
 using boost::shared_ptr;
 
+namespace po = boost::program_options;
+
+using bsm::ControllerOptions;
 using bsm::FilterAnalyzer;
 using bsm::ThreadController;
 
 typedef shared_ptr<FilterAnalyzer> FilterAnalyzerPtr;
 typedef shared_ptr<ThreadController> ControllerPtr;
 
-void run(ControllerPtr &);
+void run(const po::variables_map &, ControllerPtr &);
 
 int main(int argc, char *argv[])
 {
@@ -41,11 +44,67 @@ int main(int argc, char *argv[])
     int result = 0;
     try
     {
-        ControllerPtr controller(new ThreadController());
-        for(int i = 1; argc > i; ++i)
-            controller->push(argv[i]);
-
-        run(controller);
+        // Prepare options
+        //
+        po::options_description generic_options("Allowed Options");
+        generic_options.add_options()
+            ("help,h",
+             "Help message")
+
+            ("output,o",
+             po::value<string>()->default_value("skim"),
+             "output files prefix: prefix_N.pb")
+
+            ("output-mb",
+             po::value<uint32_t>()->default_value(1024),
+             "start new output file every N megabytes")
+        ;
+
+        po::options_description hidden_options("Hidden Options");
+        hidden_options.add_options()
+            ("input,i",
+             po::value<vector<string> >(),
+             "input file(s)")
+        ;
+
+        generic_options.add(ControllerOptions().description());
+
+        po::options_description cmdline_options;
+        cmdline_options.add(generic_options).add(hidden_options);
+
+        po::positional_options_description positional_options;
+        positional_options.add("input", -1);
+
+        po::variables_map arguments;
+        po::store(po::command_line_parser(argc, argv).
+                options(cmdline_options).
+                positional(positional_options).
+                run(),
+                arguments);
+        po::notify(arguments);
+
+        // Use options
+        //
+        if (arguments.count("help"))
+            cout << generic_options << endl;
+        else if (!arguments.count("input"))
+            cout << "Input file(s) are not specified" << endl;
+        else
+        {
+            ControllerPtr controller(new ThreadController());
+
+            const vector<string> &inputs = arguments["input"].as<vector<string> >();
+            for(vector<string>::const_iterator input = inputs.begin();
+                    inputs.end() != input;
+                    ++input)
+            {
+                controller->push(*input);
+            }
+
+            ControllerOptions().apply(arguments, *controller);
+
+            run(arguments, controller);
+        }
     }
     catch(...)
     {
@@ -61,18 +120,25 @@ int main(int argc, char *argv[])
     return result;
 }
 
-void run(ControllerPtr &controller)
+void run(const po::variables_map &arguments, ControllerPtr &controller)
 try
 {
     // Prepare Analysis
     //
-    FilterAnalyzerPtr analyzer(new FilterAnalyzer());
+    FilterAnalyzerPtr analyzer(new FilterAnalyzer(
+                arguments["output"].as<string>(),
+                static_cast<uint64_t>(arguments["output-mb"].as<uint32_t>())
+                    * 1024 * 1024));
 
     // Process inputs
     //
     controller->use(analyzer);
     controller->start();
 
+    // Events left in the writer queue are written before the summary
+    //
+    analyzer->close();
+
     cout << *analyzer << endl;
 }
 catch(...)
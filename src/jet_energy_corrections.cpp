@@ -18,6 +18,7 @@
 #include "bsm_input/interface/Reader.h"
 #include "interface/MonitorCanvas.h"
 #include "interface/JetEnergyCorrectionsAnalyzer.h"
+#include "interface/ControllerOptions.h"
 #include "interface/Thread.h"
 
 using namespace std;
@@ -31,6 +32,7 @@ using bsm::JetEnergyCorrectionsAnalyzer;
 using bsm::Reader;
 using bsm::Event;
 using bsm::LorentzVectorCanvas;
+using bsm::ControllerOptions;
 using bsm::ThreadController;
 
 typedef shared_ptr<JetEnergyCorrectionsAnalyzer> AnalyzerPtr;
@@ -74,6 +76,8 @@ int main(int argc, char *argv[])
              "input file(s)")
         ;
 
+        generic_options.add(ControllerOptions().description());
+
         po::options_description cmdline_options;
         cmdline_options.add(generic_options).add(hidden_options);
 
@@ -178,6 +182,8 @@ try
         controller->push(*input);
     }
 
+    ControllerOptions().apply(arguments, *controller);
+
     controller->use(analyzer);
     controller->start();
 
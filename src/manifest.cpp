@@ -0,0 +1,156 @@
+// Build dataset manifest of the file list: size, number of events and run
+// range of every input. Existing manifest is updated: only new and
+// changed files are scanned
+//
+// Copyright 2011, All rights reserved
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+#include <boost/thread.hpp>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "interface/DatasetManifest.h"
+
+using namespace std;
+
+namespace po = boost::program_options;
+
+using bsm::DatasetManifest;
+
+bool manifest(const po::variables_map &);
+
+int main(int argc, char *argv[])
+{
+    if (2 > argc)
+    {
+        cerr << "Usage: " << argv[0] << " list.txt" << endl;
+
+        return 0;
+    }
+
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    int result = 0;
+    try
+    {
+        // Prepare options
+        //
+        po::options_description generic_options("Allowed Options");
+        generic_options.add_options()
+            ("help,h",
+             "Help message")
+
+            ("output,o",
+             po::value<string>(),
+             "manifest file [default: list.txt.manifest]")
+
+            ("threads",
+             po::value<uint32_t>(),
+             "Number of scan threads [default: number of cores]")
+        ;
+
+        po::options_description hidden_options("Hidden Options");
+        hidden_options.add_options()
+            ("list,l",
+             po::value<string>(),
+             "file list")
+        ;
+
+        po::options_description cmdline_options;
+        cmdline_options.add(generic_options).add(hidden_options);
+
+        po::positional_options_description positional_options;
+        positional_options.add("list", 1);
+
+        po::variables_map arguments;
+        po::store(po::command_line_parser(argc, argv).
+                options(cmdline_options).
+                positional(positional_options).
+                run(),
+                arguments);
+        po::notify(arguments);
+
+        // Use options
+        //
+        if (arguments.count("help"))
+            cout << generic_options << endl;
+        else if (!arguments.count("list"))
+            cout << "File list is not specified" << endl;
+        else if (!manifest(arguments))
+            result = 1;
+    }
+    catch(...)
+    {
+        cerr << "Unknown error" << endl;
+
+        result = 1;
+    }
+
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    return result;
+}
+
+bool manifest(const po::variables_map &arguments)
+{
+    const string list = arguments["list"].as<string>();
+
+    DatasetManifest::Files files;
+    if (!DatasetManifest::readList(list, files))
+    {
+        cerr << "failed to read file list: " << list << endl;
+
+        return false;
+    }
+
+    DatasetManifest manifest(arguments.count("output")
+            ? arguments["output"].as<string>()
+            : list + ".manifest");
+
+    // Missing or broken manifest is built from scratch
+    //
+    manifest.load();
+
+    const uint32_t scanned = manifest.update(files,
+            arguments.count("threads")
+                ? arguments["threads"].as<uint32_t>()
+                : boost::thread::hardware_concurrency());
+
+    if (!manifest.save())
+    {
+        cerr << "failed to save manifest: " << manifest.filename() << endl;
+
+        return false;
+    }
+
+    // Files that could not be scanned are left out of the manifest
+    //
+    uint32_t failed = 0;
+    for(DatasetManifest::Files::const_iterator file = files.begin();
+            files.end() != file;
+            ++file)
+    {
+        DatasetManifest::Entry entry;
+        if (manifest.find(*file, entry))
+            continue;
+
+        cerr << "failed to scan: " << *file << endl;
+
+        ++failed;
+    }
+
+    cout << manifest.filename() << endl;
+    cout << "  Files: " << manifest.size() << " (" << scanned << " scanned)"
+        << endl;
+    cout << " Events: " << manifest.events() << endl;
+    cout << "   Size: " << manifest.bytes() / 1024 / 1024 << " MB" << endl;
+    cout << "   Runs: " << manifest.firstRun() << " - " << manifest.lastRun()
+        << endl;
+
+    return !failed;
+}
@@ -8,28 +8,29 @@
 #include <iostream>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/program_options.hpp>
 
-#include <TCanvas.h>
-#include <TH1.h>
 #include <TRint.h>
 
-#include "bsm_stat/interface/Utility.h"
-
-#include "interface/Monitor.h"
-#include "interface/MonitorCanvas.h"
+#include "interface/AnalyzerOutput.h"
 #include "interface/MonitorAnalyzer.h"
+#include "interface/ControllerOptions.h"
 #include "interface/Thread.h"
 
 using std::cerr;
 using std::cout;
 using std::endl;
+using std::string;
+using std::vector;
 
 using boost::shared_ptr;
 
+namespace po = boost::program_options;
+
+using bsm::AnalyzerOutput;
 using bsm::MonitorAnalyzer;
+using bsm::ControllerOptions;
 using bsm::ThreadController;
-using bsm::stat::convert;
-using bsm::stat::TH1Ptr;
 
 using namespace bsm;
 
@@ -53,11 +54,59 @@ int main(int argc, char *argv[])
     int result = 0;
     try
     {
-        ControllerPtr controller(new ThreadController());
-        for(int i = 1; argc > i; ++i)
-            controller->push(argv[i]);
-
-        run(controller, argv);
+        // Prepare options
+        //
+        po::options_description generic_options("Allowed Options");
+        generic_options.add_options()
+            ("help,h",
+             "Help message")
+        ;
+
+        po::options_description hidden_options("Hidden Options");
+        hidden_options.add_options()
+            ("input,i",
+             po::value<vector<string> >(),
+             "input file(s)")
+        ;
+
+        generic_options.add(ControllerOptions().description());
+
+        po::options_description cmdline_options;
+        cmdline_options.add(generic_options).add(hidden_options);
+
+        po::positional_options_description positional_options;
+        positional_options.add("input", -1);
+
+        po::variables_map arguments;
+        po::store(po::command_line_parser(argc, argv).
+                options(cmdline_options).
+                positional(positional_options).
+                run(),
+                arguments);
+        po::notify(arguments);
+
+        // Use options
+        //
+        if (arguments.count("help"))
+            cout << generic_options << endl;
+        else if (!arguments.count("input"))
+            cout << "Input file(s) are not specified" << endl;
+        else
+        {
+            ControllerPtr controller(new ThreadController());
+
+            const vector<string> &inputs = arguments["input"].as<vector<string> >();
+            for(vector<string>::const_iterator input = inputs.begin();
+                    inputs.end() != input;
+                    ++input)
+            {
+                controller->push(*input);
+            }
+
+            ControllerOptions().apply(arguments, *controller);
+
+            run(controller, argv);
+        }
     }
     catch(...)
     {
@@ -103,26 +152,8 @@ void plot(const MonitorAnalyzerPtr &analyzer, char *argv[])
     char *empty_argv[] = { argv[0] };
     shared_ptr<TRint> app(new TRint("app", &empty_argc, empty_argv));
 
-    shared_ptr<JetCanvas> jet_canvas(new JetCanvas("Jets"));
-    jet_canvas->draw(*analyzer->jets());
-
-    shared_ptr<MuonCanvas> mu_pf_canvas(new MuonCanvas("Particle Flow Muons"));
-    mu_pf_canvas->draw(*analyzer->pfMuons());
-
-    shared_ptr<MuonCanvas> mu_reco_canvas(new MuonCanvas("Reco Muons"));
-    mu_reco_canvas->draw(*analyzer->recoMuons());
-
-    shared_ptr<ElectronCanvas> el_pf_canvas(new ElectronCanvas("Particle Flow Electrons"));
-    el_pf_canvas->draw(*analyzer->pfElectrons());
-
-    shared_ptr<ElectronCanvas> el_gsf_canvas(new ElectronCanvas("GSF Electrons"));
-    el_gsf_canvas->draw(*analyzer->gsfElectrons());
-
-    shared_ptr<PrimaryVertexCanvas> pv_canvas(new PrimaryVertexCanvas("Primary Vertex"));
-    pv_canvas->draw(*analyzer->primaryVertices());
-
-    shared_ptr<MissingEnergyCanvas> met_canvas(new MissingEnergyCanvas("Missing Energy"));
-    met_canvas->draw(*analyzer->missingEnergy());
+    AnalyzerOutput output;
+    output.draw(*analyzer);
 
     app->Run();
 }
@@ -0,0 +1,143 @@
+// Write Events of the bsm_input files to the standard output as a stream
+// of records (see StreamReader). Stream carries one Input: trigger menus of
+// all inputs are merged into it. Records are copied without parsing:
+//
+//  bsm_stream input.pb [input.pb ...] | bsm_cutflow -
+//
+// Copyright 2011, All rights reserved
+
+#include <signal.h>
+#include <unistd.h>
+
+#include <iostream>
+#include <set>
+#include <string>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "bsm_input/interface/Input.pb.h"
+#include "interface/RecordReader.h"
+
+using namespace std;
+
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::io::FileOutputStream;
+
+using bsm::Input;
+using bsm::RecordReader;
+using bsm::TriggerItem;
+
+// Add triggers of the input that are not in the stream Input yet
+//
+void merge(Input &stream_input, const Input &input, set<uint64_t> &hashes)
+{
+    typedef ::google::protobuf::RepeatedPtrField<TriggerItem> TriggerItems;
+
+    for(TriggerItems::const_iterator hlt = input.info().triggers().begin();
+            input.info().triggers().end() != hlt;
+            ++hlt)
+    {
+        if (hashes.insert(hlt->hash()).second)
+            *stream_input.mutable_info()->add_triggers() = *hlt;
+    }
+}
+
+int main(int argc, char *argv[])
+try
+{
+    if (2 > argc)
+    {
+        cerr << "Usage: " << argv[0] << " input.pb [input.pb ...]" << endl;
+        cerr << endl;
+
+        return 0;
+    }
+
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    // Consumer may quit early: write fails instead of killing the process
+    //
+    signal(SIGPIPE, SIG_IGN);
+
+    int result = 0;
+
+    // Inputs are opened twice: Input goes to the stream before any event
+    //
+    Input input;
+    {
+        set<uint64_t> hashes;
+        for(int i = 1; argc > i; ++i)
+        {
+            RecordReader reader(argv[i]);
+            reader.open();
+            if (reader.isOpen())
+                merge(input, *reader.input(), hashes);
+        }
+    }
+
+    uint64_t events = 0;
+    {
+        FileOutputStream raw_out(STDOUT_FILENO);
+
+        bool is_written = true;
+        {
+            CodedOutputStream coded_out(&raw_out);
+
+            string record = input.SerializeAsString();
+            coded_out.WriteVarint32(record.size());
+            coded_out.WriteString(record);
+
+            for(int i = 1; argc > i && !coded_out.HadError(); ++i)
+            {
+                RecordReader reader(argv[i]);
+                reader.open();
+                if (!reader.isOpen())
+                {
+                    cerr << "failed to open: " << argv[i] << endl;
+
+                    result = 1;
+
+                    continue;
+                }
+
+                for(; reader.read(record) && !coded_out.HadError(); ++events)
+                {
+                    coded_out.WriteVarint32(record.size());
+                    coded_out.WriteString(record);
+                }
+            }
+
+            is_written = !coded_out.HadError();
+        }
+
+        // Coded stream hands the last bytes to the raw one when destroyed
+        //
+        if (!is_written
+                || !raw_out.Flush())
+        {
+            cerr << "failed to write stream" << endl;
+
+            result = 1;
+        }
+    }
+
+    cerr << "Streamed " << events << " events" << endl;
+
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    return result;
+}
+catch(...)
+{
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    cerr << "Unknown error" << endl;
+
+    return 1;
+}
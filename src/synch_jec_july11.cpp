@@ -18,6 +18,7 @@
 #include "bsm_input/interface/Reader.h"
 #include "interface/MonitorCanvas.h"
 #include "interface/SynchAnalyzer.h"
+#include "interface/ControllerOptions.h"
 #include "interface/Thread.h"
 
 using namespace std;
@@ -31,6 +32,7 @@ using bsm::SynchJECJuly2011Analyzer;
 using bsm::Reader;
 using bsm::Event;
 using bsm::LorentzVectorCanvas;
+using bsm::ControllerOptions;
 using bsm::ThreadController;
 
 typedef shared_ptr<SynchJECJuly2011Analyzer> AnalyzerPtr;
@@ -78,6 +80,8 @@ int main(int argc, char *argv[])
              "input file(s)")
         ;
 
+        generic_options.add(ControllerOptions().description());
+
         po::options_description cmdline_options;
         cmdline_options.add(generic_options).add(hidden_options);
 
@@ -204,6 +208,8 @@ try
         controller->push(*input);
     }
 
+    ControllerOptions().apply(arguments, *controller);
+
     controller->use(analyzer);
     controller->start();
 
@@ -16,6 +16,7 @@
 #include "bsm_input/interface/Event.pb.h"
 #include "interface/MonitorCanvas.h"
 #include "interface/SynchAnalyzer.h"
+#include "interface/ControllerOptions.h"
 #include "interface/Thread.h"
 
 using namespace std;
@@ -25,6 +26,7 @@ using boost::shared_ptr;
 namespace po = boost::program_options;
 
 using bsm::SynchJuly2011Analyzer;
+using bsm::ControllerOptions;
 using bsm::ThreadController;
 
 typedef shared_ptr<SynchJuly2011Analyzer> SynchAnalyzerPtr;
@@ -68,6 +70,8 @@ int main(int argc, char *argv[])
              "input file(s)")
         ;
 
+        generic_options.add(ControllerOptions().description());
+
         po::options_description cmdline_options;
         cmdline_options.add(generic_options).add(hidden_options);
 
@@ -101,6 +105,8 @@ int main(int argc, char *argv[])
                 controller->push(*input);
             }
 
+            ControllerOptions().apply(arguments, *controller);
+
             run(argv, arguments, controller);
         }
     }
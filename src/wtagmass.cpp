@@ -8,23 +8,29 @@
 #include <iostream>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/program_options.hpp>
 
 #include <TRint.h>
-#include <TH1.h>
 
 #include "bsm_input/interface/Event.pb.h"
-#include "bsm_stat/interface/bsm_stat_fwd.h"
-#include "bsm_stat/interface/Utility.h"
+#include "interface/AnalyzerOutput.h"
 #include "interface/WtagMassAnalyzer.h"
+#include "interface/ControllerOptions.h"
 #include "interface/Thread.h"
 
 using std::cerr;
 using std::cout;
 using std::endl;
+using std::string;
+using std::vector;
 
 using boost::shared_ptr;
 
+namespace po = boost::program_options;
+
+using bsm::AnalyzerOutput;
 using bsm::WtagMassAnalyzer;
+using bsm::ControllerOptions;
 using bsm::ThreadController;
 
 typedef shared_ptr<WtagMassAnalyzer> WtagMassAnalyzerPtr;
@@ -46,11 +52,59 @@ int main(int argc, char *argv[])
     int result = 0;
     try
     {
-        ControllerPtr controller(new ThreadController());
-        for(int i = 1; argc > i; ++i)
-            controller->push(argv[i]);
-
-        run(controller, argv);
+        // Prepare options
+        //
+        po::options_description generic_options("Allowed Options");
+        generic_options.add_options()
+            ("help,h",
+             "Help message")
+        ;
+
+        po::options_description hidden_options("Hidden Options");
+        hidden_options.add_options()
+            ("input,i",
+             po::value<vector<string> >(),
+             "input file(s)")
+        ;
+
+        generic_options.add(ControllerOptions().description());
+
+        po::options_description cmdline_options;
+        cmdline_options.add(generic_options).add(hidden_options);
+
+        po::positional_options_description positional_options;
+        positional_options.add("input", -1);
+
+        po::variables_map arguments;
+        po::store(po::command_line_parser(argc, argv).
+                options(cmdline_options).
+                positional(positional_options).
+                run(),
+                arguments);
+        po::notify(arguments);
+
+        // Use options
+        //
+        if (arguments.count("help"))
+            cout << generic_options << endl;
+        else if (!arguments.count("input"))
+            cout << "Input file(s) are not specified" << endl;
+        else
+        {
+            ControllerPtr controller(new ThreadController());
+
+            const vector<string> &inputs = arguments["input"].as<vector<string> >();
+            for(vector<string>::const_iterator input = inputs.begin();
+                    inputs.end() != input;
+                    ++input)
+            {
+                controller->push(*input);
+            }
+
+            ControllerOptions().apply(arguments, *controller);
+
+            run(controller, argv);
+        }
     }
     catch(...)
     {
@@ -81,17 +135,14 @@ try
     cout << *analyzer << endl;
 
     {
-        typedef bsm::stat::TH1Ptr TH1Ptr;
-
         int empty_argc = 1;
         char *empty_argv[] = { argv[0] };
 
         boost::shared_ptr<TRint>
             app(new TRint("app", &empty_argc, empty_argv));
 
-        TH1Ptr mttbar = convert(*analyzer->mttbar());
-        mttbar->GetXaxis()->SetTitle("m_{t#bar{t}} [GeV/c^{2}]");
-        mttbar->Draw();
+        AnalyzerOutput output;
+        output.draw(*analyzer);
 
         app->Run();
     }
@@ -0,0 +1,159 @@
+// Benchmark helpers
+//
+// Timing and report of the test programs. Timer measures the wall clock
+// time. Report prints one line per measurement: columns are added one
+// after another and line is ended when Report goes out of scope. Stream
+// format is restored at the same time:
+//
+//  Timer timer;
+//  ...
+//  Report("Reader").count("events", events)
+//      .time(timer.elapsed())
+//      .rate(events, "events")
+//      .bandwidth(bytes);
+//
+// Tests are built from a single source: helpers are defined in the header
+//
+// Copyright 2011, All rights reserved
+
+#ifndef BSM_TEST_BENCHMARK
+#define BSM_TEST_BENCHMARK
+
+#include <stdint.h>
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+namespace bsm
+{
+    namespace test
+    {
+        inline double seconds(const boost::posix_time::time_duration &time)
+        {
+            return time.total_microseconds() / 1e6;
+        }
+
+        class Timer
+        {
+            public:
+                Timer():
+                    _start(now())
+                {
+                }
+
+                void restart()
+                {
+                    _start = now();
+                }
+
+                boost::posix_time::time_duration elapsed() const
+                {
+                    return now() - _start;
+                }
+
+            private:
+                static boost::posix_time::ptime now()
+                {
+                    return boost::posix_time::microsec_clock::universal_time();
+                }
+
+                boost::posix_time::ptime _start;
+        };
+
+        class Report
+        {
+            public:
+                Report(const std::string &name,
+                        const int &width = 10,
+                        std::ostream &out = std::cout):
+                    _out(out),
+                    _flags(out.flags()),
+                    _precision(out.precision()),
+                    _seconds(0)
+                {
+                    _out << std::setw(width) << std::left << name
+                        << std::right << std::fixed << std::setprecision(2);
+                }
+
+                ~Report()
+                {
+                    _out << std::endl;
+
+                    _out.flags(_flags);
+                    _out.precision(_precision);
+                }
+
+                template<class T>
+                    Report &count(const std::string &label,
+                            const T &value,
+                            const int &width = 10)
+                {
+                    _out << "  " << label << ": " << std::setw(width)
+                        << value;
+
+                    return *this;
+                }
+
+                // Wall time in seconds: rates are measured against it
+                //
+                Report &time(const boost::posix_time::time_duration &time)
+                {
+                    _seconds = seconds(time);
+
+                    _out << "  time: " << std::setw(8)
+                        << std::setprecision(3) << _seconds << " s"
+                        << std::setprecision(2);
+
+                    return *this;
+                }
+
+                Report &microseconds(const std::string &label,
+                        const boost::posix_time::time_duration &time,
+                        const int &width = 10)
+                {
+                    _out << "  " << label << ": " << std::setw(width)
+                        << time.total_microseconds() << " us";
+
+                    return *this;
+                }
+
+                // Units per second of the reported time
+                //
+                Report &rate(const double &value, const std::string &unit)
+                {
+                    _out << "  rate: " << std::setw(12)
+                        << std::setprecision(0)
+                        << (_seconds ? value / _seconds : 0) << " " << unit
+                        << "/s" << std::setprecision(2);
+
+                    return *this;
+                }
+
+                Report &bandwidth(const double &bytes)
+                {
+                    _out << "  " << std::setw(8) << std::setprecision(1)
+                        << (_seconds ? bytes / _seconds / 1024 / 1024 : 0)
+                        << " MB/s" << std::setprecision(2);
+
+                    return *this;
+                }
+
+            private:
+                // Prevent copying
+                //
+                Report(const Report &);
+                Report &operator =(const Report &);
+
+                std::ostream &_out;
+                std::ios_base::fmtflags _flags;
+                std::streamsize _precision;
+
+                double _seconds;
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,401 @@
+// Benchmark Batch Selector
+//
+// Select jets, electrons and muons of the input files one object at a
+// time with the JetSelector, ElectronSelector and MuonSelector, and all
+// objects of the event at once with the static selectors batches. Compare
+// selection rates and check that both pass the same objects and print the
+// same cutflow. Batches of the columnar cache are checked as well. Events
+// are read into memory first to measure the selection and not the reading.
+//
+// Copyright 2011, All rights reserved
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "bsm_input/interface/Electron.pb.h"
+#include "bsm_input/interface/Event.pb.h"
+#include "bsm_input/interface/Jet.pb.h"
+#include "bsm_input/interface/Muon.pb.h"
+#include "bsm_input/interface/PrimaryVertex.pb.h"
+#include "bsm_input/interface/Reader.h"
+#include "interface/EventColumns.h"
+#include "interface/SelectionBatch.h"
+#include "interface/Selector.h"
+#include "interface/StaticSelector.h"
+#include "test/interface/Benchmark.h"
+
+using namespace std;
+
+using boost::lexical_cast;
+using boost::shared_ptr;
+
+using bsm::Electron;
+using bsm::ElectronSelector;
+using bsm::Event;
+using bsm::EventColumns;
+using bsm::EventView;
+using bsm::Jet;
+using bsm::JetSelector;
+using bsm::LockSelectorEventCounterOnUpdate;
+using bsm::Muon;
+using bsm::MuonSelector;
+using bsm::PrimaryVertex;
+using bsm::PrimaryVertexView;
+using bsm::Reader;
+using bsm::SelectionBatch;
+using bsm::StaticElectronSelector;
+using bsm::StaticJetSelector;
+using bsm::StaticMuonSelector;
+using bsm::test::Report;
+using bsm::test::Timer;
+
+typedef vector<string> Files;
+typedef vector<shared_ptr<Event> > Events;
+typedef vector<bool> Decisions;
+
+struct Statistics
+{
+    Statistics():
+        objects(0),
+        passed(0)
+    {
+    }
+
+    uint64_t objects;
+    uint64_t passed;
+    Decisions decisions;
+    boost::posix_time::time_duration time;
+};
+
+void load(const Files &files, Events &events)
+{
+    for(Files::const_iterator file = files.begin();
+            files.end() != file;
+            ++file)
+    {
+        Reader reader(*file);
+        reader.open();
+        if (!reader.isOpen())
+        {
+            cerr << "Failed to open: " << *file << endl;
+
+            continue;
+        }
+
+        for(shared_ptr<Event> event(new Event());
+                reader.read(event);
+                event.reset(new Event()))
+        {
+            if (!event->primary_vertices().size())
+                continue;
+
+            events.push_back(event);
+        }
+    }
+}
+
+// Object collections of the event
+//
+const ::google::protobuf::RepeatedPtrField<Jet> &objects(const Event &event,
+        const Jet *)
+{
+    return event.jets();
+}
+
+const ::google::protobuf::RepeatedPtrField<Electron> &objects(
+        const Event &event,
+        const Electron *)
+{
+    return event.pf_electrons();
+}
+
+const ::google::protobuf::RepeatedPtrField<Muon> &objects(const Event &event,
+        const Muon *)
+{
+    return event.pf_muons();
+}
+
+// One object at a time
+//
+bool select(JetSelector &selector, const Jet &jet, const PrimaryVertex &)
+{
+    return selector.apply(jet);
+}
+
+template<class Selector, class Object>
+    bool select(Selector &selector,
+            const Object &object,
+            const PrimaryVertex &pv)
+{
+    return selector.apply(object, pv);
+}
+
+// All objects of the event at once
+//
+void select(StaticJetSelector &selector,
+        const ::google::protobuf::RepeatedPtrField<Jet> &jets,
+        const PrimaryVertex &,
+        SelectionBatch &batch)
+{
+    selector.apply(jets, batch);
+}
+
+template<class Selector, class Objects>
+    void select(Selector &selector,
+            const Objects &objects,
+            const PrimaryVertex &pv,
+            SelectionBatch &batch)
+{
+    selector.apply(objects, pv, batch);
+}
+
+// All objects of the event in the columnar cache at once
+//
+void select(StaticJetSelector &selector,
+        const EventView &event,
+        SelectionBatch &batch)
+{
+    selector.apply(event, batch);
+}
+
+template<class Selector>
+    void select(Selector &selector,
+            const EventView &event,
+            SelectionBatch &batch)
+{
+    selector.apply(event, event.primaryVertex(0), batch);
+}
+
+// Decisions are kept for the first pass only
+//
+template<class Object, class Selector>
+    Statistics benchmark(const Events &events,
+            const uint32_t &repeat,
+            Selector &selector)
+{
+    typedef ::google::protobuf::RepeatedPtrField<Object> Objects;
+
+    Statistics statistics;
+
+    const Timer timer;
+    for(uint32_t pass = 0; repeat > pass; ++pass)
+    {
+        for(Events::const_iterator event = events.begin();
+                events.end() != event;
+                ++event)
+        {
+            const PrimaryVertex &pv = (*event)->primary_vertices().Get(0);
+            const Objects &collection =
+                objects(**event, static_cast<const Object *>(0));
+
+            LockSelectorEventCounterOnUpdate lock(selector);
+            for(typename Objects::const_iterator object = collection.begin();
+                    collection.end() != object;
+                    ++object)
+            {
+                const bool is_passed = select(selector, *object, pv);
+
+                ++statistics.objects;
+                if (is_passed)
+                    ++statistics.passed;
+
+                if (!pass)
+                    statistics.decisions.push_back(is_passed);
+            }
+        }
+    }
+    statistics.time = timer.elapsed();
+
+    return statistics;
+}
+
+template<class Object, class Selector>
+    Statistics batchBenchmark(const Events &events,
+            const uint32_t &repeat,
+            Selector &selector)
+{
+    Statistics statistics;
+
+    SelectionBatch batch;
+
+    const Timer timer;
+    for(uint32_t pass = 0; repeat > pass; ++pass)
+    {
+        for(Events::const_iterator event = events.begin();
+                events.end() != event;
+                ++event)
+        {
+            {
+                LockSelectorEventCounterOnUpdate lock(selector);
+                select(selector,
+                        objects(**event, static_cast<const Object *>(0)),
+                        (*event)->primary_vertices().Get(0),
+                        batch);
+            }
+
+            statistics.objects += batch.size();
+            statistics.passed += batch.passed();
+
+            if (pass)
+                continue;
+
+            for(uint32_t object = 0; batch.size() > object; ++object)
+            {
+                statistics.decisions.push_back(batch.isPass(object));
+            }
+        }
+    }
+    statistics.time = timer.elapsed();
+
+    return statistics;
+}
+
+template<class Selector>
+    Decisions columnarDecisions(const EventColumns &columns)
+{
+    Selector selector;
+    SelectionBatch batch;
+
+    Decisions decisions;
+    for(uint32_t event = 0; columns.size() > event; ++event)
+    {
+        LockSelectorEventCounterOnUpdate lock(selector);
+        select(selector, EventView(columns, event), batch);
+
+        for(uint32_t object = 0; batch.size() > object; ++object)
+        {
+            decisions.push_back(batch.isPass(object));
+        }
+    }
+
+    return decisions;
+}
+
+template<class T>
+    string cutflow(const T &selector)
+{
+    ostringstream out;
+    out << selector;
+
+    return out.str();
+}
+
+void report(const string &name, const Statistics &statistics)
+{
+    Report(name).count("objects", statistics.objects)
+        .count("passed", statistics.passed)
+        .time(statistics.time)
+        .rate(statistics.objects, "objects");
+}
+
+// Run both selectors and compare results
+//
+template<class Object, class Selector, class StaticSelector>
+    bool compare(const string &name,
+            const Events &events,
+            const EventColumns &columns,
+            const uint32_t &repeat)
+{
+    Selector selector;
+    StaticSelector static_selector;
+
+    const Statistics statistics =
+        benchmark<Object>(events, repeat, selector);
+    const Statistics batch_statistics =
+        batchBenchmark<Object>(events, repeat, static_selector);
+
+    report(name, statistics);
+    report("Batch", batch_statistics);
+
+    cout << endl;
+
+    bool result = true;
+    if (statistics.objects != batch_statistics.objects
+            || statistics.decisions != batch_statistics.decisions)
+    {
+        cerr << name << " decisions mismatch" << endl;
+
+        result = false;
+    }
+
+    if (statistics.decisions != columnarDecisions<StaticSelector>(columns))
+    {
+        cerr << name << " columnar decisions mismatch" << endl;
+
+        result = false;
+    }
+
+    if (cutflow(selector) != cutflow(static_selector))
+    {
+        cerr << name << " cutflow mismatch" << endl;
+
+        result = false;
+    }
+
+    return result;
+}
+
+int main(int argc, char *argv[])
+try
+{
+    if (3 > argc)
+    {
+        cerr << "Usage: " << argv[0] << " repeat input.pb [input.pb ...]"
+            << endl;
+        cerr << endl;
+
+        return 0;
+    }
+
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    int result = 0;
+    {
+        const uint32_t repeat = lexical_cast<uint32_t>(argv[1]);
+        const Files files(argv + 2, argv + argc);
+
+        Events events;
+        load(files, events);
+
+        EventColumns columns;
+        for(Events::const_iterator event = events.begin();
+                events.end() != event;
+                ++event)
+        {
+            columns.add(**event);
+        }
+
+        if (!compare<Jet, JetSelector, StaticJetSelector>("Jets",
+                    events, columns, repeat))
+            result = 1;
+
+        if (!compare<Electron, ElectronSelector, StaticElectronSelector>(
+                    "Electrons", events, columns, repeat))
+            result = 1;
+
+        if (!compare<Muon, MuonSelector, StaticMuonSelector>("Muons",
+                    events, columns, repeat))
+            result = 1;
+    }
+
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    return result;
+}
+catch(...)
+{
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    cerr << "Unknown error" << endl;
+
+    return 1;
+}
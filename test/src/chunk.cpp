@@ -0,0 +1,123 @@
+// Test Input Chunks
+//
+// Index input files, read them in chunks and compare number of events with
+// the ones read by the regular Reader
+//
+// Created by Samvel Khalatyan, Jul 28, 2011
+// Copyright 2011, All rights reserved
+
+#include <iostream>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "bsm_input/interface/Reader.h"
+#include "interface/RecordIndex.h"
+#include "interface/RecordReader.h"
+
+using namespace std;
+
+using boost::lexical_cast;
+using boost::shared_ptr;
+
+using bsm::Event;
+using bsm::Reader;
+using bsm::RecordIndex;
+using bsm::RecordReader;
+
+int main(int argc, char *argv[])
+try
+{
+    if (3 > argc)
+    {
+        cerr << "Usage: " << argv[0] << " events_per_chunk input.pb" << endl;
+        cerr << endl;
+
+        return 0;
+    }
+
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    const uint32_t events_per_chunk = lexical_cast<uint32_t>(argv[1]);
+
+    int result = 0;
+    for(int i = 2; argc > i; ++i)
+    {
+        uint32_t events_read = 0;
+        {
+            shared_ptr<Reader> reader(new Reader(argv[i]));
+            reader->open();
+            if (!reader->isOpen())
+                continue;
+
+            for(shared_ptr<Event> event(new Event());
+                    reader->read(event);
+                    event->Clear())
+            {
+                ++events_read;
+            }
+        }
+
+        RecordIndex index(argv[i]);
+        if (!index.build())
+        {
+            cerr << "failed to index: " << argv[i] << endl;
+
+            result = 1;
+
+            continue;
+        }
+
+        uint32_t chunks = 0;
+        uint32_t chunk_events_read = 0;
+        for(uint32_t record = 0;
+                index.size() > record;
+                record += events_per_chunk, ++chunks)
+        {
+            RecordReader reader(argv[i]);
+            reader.open();
+            if (!reader.isOpen()
+                    || !reader.seek(index.offset(record),
+                        index.offset(record + events_per_chunk)))
+                continue;
+
+            for(shared_ptr<Event> event(new Event());
+                    reader.read(event);
+                    event->Clear())
+            {
+                ++chunk_events_read;
+            }
+        }
+
+        cout << argv[i] << endl;
+        cout << "    Reader: " << events_read << " events" << endl;
+        cout << "     Index: " << index.size() << " records" << endl;
+        cout << "    Chunks: " << chunk_events_read << " events in "
+            << chunks << " chunk(s)" << endl;
+
+        if (events_read != index.size()
+                || events_read != chunk_events_read)
+        {
+            cerr << "events mismatch" << endl;
+
+            result = 1;
+        }
+    }
+
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    return result;
+}
+catch(...)
+{
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    cerr << "Unknown error" << endl;
+
+    return 1;
+}
@@ -0,0 +1,307 @@
+// Test Columnar Cache
+//
+// Convert inputs into the columnar cache, apply selectors to the Event
+// objects and to the cached columns, and compare the number of selected
+// objects and the selection time
+//
+// Copyright 2011, All rights reserved
+
+#include <iostream>
+
+#include <boost/shared_ptr.hpp>
+
+#include "bsm_input/interface/Electron.pb.h"
+#include "bsm_input/interface/Event.pb.h"
+#include "bsm_input/interface/Jet.pb.h"
+#include "bsm_input/interface/Muon.pb.h"
+#include "bsm_input/interface/PrimaryVertex.pb.h"
+#include "bsm_input/interface/Reader.h"
+#include "interface/ColumnarFile.h"
+#include "interface/EventColumns.h"
+#include "interface/Selector.h"
+#include "test/interface/Benchmark.h"
+
+using namespace std;
+
+using boost::shared_ptr;
+
+using bsm::ColumnarReader;
+using bsm::ColumnarWriter;
+using bsm::ElectronSelector;
+using bsm::Event;
+using bsm::EventColumns;
+using bsm::EventView;
+using bsm::JetSelector;
+using bsm::MuonSelector;
+using bsm::PrimaryVertexSelector;
+using bsm::Reader;
+using bsm::test::Report;
+using bsm::test::Timer;
+
+struct Selected
+{
+    Selected():
+        events(0),
+        primary_vertices(0),
+        jets(0),
+        electrons(0),
+        muons(0)
+    {
+    }
+
+    bool operator ==(const Selected &selected) const
+    {
+        return events == selected.events
+            && primary_vertices == selected.primary_vertices
+            && jets == selected.jets
+            && electrons == selected.electrons
+            && muons == selected.muons;
+    }
+
+    uint32_t events;
+    uint32_t primary_vertices;
+    uint32_t jets;
+    uint32_t electrons;
+    uint32_t muons;
+};
+
+class Selectors
+{
+    public:
+        Selectors():
+            _primary_vertex(new PrimaryVertexSelector()),
+            _jet(new JetSelector()),
+            _electron(new ElectronSelector()),
+            _muon(new MuonSelector())
+        {
+        }
+
+        void apply(const Event &event)
+        {
+            ++_selected.events;
+
+            typedef ::google::protobuf::RepeatedPtrField<bsm::PrimaryVertex>
+                PrimaryVertices;
+            typedef ::google::protobuf::RepeatedPtrField<bsm::Jet> Jets;
+            typedef ::google::protobuf::RepeatedPtrField<bsm::Electron>
+                Electrons;
+            typedef ::google::protobuf::RepeatedPtrField<bsm::Muon> Muons;
+
+            for(PrimaryVertices::const_iterator pv =
+                        event.primary_vertices().begin();
+                    event.primary_vertices().end() != pv;
+                    ++pv)
+            {
+                if (_primary_vertex->apply(*pv))
+                    ++_selected.primary_vertices;
+            }
+
+            for(Jets::const_iterator jet = event.jets().begin();
+                    event.jets().end() != jet;
+                    ++jet)
+            {
+                if (_jet->apply(*jet))
+                    ++_selected.jets;
+            }
+
+            if (!event.primary_vertices().size())
+                return;
+
+            const bsm::PrimaryVertex &pv = *event.primary_vertices().begin();
+
+            for(Electrons::const_iterator electron =
+                        event.pf_electrons().begin();
+                    event.pf_electrons().end() != electron;
+                    ++electron)
+            {
+                if (_electron->apply(*electron, pv))
+                    ++_selected.electrons;
+            }
+
+            for(Muons::const_iterator muon = event.pf_muons().begin();
+                    event.pf_muons().end() != muon;
+                    ++muon)
+            {
+                if (_muon->apply(*muon, pv))
+                    ++_selected.muons;
+            }
+        }
+
+        void apply(const EventView &event)
+        {
+            ++_selected.events;
+
+            for(uint32_t pv = 0; event.primaryVertices() > pv; ++pv)
+            {
+                if (_primary_vertex->apply(event.primaryVertex(pv)))
+                    ++_selected.primary_vertices;
+            }
+
+            for(uint32_t jet = 0; event.jets() > jet; ++jet)
+            {
+                if (_jet->apply(event.jet(jet)))
+                    ++_selected.jets;
+            }
+
+            if (!event.primaryVertices())
+                return;
+
+            const bsm::PrimaryVertexView pv = event.primaryVertex(0);
+
+            for(uint32_t electron = 0; event.electrons() > electron; ++electron)
+            {
+                if (_electron->apply(event.electron(electron), pv))
+                    ++_selected.electrons;
+            }
+
+            for(uint32_t muon = 0; event.muons() > muon; ++muon)
+            {
+                if (_muon->apply(event.muon(muon), pv))
+                    ++_selected.muons;
+            }
+        }
+
+        const Selected &selected() const
+        {
+            return _selected;
+        }
+
+    private:
+        shared_ptr<PrimaryVertexSelector> _primary_vertex;
+        shared_ptr<JetSelector> _jet;
+        shared_ptr<ElectronSelector> _electron;
+        shared_ptr<MuonSelector> _muon;
+
+        Selected _selected;
+};
+
+void report(const string &name,
+        const boost::posix_time::time_duration &time,
+        const Selected &selected)
+{
+    Report(name).count("events", selected.events, 8)
+        .count("pv", selected.primary_vertices, 8)
+        .count("jets", selected.jets, 8)
+        .count("el", selected.electrons, 6)
+        .count("mu", selected.muons, 6)
+        .time(time);
+}
+
+int main(int argc, char *argv[])
+try
+{
+    if (2 > argc)
+    {
+        cerr << "Usage: " << argv[0] << " input.pb" << endl;
+        cerr << endl;
+
+        return 0;
+    }
+
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    const string cache = "columnar_test.col";
+
+    {
+        ColumnarWriter writer(cache);
+        writer.open();
+        if (!writer.isOpen())
+        {
+            cerr << "failed to open cache: " << cache << endl;
+
+            return 1;
+        }
+
+        for(int i = 1; argc > i; ++i)
+        {
+            shared_ptr<Reader> reader(new Reader(argv[i]));
+            reader->open();
+            if (!reader->isOpen())
+                continue;
+
+            for(shared_ptr<Event> event(new Event());
+                    reader->read(event);
+                    event->Clear())
+            {
+                writer.write(*event);
+            }
+        }
+
+        if (!writer.close())
+        {
+            cerr << "failed to write cache: " << cache << endl;
+
+            return 1;
+        }
+    }
+
+    // Both selections include reading of the inputs
+    //
+    Selectors event_selectors;
+    boost::posix_time::time_duration event_time;
+    {
+        const Timer timer;
+        for(int i = 1; argc > i; ++i)
+        {
+            shared_ptr<Reader> reader(new Reader(argv[i]));
+            reader->open();
+            if (!reader->isOpen())
+                continue;
+
+            for(shared_ptr<Event> event(new Event());
+                    reader->read(event);
+                    event->Clear())
+            {
+                event_selectors.apply(*event);
+            }
+        }
+        event_time = timer.elapsed();
+    }
+
+    Selectors column_selectors;
+    boost::posix_time::time_duration column_time;
+    {
+        ColumnarReader reader(cache);
+        reader.open();
+        if (!reader.isOpen())
+        {
+            cerr << "failed to read cache: " << cache << endl;
+
+            return 1;
+        }
+
+        const Timer timer;
+        for(EventColumns columns; reader.read(columns); )
+        {
+            for(uint32_t event = 0; columns.size() > event; ++event)
+                column_selectors.apply(EventView(columns, event));
+        }
+        column_time = timer.elapsed();
+    }
+
+    report("Event", event_time, event_selectors.selected());
+    report("Columns", column_time, column_selectors.selected());
+
+    if (!(event_selectors.selected() == column_selectors.selected()))
+    {
+        cerr << "selected objects mismatch" << endl;
+
+        return 1;
+    }
+
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    return 0;
+}
+catch(...)
+{
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    cerr << "Unknown error" << endl;
+
+    return 1;
+}
@@ -0,0 +1,147 @@
+// Test Dataset Manifest
+//
+// Build manifest of the input files, compare event counts and run ranges
+// with the ones read by the Reader, save and load manifest back and check
+// that update of the unchanged list does not scan any file.
+//
+// Copyright 2011, All rights reserved
+
+#include <stdio.h>
+
+#include <iostream>
+
+#include <boost/shared_ptr.hpp>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "bsm_input/interface/Reader.h"
+#include "interface/DatasetManifest.h"
+
+using namespace std;
+
+using boost::shared_ptr;
+
+using bsm::DatasetManifest;
+using bsm::Event;
+using bsm::Reader;
+
+int main(int argc, char *argv[])
+try
+{
+    if (2 > argc)
+    {
+        cerr << "Usage: " << argv[0] << " input.pb [input.pb ...]" << endl;
+        cerr << endl;
+
+        return 0;
+    }
+
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    const DatasetManifest::Files files(argv + 1, argv + argc);
+    const string filename = "dataset_manifest_test.manifest";
+
+    int result = 0;
+    {
+        DatasetManifest manifest(filename);
+        const uint32_t scanned = manifest.update(files, 4);
+
+        cout << "Scanned: " << scanned << " files" << endl;
+
+        if (!manifest.save())
+        {
+            cerr << "failed to save manifest" << endl;
+
+            result = 1;
+        }
+    }
+
+    DatasetManifest manifest(filename);
+    if (!manifest.load())
+    {
+        cerr << "failed to load manifest" << endl;
+
+        result = 1;
+    }
+
+    for(DatasetManifest::Files::const_iterator file = files.begin();
+            files.end() != file;
+            ++file)
+    {
+        shared_ptr<Reader> reader(new Reader(*file));
+        reader->open();
+        if (!reader->isOpen())
+            continue;
+
+        uint32_t events = 0;
+        uint32_t first_run = 0;
+        uint32_t last_run = 0;
+        for(shared_ptr<Event> event(new Event());
+                reader->read(event);
+                event->Clear())
+        {
+            const uint32_t run = event->extra().run();
+
+            if (!events
+                    || run < first_run)
+                first_run = run;
+
+            if (!events
+                    || run > last_run)
+                last_run = run;
+
+            ++events;
+        }
+
+        DatasetManifest::Entry entry;
+        if (!manifest.find(*file, entry))
+        {
+            cerr << "file is not in manifest: " << *file << endl;
+
+            result = 1;
+
+            continue;
+        }
+
+        cout << *file << endl;
+        cout << "    Reader: " << events << " events, runs "
+            << first_run << " - " << last_run << endl;
+        cout << "  Manifest: " << entry.events << " events, runs "
+            << entry.first_run << " - " << entry.last_run << endl;
+
+        if (events != entry.events
+                || first_run != entry.first_run
+                || last_run != entry.last_run)
+        {
+            cerr << "manifest mismatch" << endl;
+
+            result = 1;
+        }
+    }
+
+    // Nothing has changed: all entries are reused
+    //
+    if (manifest.update(files, 4))
+    {
+        cerr << "unchanged files are scanned again" << endl;
+
+        result = 1;
+    }
+
+    remove(filename.c_str());
+
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    return result;
+}
+catch(...)
+{
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    cerr << "Unknown error" << endl;
+
+    return 1;
+}
@@ -0,0 +1,171 @@
+// Benchmark Event Fields
+//
+// Read all events of the input files parsing all fields, triggers only
+// and event extra only. Compare read rates and check that used fields are
+// the same as the ones parsed with all fields. Records are parsed from the
+// mapped memory and straight from the file stream. Files should be in the
+// page cache (read them once before) to compare parsing and not the disk.
+//
+// Copyright 2011, All rights reserved
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "bsm_input/interface/Trigger.pb.h"
+#include "interface/EventFields.h"
+#include "interface/MappedReader.h"
+#include "interface/RecordReader.h"
+#include "test/interface/Benchmark.h"
+
+using namespace std;
+
+using boost::lexical_cast;
+using boost::shared_ptr;
+
+using bsm::Event;
+using bsm::EventFields;
+using bsm::MappedReader;
+using bsm::RecordReader;
+using bsm::test::Report;
+using bsm::test::Timer;
+
+typedef vector<string> Files;
+
+struct Statistics
+{
+    Statistics():
+        events(0),
+        hlts(0),
+        ids(0)
+    {
+    }
+
+    uint64_t events;
+    uint64_t hlts;
+    uint64_t ids;
+    boost::posix_time::time_duration time;
+};
+
+template<class Reader>
+    Statistics benchmark(const Files &files,
+            const uint32_t &repeat,
+            const EventFields &fields)
+{
+    Statistics statistics;
+
+    const Timer timer;
+    for(uint32_t pass = 0; repeat > pass; ++pass)
+    {
+        for(Files::const_iterator file = files.begin();
+                files.end() != file;
+                ++file)
+        {
+            Reader reader(*file);
+            reader.open();
+            if (!reader.isOpen())
+                continue;
+
+            reader.use(fields);
+
+            for(shared_ptr<Event> event(new Event());
+                    reader.read(event);
+                    event->Clear())
+            {
+                ++statistics.events;
+
+                statistics.hlts += event->hlts().size();
+                statistics.ids += event->extra().id();
+            }
+        }
+    }
+    statistics.time = timer.elapsed();
+
+    return statistics;
+}
+
+void report(const string &name, const Statistics &statistics)
+{
+    Report(name).count("events", statistics.events)
+        .count("hlts", statistics.hlts)
+        .time(statistics.time)
+        .rate(statistics.events, "events");
+}
+
+int main(int argc, char *argv[])
+try
+{
+    if (3 > argc)
+    {
+        cerr << "Usage: " << argv[0] << " repeat input.pb [input.pb ...]"
+            << endl;
+        cerr << endl;
+
+        return 0;
+    }
+
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    const uint32_t repeat = lexical_cast<uint32_t>(argv[1]);
+    const Files files(argv + 2, argv + argc);
+
+    EventFields hlts = EventFields::none();
+    hlts.add(Event::kHltsFieldNumber);
+
+    EventFields extra = EventFields::none();
+    extra.add(Event::kExtraFieldNumber);
+
+    // Warm up the page cache
+    //
+    benchmark<MappedReader>(files, 1, EventFields());
+
+    const Statistics all_statistics =
+        benchmark<MappedReader>(files, repeat, EventFields());
+    const Statistics hlts_statistics =
+        benchmark<MappedReader>(files, repeat, hlts);
+    const Statistics extra_statistics =
+        benchmark<MappedReader>(files, repeat, extra);
+    const Statistics stream_statistics =
+        benchmark<RecordReader>(files, repeat, hlts);
+
+    report("All", all_statistics);
+    report("Triggers", hlts_statistics);
+    report("Extra", extra_statistics);
+    report("Stream", stream_statistics);
+
+    int result = 0;
+    if (all_statistics.events != hlts_statistics.events
+            || all_statistics.events != extra_statistics.events
+            || all_statistics.hlts != hlts_statistics.hlts
+            || hlts_statistics.ids
+            || all_statistics.ids != extra_statistics.ids
+            || extra_statistics.hlts
+            || hlts_statistics.events != stream_statistics.events
+            || hlts_statistics.hlts != stream_statistics.hlts
+            || stream_statistics.ids)
+    {
+        cerr << "fields mismatch" << endl;
+
+        result = 1;
+    }
+
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    return result;
+}
+catch(...)
+{
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    cerr << "Unknown error" << endl;
+
+    return 1;
+}
@@ -0,0 +1,123 @@
+// Test Event Index
+//
+// Index input files, look up every event read by the regular Reader and
+// read it back at the indexed offset
+//
+// Copyright 2011, All rights reserved
+
+#include <iostream>
+
+#include <boost/shared_ptr.hpp>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "bsm_input/interface/Reader.h"
+#include "interface/EventIndex.h"
+#include "interface/RecordReader.h"
+
+using namespace std;
+
+using boost::shared_ptr;
+
+using bsm::Event;
+using bsm::EventIndex;
+using bsm::Reader;
+using bsm::RecordReader;
+
+int main(int argc, char *argv[])
+try
+{
+    if (2 > argc)
+    {
+        cerr << "Usage: " << argv[0] << " input.pb" << endl;
+        cerr << endl;
+
+        return 0;
+    }
+
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    int result = 0;
+    for(int i = 1; argc > i; ++i)
+    {
+        EventIndex index(argv[i]);
+        if (!index.build())
+        {
+            cerr << "failed to index: " << argv[i] << endl;
+
+            result = 1;
+
+            continue;
+        }
+
+        RecordReader record_reader(argv[i]);
+        record_reader.open();
+        if (!record_reader.isOpen())
+            continue;
+
+        shared_ptr<Reader> reader(new Reader(argv[i]));
+        reader->open();
+        if (!reader->isOpen())
+            continue;
+
+        uint32_t events_read = 0;
+        uint32_t events_found = 0;
+        for(shared_ptr<Event> event(new Event()), found(new Event());
+                reader->read(event);
+                event->Clear())
+        {
+            ++events_read;
+
+            EventIndex::Offsets offsets;
+            index.find(event->extra().id(),
+                    event->extra().lumi(),
+                    event->extra().run(),
+                    offsets);
+
+            for(EventIndex::Offsets::const_iterator offset = offsets.begin();
+                    offsets.end() != offset;
+                    ++offset)
+            {
+                found->Clear();
+
+                if (record_reader.seek(*offset)
+                        && record_reader.read(found)
+                        && found->SerializeAsString() ==
+                            event->SerializeAsString())
+                {
+                    ++events_found;
+
+                    break;
+                }
+            }
+        }
+
+        cout << argv[i] << endl;
+        cout << "    Reader: " << events_read << " events" << endl;
+        cout << "     Index: " << index.size() << " events" << endl;
+        cout << "     Found: " << events_found << " events" << endl;
+
+        if (events_read != index.size()
+                || events_read != events_found)
+        {
+            cerr << "events mismatch" << endl;
+
+            result = 1;
+        }
+    }
+
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    return result;
+}
+catch(...)
+{
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    cerr << "Unknown error" << endl;
+
+    return 1;
+}
@@ -0,0 +1,205 @@
+// Test Event Recycler
+//
+// Decode all events of the input files with a new Event per record, with
+// the cleared Event reused and with the EventRecycler. Count memory
+// allocations done by each of them and check that decoded events are
+// the same.
+//
+// Copyright 2011, All rights reserved
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "interface/EventRecycler.h"
+#include "interface/RecordReader.h"
+#include "test/interface/Benchmark.h"
+
+using namespace std;
+
+using boost::lexical_cast;
+using boost::shared_ptr;
+
+using bsm::Event;
+using bsm::EventRecycler;
+using bsm::RecordReader;
+using bsm::test::Report;
+using bsm::test::Timer;
+
+typedef vector<string> Files;
+
+// Count every allocation done by the program
+//
+static uint64_t allocations = 0;
+
+void *operator new(size_t size)
+{
+    ++allocations;
+
+    void *memory = malloc(size ? size : 1);
+    if (!memory)
+        throw std::bad_alloc();
+
+    return memory;
+}
+
+void operator delete(void *memory)
+{
+    free(memory);
+}
+
+enum Mode
+{
+    NEW_EVENT = 0,
+    CLEAR_EVENT,
+    RECYCLER
+};
+
+struct Statistics
+{
+    Statistics():
+        events(0),
+        ids(0),
+        allocations(0),
+        resets(0)
+    {
+    }
+
+    uint64_t events;
+    uint64_t ids;
+    uint64_t allocations;
+    uint32_t resets;
+    boost::posix_time::time_duration time;
+};
+
+Statistics benchmark(const Files &files,
+        const Mode &mode,
+        const uint32_t &reset_events)
+{
+    Statistics statistics;
+
+    EventRecycler recycler(reset_events);
+
+    const uint64_t start_allocations = allocations;
+    const Timer timer;
+    for(Files::const_iterator file = files.begin();
+            files.end() != file;
+            ++file)
+    {
+        RecordReader reader(*file);
+        reader.open();
+        if (!reader.isOpen())
+            continue;
+
+        shared_ptr<Event> event(new Event());
+        for(;;)
+        {
+            if (NEW_EVENT == mode)
+                event.reset(new Event());
+
+            shared_ptr<Event> &decoded = RECYCLER == mode
+                ? recycler.event()
+                : event;
+
+            if (!reader.read(decoded))
+                break;
+
+            ++statistics.events;
+
+            statistics.ids += decoded->extra().id();
+
+            if (RECYCLER == mode)
+                recycler.recycle();
+            else if (CLEAR_EVENT == mode)
+                event->Clear();
+        }
+    }
+    statistics.time = timer.elapsed();
+    statistics.allocations = allocations - start_allocations;
+    statistics.resets = recycler.resets();
+
+    return statistics;
+}
+
+void report(const string &name, const Statistics &statistics)
+{
+    Report(name).count("events", statistics.events, 8)
+        .count("allocations", statistics.allocations)
+        .count("per event", statistics.events
+                ? 1. * statistics.allocations / statistics.events
+                : 0, 6)
+        .count("resets", statistics.resets, 6)
+        .time(statistics.time);
+}
+
+int main(int argc, char *argv[])
+try
+{
+    if (3 > argc)
+    {
+        cerr << "Usage: " << argv[0] << " reset_events input.pb [input.pb ...]"
+            << endl;
+        cerr << endl;
+
+        return 0;
+    }
+
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    const uint32_t reset_events = lexical_cast<uint32_t>(argv[1]);
+    const Files files(argv + 2, argv + argc);
+
+    // Warm up the page cache
+    //
+    benchmark(files, CLEAR_EVENT, 0);
+
+    const Statistics new_statistics = benchmark(files, NEW_EVENT, 0);
+    const Statistics clear_statistics = benchmark(files, CLEAR_EVENT, 0);
+    const Statistics arena_statistics =
+        benchmark(files, RECYCLER, reset_events);
+
+    report("New", new_statistics);
+    report("Clear", clear_statistics);
+    report("Recycler", arena_statistics);
+
+    int result = 0;
+    if (new_statistics.events != clear_statistics.events
+            || new_statistics.events != arena_statistics.events
+            || new_statistics.ids != clear_statistics.ids
+            || new_statistics.ids != arena_statistics.ids)
+    {
+        cerr << "events mismatch" << endl;
+
+        result = 1;
+    }
+
+    if (new_statistics.events
+            && arena_statistics.allocations >= new_statistics.allocations)
+    {
+        cerr << "recycler does not reduce allocations" << endl;
+
+        result = 1;
+    }
+
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    return result;
+}
+catch(...)
+{
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    cerr << "Unknown error" << endl;
+
+    return 1;
+}
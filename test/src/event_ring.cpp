@@ -0,0 +1,125 @@
+// Test Event Ring
+//
+// Several producers push batches of events into the small ring while
+// consumers pop them. All batches should be delivered exactly once and
+// closed ring should release all waiting threads.
+//
+// Copyright 2011, All rights reserved
+
+#include <iostream>
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread.hpp>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "interface/EventRing.h"
+
+using namespace std;
+
+using boost::lexical_cast;
+
+using bsm::Event;
+using bsm::EventBatch;
+using bsm::EventBatchPtr;
+using bsm::EventRing;
+
+void produce(EventRing *ring, const uint32_t &batches, const uint32_t &events)
+{
+    for(uint32_t batch = 0; batches > batch; ++batch)
+    {
+        EventBatchPtr new_batch(new EventBatch());
+        for(uint32_t event = 0; events > event; ++event)
+            new_batch->events.push_back(EventBatch::EventPtr(new Event()));
+
+        if (!ring->push(new_batch))
+            break;
+    }
+
+    ring->removeProducer();
+}
+
+void consume(EventRing *ring, boost::atomic<uint32_t> *events)
+{
+    for(EventBatchPtr batch; ring->pop(batch); )
+        events->fetch_add(batch->events.size());
+}
+
+int main(int argc, char *argv[])
+try
+{
+    if (5 > argc)
+    {
+        cerr << "Usage: " << argv[0]
+            << " producers consumers batches events_per_batch" << endl;
+        cerr << endl;
+
+        return 0;
+    }
+
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    const uint32_t producers = lexical_cast<uint32_t>(argv[1]);
+    const uint32_t consumers = lexical_cast<uint32_t>(argv[2]);
+    const uint32_t batches = lexical_cast<uint32_t>(argv[3]);
+    const uint32_t events = lexical_cast<uint32_t>(argv[4]);
+
+    int result = 0;
+    {
+        EventRing ring(2, producers);
+        boost::atomic<uint32_t> events_consumed(0);
+
+        boost::thread_group threads;
+        for(uint32_t producer = 0; producers > producer; ++producer)
+            threads.create_thread(boost::bind(produce,
+                        &ring, batches, events));
+
+        for(uint32_t consumer = 0; consumers > consumer; ++consumer)
+            threads.create_thread(boost::bind(consume,
+                        &ring, &events_consumed));
+
+        threads.join_all();
+
+        cout << "Consumed events: " << events_consumed
+            << " of " << producers * batches * events << endl;
+
+        if (producers * batches * events != events_consumed)
+            result = 1;
+    }
+
+    // Producers block on the full ring without consumers: close should
+    // release them
+    //
+    {
+        EventRing ring(2, producers);
+
+        boost::thread_group threads;
+        for(uint32_t producer = 0; producers > producer; ++producer)
+            threads.create_thread(boost::bind(produce,
+                        &ring, batches + 2, events));
+
+        boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+        ring.close();
+
+        threads.join_all();
+
+        cout << "Closed ring released producers" << endl;
+    }
+
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    return result;
+}
+catch(...)
+{
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    cerr << "Unknown error" << endl;
+
+    return 1;
+}
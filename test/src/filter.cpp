@@ -63,6 +63,8 @@ try
         }
     }
 
+    filter->close();
+
     cout << *filter << endl;
 
 
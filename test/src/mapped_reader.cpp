@@ -0,0 +1,164 @@
+// Benchmark Readers
+//
+// Read all events of the input files with the streaming Reader, the
+// RecordReader and the MappedReader and compare read rates. Files should
+// be in the page cache (read them once before) to compare parsing and not
+// the disk.
+//
+// Copyright 2011, All rights reserved
+
+#include <sys/stat.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "bsm_input/interface/Reader.h"
+#include "interface/MappedReader.h"
+#include "interface/RecordReader.h"
+#include "test/interface/Benchmark.h"
+
+using namespace std;
+
+using boost::lexical_cast;
+using boost::shared_ptr;
+
+using bsm::Event;
+using bsm::MappedReader;
+using bsm::Reader;
+using bsm::RecordReader;
+using bsm::test::Report;
+using bsm::test::Timer;
+
+typedef vector<string> Files;
+
+struct Statistics
+{
+    Statistics():
+        events(0),
+        bytes(0)
+    {
+    }
+
+    uint64_t events;
+    uint64_t bytes;
+    boost::posix_time::time_duration time;
+};
+
+uint64_t fileSize(const string &file_name)
+{
+    struct stat file_stat;
+    if (stat(file_name.c_str(), &file_stat))
+        return 0;
+
+    return file_stat.st_size;
+}
+
+// Reader and RecordReader/MappedReader use different pointers to read
+//
+template<class T>
+    uint64_t readEvents(T &reader)
+{
+    uint64_t events = 0;
+    for(shared_ptr<Event> event(new Event());
+            reader.read(event);
+            event->Clear())
+    {
+        ++events;
+    }
+
+    return events;
+}
+
+template<class T>
+    Statistics benchmark(const Files &files, const uint32_t &repeat)
+{
+    Statistics statistics;
+
+    const Timer timer;
+    for(uint32_t pass = 0; repeat > pass; ++pass)
+    {
+        for(Files::const_iterator file = files.begin();
+                files.end() != file;
+                ++file)
+        {
+            T reader(*file);
+            reader.open();
+            if (!reader.isOpen())
+                continue;
+
+            statistics.events += readEvents(reader);
+            statistics.bytes += fileSize(*file);
+        }
+    }
+    statistics.time = timer.elapsed();
+
+    return statistics;
+}
+
+void report(const string &name, const Statistics &statistics)
+{
+    Report(name, 14).count("events", statistics.events)
+        .time(statistics.time)
+        .rate(statistics.events, "events")
+        .bandwidth(statistics.bytes);
+}
+
+int main(int argc, char *argv[])
+try
+{
+    if (3 > argc)
+    {
+        cerr << "Usage: " << argv[0] << " repeat input.pb [input.pb ...]"
+            << endl;
+        cerr << endl;
+
+        return 0;
+    }
+
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    const uint32_t repeat = lexical_cast<uint32_t>(argv[1]);
+    const Files files(argv + 2, argv + argc);
+
+    // Warm up the page cache
+    //
+    benchmark<RecordReader>(files, 1);
+
+    const Statistics reader = benchmark<Reader>(files, repeat);
+    const Statistics record_reader = benchmark<RecordReader>(files, repeat);
+    const Statistics mapped_reader = benchmark<MappedReader>(files, repeat);
+
+    report("Reader", reader);
+    report("RecordReader", record_reader);
+    report("MappedReader", mapped_reader);
+
+    int result = 0;
+    if (reader.events != record_reader.events
+            || reader.events != mapped_reader.events)
+    {
+        cerr << "events mismatch" << endl;
+
+        result = 1;
+    }
+
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    return result;
+}
+catch(...)
+{
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    cerr << "Unknown error" << endl;
+
+    return 1;
+}
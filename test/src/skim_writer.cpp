@@ -0,0 +1,227 @@
+// Test Skim Writer
+//
+// Several producers read input files and push batches of events to the
+// writer. Output files are read back: all events should be written once
+// and files should be rolled by size. Writer keeps file per trigger menu:
+// only the last file of each menu may be smaller than the target size.
+//
+// Copyright 2011, All rights reserved
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread.hpp>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "bsm_input/interface/Input.pb.h"
+#include "interface/RecordReader.h"
+#include "interface/SkimWriter.h"
+#include "test/interface/Benchmark.h"
+
+using namespace std;
+
+using boost::lexical_cast;
+
+using bsm::Event;
+using bsm::EventBatch;
+using bsm::EventBatchPtr;
+using bsm::RecordReader;
+using bsm::SkimWriter;
+using bsm::test::Timer;
+
+typedef vector<string> Files;
+
+static const uint32_t EVENTS_PER_BATCH = 256;
+
+struct Statistics
+{
+    Statistics():
+        events(0),
+        ids(0),
+        push_time(0)
+    {
+    }
+
+    boost::atomic<uint64_t> events;
+    boost::atomic<uint64_t> ids;
+    boost::atomic<uint64_t> push_time; // microseconds
+};
+
+void push(SkimWriter *writer, const EventBatchPtr &batch, Statistics *statistics)
+{
+    const Timer timer;
+
+    writer->push(batch);
+
+    statistics->push_time.fetch_add(timer.elapsed().total_microseconds());
+}
+
+void produce(SkimWriter *writer,
+        const Files *files,
+        const uint32_t &producer,
+        const uint32_t &producers,
+        Statistics *statistics)
+{
+    for(uint32_t file = producer; files->size() > file; file += producers)
+    {
+        RecordReader reader(files->at(file));
+        reader.open();
+        if (!reader.isOpen())
+            continue;
+
+        EventBatchPtr batch(new EventBatch());
+        batch->file_name = reader.filename();
+        batch->input = reader.input();
+
+        for(EventBatch::EventPtr event(new Event());
+                reader.read(event);
+                event.reset(new Event()))
+        {
+            statistics->events.fetch_add(1);
+            statistics->ids.fetch_add(event->extra().id());
+
+            batch->events.push_back(event);
+            if (EVENTS_PER_BATCH > batch->events.size())
+                continue;
+
+            push(writer, batch, statistics);
+
+            EventBatchPtr next_batch(new EventBatch());
+            next_batch->file_name = batch->file_name;
+            next_batch->input = batch->input;
+
+            batch = next_batch;
+        }
+
+        if (!batch->events.empty())
+            push(writer, batch, statistics);
+    }
+}
+
+int main(int argc, char *argv[])
+try
+{
+    if (4 > argc)
+    {
+        cerr << "Usage: " << argv[0]
+            << " producers file_kb input.pb [input.pb ...]" << endl;
+        cerr << endl;
+
+        return 0;
+    }
+
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    const uint32_t producers = lexical_cast<uint32_t>(argv[1]);
+    const uint64_t file_size = lexical_cast<uint64_t>(argv[2]) * 1024;
+    const Files files(argv + 3, argv + argc);
+
+    const string prefix = "skim_writer_test";
+
+    SkimWriter writer(prefix, file_size);
+    Statistics statistics;
+
+    const Timer timer;
+
+    boost::thread_group threads;
+    for(uint32_t producer = 0; producers > producer; ++producer)
+        threads.create_thread(boost::bind(produce, &writer, &files, producer,
+                    producers, &statistics));
+
+    threads.join_all();
+
+    const boost::posix_time::time_duration produce_time = timer.elapsed();
+
+    writer.close();
+
+    const boost::posix_time::time_duration write_time = timer.elapsed();
+
+    // Read output back
+    //
+    typedef map<string, uint32_t> SmallFiles; // per trigger menu
+
+    uint64_t events = 0;
+    uint64_t ids = 0;
+    SmallFiles small_files;
+    for(uint32_t file = 0; writer.files() > file; ++file)
+    {
+        ostringstream file_name;
+        file_name << prefix << "_" << setw(4) << setfill('0') << file
+            << ".pb";
+
+        RecordReader reader(file_name.str());
+        reader.open();
+        if (!reader.isOpen())
+        {
+            cerr << "failed to open: " << file_name.str() << endl;
+
+            continue;
+        }
+
+        if (file_size > reader.end() - reader.begin())
+            ++small_files[reader.input()->info().SerializeAsString()];
+
+        for(EventBatch::EventPtr event(new Event());
+                reader.read(event);
+                event->Clear())
+        {
+            ++events;
+            ids += event->extra().id();
+        }
+    }
+
+    cout << "  Read Events: " << statistics.events << endl;
+    cout << "Written Files: " << writer.files()
+        << " (" << writer.bytes() / 1024 << " KB)" << endl;
+    cout << "Written Events: " << writer.events() << endl;
+    cout << "   Push Time: " << statistics.push_time / 1000 << " ms" << endl;
+    cout << "Produce Time: " << produce_time.total_milliseconds() << " ms"
+        << endl;
+    cout << "  Write Time: " << write_time.total_milliseconds() << " ms"
+        << endl;
+
+    int result = 0;
+    if (statistics.events != events
+            || statistics.events != writer.events()
+            || statistics.ids != ids)
+    {
+        cerr << "events mismatch" << endl;
+
+        result = 1;
+    }
+
+    for(SmallFiles::const_iterator menu = small_files.begin();
+            small_files.end() != menu;
+            ++menu)
+    {
+        if (1 >= menu->second)
+            continue;
+
+        cerr << menu->second - 1 << " files are not rolled by size" << endl;
+
+        result = 1;
+    }
+
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    return result;
+}
+catch(...)
+{
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    cerr << "Unknown error" << endl;
+
+    return 1;
+}
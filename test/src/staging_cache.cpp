@@ -0,0 +1,188 @@
+// Test Staging Cache
+//
+// Stage input files twice in each of two jobs: the first job copies every
+// file and the second one reads the copies. Copies should be
+// byte-identical to the inputs.
+// Cache limited to the largest input keeps only the last staged file.
+//
+// Copyright 2011, All rights reserved
+
+#include <dirent.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "interface/StagingCache.h"
+
+using namespace std;
+
+using bsm::StagingCache;
+
+typedef vector<string> Files;
+
+uint64_t fileSize(const string &file_name)
+{
+    struct stat file_stat;
+
+    return stat(file_name.c_str(), &file_stat) ? 0 : file_stat.st_size;
+}
+
+string content(const string &file_name)
+{
+    ifstream in(file_name.c_str(), ios::binary);
+
+    return string(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+}
+
+void clean(const string &directory)
+{
+    DIR *dir = opendir(directory.c_str());
+    if (!dir)
+        return;
+
+    for(struct dirent *entry = readdir(dir); entry; entry = readdir(dir))
+    {
+        const string name = entry->d_name;
+        if ("." != name
+                && ".." != name)
+            unlink((directory + "/" + name).c_str());
+    }
+
+    closedir(dir);
+    rmdir(directory.c_str());
+}
+
+uint32_t countFiles(const string &directory)
+{
+    uint32_t files = 0;
+
+    DIR *dir = opendir(directory.c_str());
+    if (!dir)
+        return files;
+
+    for(struct dirent *entry = readdir(dir); entry; entry = readdir(dir))
+    {
+        const string name = entry->d_name;
+        if ("." != name
+                && ".." != name)
+            ++files;
+    }
+
+    closedir(dir);
+
+    return files;
+}
+
+void report(const string &name, const StagingCache &cache)
+{
+    cout << name << endl;
+    cout << "      Hits: " << cache.hits() << endl;
+    cout << "    Copies: " << cache.copies() << " ("
+        << cache.bytesCopied() << " bytes)" << endl;
+    cout << "  Bypasses: " << cache.bypasses() << endl;
+}
+
+int main(int argc, char *argv[])
+try
+{
+    if (2 > argc)
+    {
+        cerr << "Usage: " << argv[0] << " input.pb [input.pb ...]" << endl;
+        cerr << endl;
+
+        return 0;
+    }
+
+    const Files files(argv + 1, argv + argc);
+    const string directory = "staging_cache_test";
+
+    clean(directory);
+
+    int result = 0;
+
+    uint64_t largest = 0;
+    {
+        // Second job reads the copies of the first one. Inputs are staged
+        // once per chunk: each input is counted once per job
+        //
+        StagingCache first_job(directory, 1024 * 1024 * 1024);
+        StagingCache second_job(directory, 1024 * 1024 * 1024);
+        for(uint32_t pass = 0; 4 > pass; ++pass)
+        {
+            StagingCache &cache = 2 > pass ? first_job : second_job;
+
+            for(Files::const_iterator file = files.begin();
+                    files.end() != file;
+                    ++file)
+            {
+                const string staged = cache.stage(*file);
+                if (staged == *file
+                        || content(staged) != content(*file))
+                {
+                    cerr << "bad copy of " << *file << ": " << staged << endl;
+
+                    result = 1;
+                }
+
+                if (fileSize(*file) > largest)
+                    largest = fileSize(*file);
+            }
+        }
+
+        report("First Job", first_job);
+        report("Second Job", second_job);
+
+        if (files.size() != first_job.copies()
+                || first_job.hits()
+                || first_job.bypasses()
+                || files.size() != second_job.hits()
+                || second_job.copies()
+                || second_job.bypasses())
+        {
+            cerr << "staging counters mismatch" << endl;
+
+            result = 1;
+        }
+    }
+
+    clean(directory);
+
+    {
+        // Each input evicts the previous one: files bigger than the cache
+        // are read in place
+        //
+        StagingCache cache(directory, largest);
+        for(Files::const_iterator file = files.begin();
+                files.end() != file;
+                ++file)
+        {
+            cache.stage(*file);
+        }
+
+        report("Limited", cache);
+
+        if (1 < countFiles(directory)
+                || files.size() != cache.copies() + cache.bypasses())
+        {
+            cerr << "cache is not limited" << endl;
+
+            result = 1;
+        }
+    }
+
+    clean(directory);
+
+    return result;
+}
+catch(...)
+{
+    cerr << "Unknown error" << endl;
+
+    return 1;
+}
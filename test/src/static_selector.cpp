@@ -0,0 +1,225 @@
+// Benchmark Static Selector
+//
+// Apply MuonSelector and StaticMuonSelector to all muons of the input
+// files. Compare selection rates and check that both selectors pass the
+// same muons and print the same cutflow, including the one of the merged
+// clones. Events are read into memory first to measure the selection and
+// not the reading.
+//
+// Copyright 2011, All rights reserved
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/pointer_cast.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "bsm_input/interface/Muon.pb.h"
+#include "bsm_input/interface/Reader.h"
+#include "interface/Selector.h"
+#include "interface/StaticSelector.h"
+#include "test/interface/Benchmark.h"
+
+using namespace std;
+
+using boost::dynamic_pointer_cast;
+using boost::lexical_cast;
+using boost::shared_ptr;
+
+using bsm::Event;
+using bsm::LockSelectorEventCounterOnUpdate;
+using bsm::Muon;
+using bsm::MuonSelector;
+using bsm::PrimaryVertex;
+using bsm::Reader;
+using bsm::StaticMuonSelector;
+using bsm::test::Report;
+using bsm::test::Timer;
+
+typedef vector<string> Files;
+typedef vector<shared_ptr<Event> > Events;
+typedef ::google::protobuf::RepeatedPtrField<Muon> Muons;
+
+struct Statistics
+{
+    Statistics():
+        muons(0),
+        passed(0)
+    {
+    }
+
+    uint64_t muons;
+    uint64_t passed;
+    vector<bool> decisions;
+    boost::posix_time::time_duration time;
+};
+
+void load(const Files &files, Events &events)
+{
+    for(Files::const_iterator file = files.begin();
+            files.end() != file;
+            ++file)
+    {
+        Reader reader(*file);
+        reader.open();
+        if (!reader.isOpen())
+        {
+            cerr << "Failed to open: " << *file << endl;
+
+            continue;
+        }
+
+        for(shared_ptr<Event> event(new Event());
+                reader.read(event);
+                event.reset(new Event()))
+        {
+            if (!event->primary_vertices().size())
+                continue;
+
+            events.push_back(event);
+        }
+    }
+}
+
+// Decisions are kept for the first pass only
+//
+template<class T>
+    Statistics benchmark(const Events &events,
+            const uint32_t &repeat,
+            T &selector)
+{
+    Statistics statistics;
+
+    const Timer timer;
+    for(uint32_t pass = 0; repeat > pass; ++pass)
+    {
+        for(Events::const_iterator event = events.begin();
+                events.end() != event;
+                ++event)
+        {
+            const PrimaryVertex &pv = (*event)->primary_vertices().Get(0);
+
+            LockSelectorEventCounterOnUpdate lock(selector);
+            for(Muons::const_iterator muon = (*event)->pf_muons().begin();
+                    (*event)->pf_muons().end() != muon;
+                    ++muon)
+            {
+                const bool is_passed = selector.apply(*muon, pv);
+
+                ++statistics.muons;
+                if (is_passed)
+                    ++statistics.passed;
+
+                if (!pass)
+                    statistics.decisions.push_back(is_passed);
+            }
+        }
+    }
+    statistics.time = timer.elapsed();
+
+    return statistics;
+}
+
+// Merge selector into its clone: counters should double
+//
+template<class T>
+    string mergedCutflow(const T &selector)
+{
+    shared_ptr<T> clone = dynamic_pointer_cast<T>(selector.clone());
+    clone->merge(selector.clone());
+
+    ostringstream out;
+    out << *clone;
+
+    return out.str();
+}
+
+template<class T>
+    string cutflow(const T &selector)
+{
+    ostringstream out;
+    out << selector;
+
+    return out.str();
+}
+
+void report(const string &name, const Statistics &statistics)
+{
+    Report(name).count("muons", statistics.muons)
+        .count("passed", statistics.passed)
+        .time(statistics.time)
+        .rate(statistics.muons, "muons");
+}
+
+int main(int argc, char *argv[])
+try
+{
+    if (3 > argc)
+    {
+        cerr << "Usage: " << argv[0] << " repeat input.pb [input.pb ...]"
+            << endl;
+        cerr << endl;
+
+        return 0;
+    }
+
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    int result = 0;
+    {
+        const uint32_t repeat = lexical_cast<uint32_t>(argv[1]);
+        const Files files(argv + 2, argv + argc);
+
+        Events events;
+        load(files, events);
+
+        MuonSelector selector;
+        StaticMuonSelector static_selector;
+
+        const Statistics statistics = benchmark(events, repeat, selector);
+        const Statistics static_statistics =
+            benchmark(events, repeat, static_selector);
+
+        cout << static_selector << endl;
+        cout << endl;
+
+        report("Selector", statistics);
+        report("Static", static_statistics);
+
+        if (statistics.muons != static_statistics.muons
+                || statistics.decisions != static_statistics.decisions)
+        {
+            cerr << "decisions mismatch" << endl;
+
+            result = 1;
+        }
+
+        if (cutflow(selector) != cutflow(static_selector)
+                || mergedCutflow(selector) != mergedCutflow(static_selector))
+        {
+            cerr << "cutflow mismatch" << endl;
+
+            result = 1;
+        }
+    }
+
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    return result;
+}
+catch(...)
+{
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    cerr << "Unknown error" << endl;
+
+    return 1;
+}
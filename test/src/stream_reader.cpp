@@ -0,0 +1,185 @@
+// Test Stream Reader
+//
+// Write Input and Events of the input files into a named pipe from a
+// separate thread and read them back with StreamReader. Input and every
+// event should match the ones read by the regular Reader.
+//
+// Copyright 2011, All rights reserved
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "bsm_input/interface/Input.pb.h"
+#include "bsm_input/interface/Reader.h"
+#include "interface/StreamReader.h"
+
+using namespace std;
+
+using boost::shared_ptr;
+
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::io::FileOutputStream;
+
+using bsm::Event;
+using bsm::Reader;
+using bsm::StreamReader;
+
+typedef vector<string> Records;
+
+void writeStream(const string &pipe,
+        const string &input,
+        const Records &records)
+{
+    int fd = open(pipe.c_str(), O_WRONLY);
+    if (0 > fd)
+        return;
+
+    {
+        FileOutputStream raw_out(fd);
+        CodedOutputStream coded_out(&raw_out);
+
+        coded_out.WriteVarint32(input.size());
+        coded_out.WriteString(input);
+
+        for(Records::const_iterator record = records.begin();
+                records.end() != record;
+                ++record)
+        {
+            coded_out.WriteVarint32(record->size());
+            coded_out.WriteString(*record);
+        }
+    }
+
+    close(fd);
+}
+
+int main(int argc, char *argv[])
+try
+{
+    if (2 > argc)
+    {
+        cerr << "Usage: " << argv[0] << " input.pb [input.pb ...]" << endl;
+        cerr << endl;
+
+        return 0;
+    }
+
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    // Stream carries Input of the first file
+    //
+    string input;
+    Records records;
+    for(int i = 1; argc > i; ++i)
+    {
+        shared_ptr<Reader> reader(new Reader(argv[i]));
+        reader->open();
+        if (!reader->isOpen())
+            continue;
+
+        if (records.empty())
+            input = reader->input()->SerializeAsString();
+
+        for(shared_ptr<Event> event(new Event());
+                reader->read(event);
+                event->Clear())
+        {
+            records.push_back(event->SerializeAsString());
+        }
+    }
+
+    const string pipe = "stream_reader_test.fifo";
+
+    unlink(pipe.c_str());
+    if (mkfifo(pipe.c_str(), 0600))
+    {
+        cerr << "failed to create pipe: " << pipe << endl;
+
+        return 1;
+    }
+
+    int result = 0;
+
+    boost::thread writer(boost::bind(writeStream, pipe, boost::cref(input),
+                boost::cref(records)));
+
+    if (!StreamReader::isStream(pipe))
+    {
+        cerr << "pipe is not recognized as stream" << endl;
+
+        result = 1;
+    }
+
+    StreamReader reader(pipe);
+    reader.open();
+
+    if (!reader.isOpen()
+            || input != reader.input()->SerializeAsString())
+    {
+        cerr << "input mismatch" << endl;
+
+        result = 1;
+    }
+
+    uint32_t events_read = 0;
+    uint32_t events_matched = 0;
+    for(shared_ptr<Event> event(new Event());
+            reader.isOpen()
+                && reader.read(event);
+            event->Clear())
+    {
+        if (records.size() > events_read
+                && records[events_read] == event->SerializeAsString())
+            ++events_matched;
+
+        ++events_read;
+    }
+
+    reader.close();
+    writer.join();
+
+    unlink(pipe.c_str());
+
+    cout << "  Reader: " << records.size() << " events" << endl;
+    cout << "  Stream: " << events_read << " events ("
+        << reader.tell() << " bytes)" << endl;
+    cout << " Matched: " << events_matched << " events" << endl;
+
+    if (records.size() != events_read
+            || events_read != events_matched)
+    {
+        cerr << "events mismatch" << endl;
+
+        result = 1;
+    }
+
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    return result;
+}
+catch(...)
+{
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    cerr << "Unknown error" << endl;
+
+    return 1;
+}
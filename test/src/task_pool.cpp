@@ -0,0 +1,294 @@
+// Benchmark Task Dispatch
+//
+// Compare the Controller hand-off (worker reports to the Controller after
+// each task and waits for instructions) with the work-stealing TaskPool.
+// Many short tasks model a list of many small input files.
+//
+// Copyright 2011, All rights reserved
+
+#include <iostream>
+#include <queue>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include "interface/TaskPool.h"
+#include "test/interface/Benchmark.h"
+
+using namespace std;
+
+using boost::lexical_cast;
+
+using bsm::test::Report;
+using bsm::test::Timer;
+
+namespace pt = boost::posix_time;
+
+typedef bsm::TaskPool<uint32_t> Tasks;
+
+// Burn CPU for a given number of microseconds: task payload
+//
+void work(const uint32_t &microseconds)
+{
+    const pt::ptime stop = pt::microsec_clock::universal_time()
+        + pt::microseconds(microseconds);
+
+    while(pt::microsec_clock::universal_time() < stop)
+    {
+    }
+}
+
+struct Statistics
+{
+    Statistics():
+        tasks(0),
+        idle(0, 0, 0)
+    {
+    }
+
+    uint32_t tasks;
+    pt::time_duration idle;
+};
+
+// Controller hand-off: single Condition guards the queue of tasks and the
+// queue of waiting workers
+//
+class Controller
+{
+    public:
+        Controller(const uint32_t &tasks, const uint32_t &workers):
+            _workers(workers),
+            _statistics(workers)
+        {
+            for(uint32_t task = 0; tasks > task; ++task)
+                _tasks.push(task);
+
+            _instructions.resize(workers, NONE);
+        }
+
+        void run(const uint32_t &microseconds)
+        {
+            boost::thread_group threads;
+            for(uint32_t worker = 0; _workers > worker; ++worker)
+            {
+                threads.create_thread(boost::bind(&Controller::worker,
+                            this, worker, microseconds));
+            }
+
+            for(uint32_t running = _workers; running; )
+            {
+                boost::mutex::scoped_lock lock(_mutex);
+                while(_waiting.empty())
+                    _condition.wait(lock);
+
+                const uint32_t worker = _waiting.front();
+                _waiting.pop();
+
+                if (_tasks.empty())
+                {
+                    _instructions[worker] = STOP;
+
+                    --running;
+                }
+                else
+                {
+                    _instructions[worker] = _tasks.front();
+                    _tasks.pop();
+                }
+
+                _condition.notify_all();
+            }
+
+            threads.join_all();
+        }
+
+        const vector<Statistics> &statistics() const
+        {
+            return _statistics;
+        }
+
+    private:
+        enum
+        {
+            NONE = 0xFFFFFFFE,
+            STOP = 0xFFFFFFFF
+        };
+
+        void worker(const uint32_t &worker, const uint32_t &microseconds)
+        {
+            for(;;)
+            {
+                const Timer wait;
+
+                uint32_t task;
+                {
+                    boost::mutex::scoped_lock lock(_mutex);
+
+                    _waiting.push(worker);
+                    _condition.notify_all();
+
+                    while(NONE == _instructions[worker])
+                        _condition.wait(lock);
+
+                    task = _instructions[worker];
+                    _instructions[worker] = NONE;
+                }
+
+                _statistics[worker].idle += wait.elapsed();
+
+                if (STOP == task)
+                    break;
+
+                work(microseconds);
+
+                ++_statistics[worker].tasks;
+            }
+        }
+
+        const uint32_t _workers;
+
+        boost::mutex _mutex;
+        boost::condition_variable _condition;
+
+        queue<uint32_t> _tasks;
+        queue<uint32_t> _waiting;
+        vector<uint32_t> _instructions;
+
+        vector<Statistics> _statistics;
+};
+
+// Work-stealing: workers take tasks from the pool directly
+//
+class Stealing
+{
+    public:
+        Stealing(const uint32_t &tasks, const uint32_t &workers):
+            _tasks(new Tasks(workers)),
+            _statistics(workers)
+        {
+            for(uint32_t task = 0; tasks > task; ++task)
+                _tasks->push(task, task);
+        }
+
+        void run(const uint32_t &microseconds)
+        {
+            boost::thread_group threads;
+            for(uint32_t worker = 0; _tasks->workers() > worker; ++worker)
+            {
+                threads.create_thread(boost::bind(&Stealing::worker,
+                            this, worker, microseconds));
+            }
+
+            threads.join_all();
+        }
+
+        const vector<Statistics> &statistics() const
+        {
+            return _statistics;
+        }
+
+        uint32_t steals() const
+        {
+            return _tasks->steals();
+        }
+
+    private:
+        void worker(const uint32_t &worker, const uint32_t &microseconds)
+        {
+            for(;;)
+            {
+                const Timer wait;
+
+                uint32_t task;
+                const bool has_task = _tasks->pop(worker, task);
+
+                _statistics[worker].idle += wait.elapsed();
+
+                if (!has_task)
+                    break;
+
+                work(microseconds);
+
+                ++_statistics[worker].tasks;
+            }
+        }
+
+        boost::shared_ptr<Tasks> _tasks;
+
+        vector<Statistics> _statistics;
+};
+
+void report(const string &name,
+        const pt::time_duration &time,
+        const vector<Statistics> &statistics)
+{
+    pt::time_duration idle;
+    uint32_t tasks = 0;
+    for(vector<Statistics>::const_iterator worker = statistics.begin();
+            statistics.end() != worker;
+            ++worker)
+    {
+        idle += worker->idle;
+        tasks += worker->tasks;
+    }
+
+    const pt::time_duration dispatch = tasks
+        ? idle / tasks
+        : pt::time_duration();
+
+    Report(name, 12).microseconds("wall", time)
+        .microseconds("dispatch per task", dispatch, 8)
+        .microseconds("idle", idle);
+}
+
+int main(int argc, char *argv[])
+try
+{
+    if (4 > argc)
+    {
+        cerr << "Usage: " << argv[0]
+            << " tasks workers task_microseconds" << endl;
+        cerr << endl;
+
+        return 0;
+    }
+
+    const uint32_t tasks = lexical_cast<uint32_t>(argv[1]);
+    const uint32_t workers = lexical_cast<uint32_t>(argv[2]);
+    const uint32_t microseconds = lexical_cast<uint32_t>(argv[3]);
+
+    cout << tasks << " tasks, " << workers << " workers, "
+        << microseconds << " us per task" << endl;
+
+    {
+        Controller controller(tasks, workers);
+
+        const Timer timer;
+        controller.run(microseconds);
+
+        report("Controller", timer.elapsed(), controller.statistics());
+    }
+
+    {
+        Stealing stealing(tasks, workers);
+
+        const Timer timer;
+        stealing.run(microseconds);
+
+        report("TaskPool", timer.elapsed(), stealing.statistics());
+
+        cout << "Stolen tasks: " << stealing.steals() << endl;
+    }
+
+    return 0;
+}
+catch(...)
+{
+    cerr << "Unknown error" << endl;
+
+    return 1;
+}
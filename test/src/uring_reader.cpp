@@ -0,0 +1,241 @@
+// Benchmark io_uring Reader
+//
+// Read all events of the input files with the regular RecordReader reads
+// and with asynchronous io_uring reads. Compare read rates and check that
+// both readers give the same records. Files are dropped from the page
+// cache before every pass (if system allows) to measure the device and
+// not the memory. Small buffers are used first to check records that
+// cross buffer boundaries.
+//
+// Copyright 2011, All rights reserved
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "bsm_input/interface/Event.pb.h"
+#include "interface/RecordReader.h"
+#include "interface/UringInputStream.h"
+#include "test/interface/Benchmark.h"
+
+using namespace std;
+
+using boost::lexical_cast;
+
+using bsm::RecordReader;
+using bsm::UringInputStream;
+using bsm::test::Report;
+using bsm::test::Timer;
+
+typedef vector<string> Files;
+
+struct Statistics
+{
+    Statistics():
+        events(0),
+        bytes(0),
+        checksum(0),
+        errors(0)
+    {
+    }
+
+    uint64_t events;
+    uint64_t bytes;
+    size_t checksum;
+    uint32_t errors;
+    boost::posix_time::time_duration time;
+};
+
+void dropCache(const string &file_name)
+{
+#if defined(POSIX_FADV_DONTNEED)
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (0 > fd)
+        return;
+
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+#endif
+}
+
+// Read file through the stream with tiny buffers: every byte should match
+// the file content
+//
+bool compareStream(const string &file_name)
+{
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (0 > fd)
+        return false;
+
+    string content;
+    {
+        vector<char> buffer(64 * 1024);
+        for(ssize_t size; 0 < (size = read(fd, &buffer[0], buffer.size())); )
+        {
+            content.append(&buffer[0], size);
+        }
+    }
+
+    string copy;
+    {
+        UringInputStream stream(fd, 0, 0, 3, 4096);
+
+        const void *data;
+        int size;
+        for(uint32_t step = 0; stream.Next(&data, &size); ++step)
+        {
+            // Give some bytes back and skip a few to check the bookkeeping
+            //
+            if (1 == step % 3
+                    && 10 < size)
+            {
+                copy.append(static_cast<const char *>(data), size - 10);
+                stream.BackUp(10);
+            }
+            else
+                copy.append(static_cast<const char *>(data), size);
+        }
+
+        if (stream.hadError()
+                || static_cast<int64_t>(copy.size()) != stream.ByteCount())
+            copy.clear();
+    }
+
+    close(fd);
+
+    return content == copy;
+}
+
+Statistics benchmark(const Files &files,
+        const uint32_t &repeat,
+        const bool &use_uring)
+{
+    Statistics statistics;
+
+    boost::hash<string> make_hash;
+    for(uint32_t pass = 0; repeat > pass; ++pass)
+    {
+        for(Files::const_iterator file = files.begin();
+                files.end() != file;
+                ++file)
+        {
+            dropCache(*file);
+        }
+
+        const Timer timer;
+        for(Files::const_iterator file = files.begin();
+                files.end() != file;
+                ++file)
+        {
+            RecordReader reader(*file);
+            reader.useUring(use_uring);
+            reader.open();
+            if (!reader.isOpen())
+                continue;
+
+            string record;
+            while(reader.read(record))
+            {
+                ++statistics.events;
+
+                statistics.bytes += record.size();
+                boost::hash_combine(statistics.checksum, make_hash(record));
+            }
+
+            if (reader.hadError())
+                ++statistics.errors;
+        }
+        statistics.time += timer.elapsed();
+    }
+
+    return statistics;
+}
+
+void report(const string &name, const Statistics &statistics)
+{
+    Report(name).count("events", statistics.events)
+        .time(statistics.time)
+        .bandwidth(statistics.bytes);
+}
+
+int main(int argc, char *argv[])
+try
+{
+    if (3 > argc)
+    {
+        cerr << "Usage: " << argv[0] << " repeat input.pb [input.pb ...]"
+            << endl;
+        cerr << endl;
+
+        return 0;
+    }
+
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    if (!UringInputStream::isSupported())
+    {
+        cerr << "io_uring is not supported" << endl;
+
+        return 0;
+    }
+
+    const uint32_t repeat = lexical_cast<uint32_t>(argv[1]);
+    const Files files(argv + 2, argv + argc);
+
+    int result = 0;
+    for(Files::const_iterator file = files.begin();
+            files.end() != file;
+            ++file)
+    {
+        if (!compareStream(*file))
+        {
+            cerr << "stream mismatch: " << *file << endl;
+
+            result = 1;
+        }
+    }
+
+    const Statistics regular_statistics = benchmark(files, repeat, false);
+    const Statistics uring_statistics = benchmark(files, repeat, true);
+
+    report("Regular", regular_statistics);
+    report("io_uring", uring_statistics);
+
+    if (regular_statistics.events != uring_statistics.events
+            || regular_statistics.checksum != uring_statistics.checksum)
+    {
+        cerr << "records mismatch" << endl;
+
+        result = 1;
+    }
+
+    if (regular_statistics.errors
+            || uring_statistics.errors)
+    {
+        cerr << "read errors" << endl;
+
+        result = 1;
+    }
+
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    return result;
+}
+catch(...)
+{
+    // Clean Up any memory allocated by libprotobuf
+    //
+    google::protobuf::ShutdownProtobufLibrary();
+
+    cerr << "Unknown error" << endl;
+
+    return 1;
+}